@@ -3,7 +3,10 @@
 
 #include "bengine_texture.hpp"
 #include "bengine_window.hpp"
+#include "bengine_assets.hpp"
+#include "bengine_layout.hpp"
 #include "bengine_mouse.hpp"
+#include "bengine_pacing.hpp"
 #include "bengine_loop.hpp"
 #include "bengine_helpers.hpp"
 
@@ -0,0 +1,201 @@
+#ifndef BENGINE_ASSETS_hpp
+#define BENGINE_ASSETS_hpp
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+#include "bengine_texture.hpp"
+#include "bengine_window.hpp"
+#include "btils_threads.hpp"
+
+namespace bengine {
+    /** Loads images and fonts in the background so that a window can show something while they come in
+     *
+     * Image files are read and decoded into SDL_Surfaces on worker threads; update() then turns them into textures on the main thread (the renderer must only be used there), stopping once its time budget for the frame is spent.
+     * Fonts are opened on the workers as well, one at a time since SDL_ttf shares its FreeType library between every font
+     */
+    class assetLoader {
+        private:
+            /// @brief An image that has been decoded but not uploaded yet
+            struct decodedImage {
+                std::string path;
+                /// @brief The decoded image (NULL if it could not be decoded)
+                SDL_Surface *surface;
+                /// @brief Why the image could not be decoded; SDL's error string belongs to the thread that set it, so it is read on the worker
+                std::string error;
+            };
+            /// @brief A font that has been opened but not handed over yet
+            struct openedFont {
+                std::string path;
+                /// @brief Where the font goes
+                TTF_Font **target;
+                /// @brief The font (NULL if it could not be opened)
+                TTF_Font *font;
+                /// @brief Why the font could not be opened (read on the worker, like decodedImage::error)
+                std::string error;
+            };
+
+            /// @brief The window whose renderer and texture cache the images are uploaded with
+            bengine::window &window;
+            /// @brief The textures waiting on each image that is still being decoded
+            std::unordered_map<std::string, std::vector<bengine::basicTexture *>> waiting = {};
+            /// @brief The amount of images and fonts requested
+            std::size_t requested = 0;
+            /// @brief The amount of images and fonts that have been handed over (or failed)
+            std::size_t completed = 0;
+
+            /// @brief Guards decoded and opened
+            std::mutex lock;
+            /// @brief Serialises TTF_OpenFont() between the workers
+            std::mutex fontLock;
+            /// @brief Images decoded by the workers, in the order they finished
+            std::deque<decodedImage> decoded = {};
+            /// @brief Fonts opened by the workers
+            std::vector<openedFont> opened = {};
+
+            /// @brief The workers; declared last so they are joined before anything they write to goes away
+            btils::threadPool workers;
+
+        public:
+            /** bengine::assetLoader constructor
+             * @param window The window to upload images with (must outlive the loader)
+             * @param threads The amount of worker threads; 0 uses one per hardware thread
+             */
+            assetLoader(bengine::window &window, const std::size_t &threads = 0) : window(window), workers(threads) {}
+            /// @brief bengine::assetLoader deconstructor; waits for the workers and frees anything that was never handed over
+            ~assetLoader() {
+                this->workers.wait();
+                for (std::size_t i = 0; i < this->decoded.size(); i++) {
+                    SDL_FreeSurface(this->decoded[i].surface);
+                }
+                for (std::size_t i = 0; i < this->opened.size(); i++) {
+                    if (this->opened[i].font != nullptr) {
+                        TTF_CloseFont(this->opened[i].font);
+                    }
+                }
+            }
+            assetLoader(const bengine::assetLoader &) = delete;
+            bengine::assetLoader &operator=(const bengine::assetLoader &) = delete;
+
+            /** Load an image into a texture in the background
+             * @param path The path of the image
+             * @param target The texture to give the image to once it is uploaded (must outlive the loader); its frame is left alone
+             */
+            void requestTexture(const std::string &path, bengine::basicTexture &target) {
+                this->requested++;
+                const bengine::textureHandle existing = this->window.getTextureCache().find(path);
+                if (existing != nullptr) {
+                    target.setTexture(existing);
+                    this->completed++;
+                    return;
+                }
+
+                std::vector<bengine::basicTexture *> &targets = this->waiting[path];
+                targets.push_back(&target);
+                if (targets.size() > 1) {
+                    return;
+                }
+                this->workers.submit([this, path]() {
+                    SDL_Surface *surface = IMG_Load(path.c_str());
+                    const std::string error = surface == nullptr ? IMG_GetError() : "";
+                    std::lock_guard<std::mutex> guard(this->lock);
+                    this->decoded.push_back({path, surface, error});
+                });
+            }
+            /** Open a font in the background
+             * @param path The path of the font
+             * @param size The point size to open the font at
+             * @param target Where to put the font once it is open (must outlive the loader)
+             */
+            void requestFont(const std::string &path, const int &size, TTF_Font *&target) {
+                this->requested++;
+                TTF_Font **destination = &target;
+                this->workers.submit([this, path, size, destination]() {
+                    TTF_Font *font;
+                    std::string error;
+                    {
+                        std::lock_guard<std::mutex> guard(this->fontLock);
+                        font = TTF_OpenFont(path.c_str(), size);
+                        if (font == nullptr) {
+                            error = TTF_GetError();
+                        }
+                    }
+                    std::lock_guard<std::mutex> guard(this->lock);
+                    this->opened.push_back({path, destination, font, error});
+                });
+            }
+
+            /** Hand over everything that has finished loading; call once per frame from the main thread
+             * @param budget The most time to spend uploading images (ms); at least one image is always uploaded if any are ready
+             * @returns The amount of images and fonts handed over
+             */
+            std::size_t update(const Uint32 &budget = 4) {
+                std::size_t output = 0;
+                std::vector<openedFont> fonts;
+                {
+                    std::lock_guard<std::mutex> guard(this->lock);
+                    fonts.swap(this->opened);
+                }
+                for (std::size_t i = 0; i < fonts.size(); i++) {
+                    if (fonts[i].font == nullptr) {
+                        std::cout << "ERROR: Could not open \"" << fonts[i].path << "\"\nERROR: " << fonts[i].error << "\n";
+                    }
+                    *fonts[i].target = fonts[i].font;
+                    this->completed++;
+                    output++;
+                }
+
+                const Uint32 start = SDL_GetTicks();
+                do {
+                    decodedImage image;
+                    {
+                        std::lock_guard<std::mutex> guard(this->lock);
+                        if (this->decoded.size() == 0) {
+                            break;
+                        }
+                        image = this->decoded.front();
+                        this->decoded.pop_front();
+                    }
+
+                    bengine::textureHandle texture = nullptr;
+                    if (image.surface == nullptr) {
+                        std::cout << "ERROR: Could not decode \"" << image.path << "\"\nERROR: " << image.error << "\n";
+                    } else {
+                        texture = this->window.getTextureCache().upload(image.path, image.surface);
+                        SDL_FreeSurface(image.surface);
+                    }
+
+                    std::vector<bengine::basicTexture *> &targets = this->waiting[image.path];
+                    for (std::size_t i = 0; i < targets.size(); i++) {
+                        targets[i]->setTexture(texture);
+                    }
+                    this->completed += targets.size();
+                    output += targets.size();
+                    this->waiting.erase(image.path);
+                } while (SDL_GetTicks() - start < budget);
+                return output;
+            }
+
+            /** Check whether everything requested has been handed over
+             * @returns Whether nothing is left to load
+             */
+            bool finished() const {
+                return this->completed == this->requested;
+            }
+            /** Get how much of what was requested has been handed over
+             * @returns The fraction of requests that are done (1 when nothing was requested)
+             */
+            double progress() const {
+                return this->requested == 0 ? 1 : (double)this->completed / this->requested;
+            }
+    };
+}
+
+#endif // BENGINE_ASSETS_hpp
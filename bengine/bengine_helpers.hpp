@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace bengine {
     typedef enum {
@@ -50,6 +52,10 @@ namespace bengine {
             unsigned short xOffset = 0;
             /// @brief The y-offset of the top-left cell's top-left corner from the zone's top-left corner
             unsigned short yOffset = 0;
+            /// @brief The x-position of each column's cells relative to the zone's top-left corner; filled in by update() so that drawing a grid needs no arithmetic per cell
+            std::vector<unsigned int> cellXs = {};
+            /// @brief The y-position of each row's cells relative to the zone's top-left corner
+            std::vector<unsigned int> cellYs = {};
 
             /// @brief Update all of the "output" values for the padded grid
             void update() {
@@ -79,7 +85,16 @@ namespace bengine {
                 } else if (this->alignment <= 5) {
                     this->yOffset = (this->usableHeight - this->cellHeight * this->rows) / 2;
                 } else {
-                    this->yOffset = this->usableWidth - this->cellWidth * this->cols;
+                    this->yOffset = this->usableHeight - this->cellHeight * this->rows;
+                }
+
+                this->cellXs.resize(this->cols);
+                for (unsigned short i = 0; i < this->cols; i++) {
+                    this->cellXs[i] = this->xOffset + i * (this->cellWidth + this->gapWidth);
+                }
+                this->cellYs.resize(this->rows);
+                for (unsigned short i = 0; i < this->rows; i++) {
+                    this->cellYs[i] = this->yOffset + i * (this->cellHeight + this->gapHeight);
                 }
             }
 
@@ -276,13 +291,208 @@ namespace bengine {
             unsigned short getYOffset() const {
                 return this->yOffset;
             }
+            /** Get the x-position of a column's cells relative to the top-left corner of the zone
+             * @param col The column
+             * @returns The x-position of the column's cells (0 if the column is out of range)
+             */
+            unsigned int getCellX(const unsigned short &col) const {
+                return col < this->cellXs.size() ? this->cellXs[col] : 0;
+            }
+            /** Get the y-position of a row's cells relative to the top-left corner of the zone
+             * @param row The row
+             * @returns The y-position of the row's cells (0 if the row is out of range)
+             */
+            unsigned int getCellY(const unsigned short &row) const {
+                return row < this->cellYs.size() ? this->cellYs[row] : 0;
+            }
+    };
+
+    /// @brief The 46 non-empty bitmasks used for 8-bit autotiling, in tile order (a mask's tile is its index + 1; a tile with no neighbors uses tile 47)
+    constexpr unsigned char eightBitKey[46] = {2, 8, 10, 11, 16, 18, 22, 24, 26, 27, 30, 31, 64, 66, 72, 74, 75, 80, 82, 86, 88, 90, 91, 94, 95, 104, 106, 107, 120, 122, 123, 126, 127, 208, 210, 214, 216, 218, 219, 222, 223, 248, 250, 251, 254, 255};
+
+    /// @brief A lookup table from a raw 8-bit neighbor mask to an 8-bit autotiling tile
+    struct autotileTable {
+        /// @brief The tile for each raw mask; bits are (from lowest to highest) top-left, top, top-right, left, right, bottom-left, bottom, bottom-right
+        char tiles[256] = {};
+    };
+
+    /** Build the 8-bit autotiling lookup table; corners only count when both of the edges beside them are filled, so every raw mask reduces onto one of the 47 tiles
+     * @returns The lookup table
+     */
+    constexpr bengine::autotileTable buildEightBitTable() {
+        bengine::autotileTable output;
+        for (unsigned short raw = 0; raw < 256; raw++) {
+            const bool t = raw & 2, l = raw & 8, r = raw & 16, b = raw & 64;
+            const unsigned char reduced = ((raw & 1) && t && l) + t * 2 + ((raw & 4) && t && r) * 4 + l * 8 + r * 16 + ((raw & 32) && b && l) * 32 + b * 64 + ((raw & 128) && b && r) * 128;
+            output.tiles[raw] = 47;
+            for (unsigned char i = 0; i < 46; i++) {
+                if (reduced == bengine::eightBitKey[i]) {
+                    output.tiles[raw] = i + 1;
+                }
+            }
+        }
+        return output;
+    }
+    /// @brief The 8-bit autotiling lookup table, generated at compile time
+    constexpr bengine::autotileTable eightBitTable = bengine::buildEightBitTable();
+
+    /// @brief A table that spreads the 8 bits of a byte into the lowest bit of each byte of a word
+    struct spreadTable {
+        /// @brief The spread form of each byte; byte i of words[v] is bit i of v
+        std::uint64_t words[256] = {};
+    };
+    /** Build the table used to spread the bits of a byte
+     * @returns The table
+     */
+    constexpr bengine::spreadTable buildSpreadTable() {
+        bengine::spreadTable output;
+        for (unsigned short v = 0; v < 256; v++) {
+            for (unsigned char i = 0; i < 8; i++) {
+                output.words[v] |= (std::uint64_t)((v >> i) & 1) << (i * 8);
+            }
+        }
+        return output;
+    }
+    /// @brief The table used to spread the bits of a byte, generated at compile time
+    constexpr bengine::spreadTable byteSpreads = bengine::buildSpreadTable();
+
+    /// @brief A tile to add or remove with one of bengine::autotiler's batch functions
+    struct tileChange {
+        /// @brief x-position of the tile
+        std::size_t x = 0;
+        /// @brief y-position of the tile
+        std::size_t y = 0;
+        /// @brief Whether to add (true) or remove (false) the tile
+        bool addTile = true;
     };
 
     /// @brief A class containing useful functions designed for 4/8-bit autotiling
     class autotiler {
         private:
-            /// @brief Key containing the 48 bitmasks relevant to eight-bit autotiling
-            const static unsigned char key[48];
+            /** Get the neighbors of every cell of a row of words in one direction
+             * @param row The words of the row (nullptr for a row outside of the grid)
+             * @param word The index of the word within the row
+             * @param stride The amount of words in the row
+             * @param width The amount of cells in the row
+             * @param dx -1 for each cell's left neighbor, 0 for the cell itself, 1 for its right neighbor
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             * @returns A word where bit i is set if the neighbor of cell (word * 64 + i) is filled
+             */
+            static std::uint64_t neighborWord(const std::uint64_t *row, const std::size_t &word, const std::size_t &stride, const std::size_t &width, const char &dx, const bool &solidBoundaries) {
+                const std::size_t bits = width - word * 64 >= 64 ? 64 : width - word * 64;
+                const std::uint64_t inBounds = bits == 64 ? UINT64_MAX : (((std::uint64_t)1 << bits) - 1);
+                if (row == nullptr) {
+                    return solidBoundaries ? inBounds : 0;
+                }
+                std::uint64_t output = row[word];
+                if (dx < 0) {
+                    output = (output << 1) | (word > 0 ? row[word - 1] >> 63 : solidBoundaries);
+                } else if (dx > 0) {
+                    output = (output >> 1) | (word + 1 < stride ? row[word + 1] << 63 : 0);
+                    if (word + 1 == stride && solidBoundaries) {
+                        output |= (std::uint64_t)1 << (bits - 1);
+                    }
+                }
+                return output & inBounds;
+            }
+
+            /** Recompute the value of a single tile from its neighbors
+             * @param cell A function giving a reference to the value at (x, y)
+             * @param width The amount of tiles in each row
+             * @param height The amount of rows
+             * @param x x-position of the tile
+             * @param y y-position of the tile
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             * @param eightBitMode Whether to use 8-bit (true) or 4-bit (false) autotiling
+             */
+            template <typename Cell>
+            static void retile(Cell &cell, const std::size_t &width, const std::size_t &height, const std::size_t &x, const std::size_t &y, const bool &solidBoundaries, const bool &eightBitMode) {
+                if (cell(x, y) < 0) {
+                    return;
+                }
+                const auto filled = [&](const long long &cx, const long long &cy) -> bool {
+                    if (cx < 0 || cy < 0 || cx >= (long long)width || cy >= (long long)height) {
+                        return solidBoundaries;
+                    }
+                    return cell(cx, cy) >= 0;
+                };
+                const long long sx = x, sy = y;
+
+                const bool t = filled(sx, sy - 1);
+                const bool l = filled(sx - 1, sy);
+                const bool r = filled(sx + 1, sy);
+                const bool b = filled(sx, sy + 1);
+                if (!eightBitMode) {
+                    cell(x, y) = t + l * 2 + r * 4 + b * 8;
+                    return;
+                }
+                const unsigned char raw = filled(sx - 1, sy - 1) + t * 2 + filled(sx + 1, sy - 1) * 4 + l * 8 + r * 16 + filled(sx - 1, sy + 1) * 32 + b * 64 + filled(sx + 1, sy + 1) * 128;
+                cell(x, y) = bengine::eightBitTable.tiles[raw];
+            }
+            /** Recompute every tile within one tile of a position
+             * @param cell A function giving a reference to the value at (x, y)
+             * @param width The amount of tiles in each row
+             * @param height The amount of rows
+             * @param x x-position of the center tile
+             * @param y y-position of the center tile
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             * @param eightBitMode Whether to use 8-bit (true) or 4-bit (false) autotiling
+             */
+            template <typename Cell>
+            static void retileAround(Cell &cell, const std::size_t &width, const std::size_t &height, const std::size_t &x, const std::size_t &y, const bool &solidBoundaries, const bool &eightBitMode) {
+                for (std::size_t cy = y > 0 ? y - 1 : 0; cy <= y + 1 && cy < height; cy++) {
+                    for (std::size_t cx = x > 0 ? x - 1 : 0; cx <= x + 1 && cx < width; cx++) {
+                        // A 4-bit autotiling mask only depends on cardinal directions, so the corners are unaffected
+                        if (!eightBitMode && cx != x && cy != y) {
+                            continue;
+                        }
+                        autotiler::retile(cell, width, height, cx, cy, solidBoundaries, eightBitMode);
+                    }
+                }
+            }
+            /** Change a tile and update surrounding ones
+             * @param cell A function giving a reference to the value at (x, y)
+             * @param width The amount of tiles in each row
+             * @param height The amount of rows
+             * @param x x-position of the changed tile
+             * @param y y-position of the changed tile
+             * @param addTile Whether to add or remove a tile in the indicated position
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             * @param eightBitMode Whether to use 8-bit (true) or 4-bit (false) autotiling
+             * @returns The value of the updated tile
+             */
+            template <typename Cell>
+            static char updateTile(Cell cell, const std::size_t &width, const std::size_t &height, const std::size_t &x, const std::size_t &y, const bool &addTile, const bool &solidBoundaries, const bool &eightBitMode) {
+                if (x >= width || y >= height) {
+                    return -1;
+                }
+                cell(x, y) = addTile - 1;
+                autotiler::retileAround(cell, width, height, x, y, solidBoundaries, eightBitMode);
+                return cell(x, y);
+            }
+            /** Change several tiles, then update every tile around them
+             * @param cell A function giving a reference to the value at (x, y)
+             * @param width The amount of tiles in each row
+             * @param height The amount of rows
+             * @param changes The tiles to change (out-of-bounds changes are skipped)
+             * @param count The amount of tiles to change
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             * @param eightBitMode Whether to use 8-bit (true) or 4-bit (false) autotiling
+             */
+            template <typename Cell>
+            static void updateTiles(Cell cell, const std::size_t &width, const std::size_t &height, const bengine::tileChange *changes, const std::size_t &count, const bool &solidBoundaries, const bool &eightBitMode) {
+                // Every change is applied before anything is retiled so that each neighborhood is only computed against the final layout
+                for (std::size_t i = 0; i < count; i++) {
+                    if (changes[i].x < width && changes[i].y < height) {
+                        cell(changes[i].x, changes[i].y) = changes[i].addTile - 1;
+                    }
+                }
+                for (std::size_t i = 0; i < count; i++) {
+                    if (changes[i].x < width && changes[i].y < height) {
+                        autotiler::retileAround(cell, width, height, changes[i].x, changes[i].y, solidBoundaries, eightBitMode);
+                    }
+                }
+            }
 
         public:
             /// @brief bengine::autoTiler constructor
@@ -290,6 +500,86 @@ namespace bengine {
             /// @brief bengine::autoTiler deconstructor
             ~autotiler() {}
 
+            /** Compute the 4-bit autotiling value of every cell of a bit grid at once
+             * 
+             * Rows are shifted up/down/left/right 64 cells at a time and the results are spread into bytes 8 cells at a time, so a 100x100 grid takes a few microseconds
+             * @param rows The grid as rows of 64-bit words (bit x % 64 of word x / 64 is cell x; bits past the width must be clear)
+             * @param stride The amount of words in each row
+             * @param width The amount of cells in each row
+             * @param height The amount of rows
+             * @param output Where to write width * height values (row-major); -1 for empty cells, otherwise the 4-bit mask as fourBit() would give it
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             */
+            static void fourBitMasks(const std::uint64_t *rows, const std::size_t &stride, const std::size_t &width, const std::size_t &height, char *output, const bool &solidBoundaries = false) {
+                for (std::size_t y = 0; y < height; y++) {
+                    const std::uint64_t *above = y > 0 ? rows + (y - 1) * stride : nullptr;
+                    const std::uint64_t *row = rows + y * stride;
+                    const std::uint64_t *below = y + 1 < height ? rows + (y + 1) * stride : nullptr;
+                    for (std::size_t w = 0; w < stride; w++) {
+                        const std::uint64_t self = autotiler::neighborWord(row, w, stride, width, 0, solidBoundaries);
+                        const std::uint64_t t = autotiler::neighborWord(above, w, stride, width, 0, solidBoundaries);
+                        const std::uint64_t l = autotiler::neighborWord(row, w, stride, width, -1, solidBoundaries);
+                        const std::uint64_t r = autotiler::neighborWord(row, w, stride, width, 1, solidBoundaries);
+                        const std::uint64_t b = autotiler::neighborWord(below, w, stride, width, 0, solidBoundaries);
+
+                        for (std::size_t x = w * 64; x < width && x < w * 64 + 64; x += 8) {
+                            const unsigned char shift = x % 64;
+                            const std::uint64_t filled = bengine::byteSpreads.words[(unsigned char)(self >> shift)] * 0xFF;
+                            const std::uint64_t masks = bengine::byteSpreads.words[(unsigned char)(t >> shift)] | bengine::byteSpreads.words[(unsigned char)(l >> shift)] << 1 | bengine::byteSpreads.words[(unsigned char)(r >> shift)] << 2 | bengine::byteSpreads.words[(unsigned char)(b >> shift)] << 3;
+                            // Empty cells become 0xFF (-1)
+                            const std::uint64_t values = (masks & filled) | ~filled;
+                            if (width - x >= 8) {
+                                std::memcpy(output + y * width + x, &values, 8);
+                            } else {
+                                std::memcpy(output + y * width + x, &values, width - x);
+                            }
+                        }
+                    }
+                }
+            }
+            /** Compute the 8-bit autotiling value of every cell of a bit grid at once
+             * 
+             * Neighbor words are found the same way as in fourBitMasks(), then each cell's raw mask is mapped through bengine::eightBitTable
+             * @param rows The grid as rows of 64-bit words (bit x % 64 of word x / 64 is cell x; bits past the width must be clear)
+             * @param stride The amount of words in each row
+             * @param width The amount of cells in each row
+             * @param height The amount of rows
+             * @param output Where to write width * height values (row-major); -1 for empty cells, otherwise the tile as eightBit() would give it
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             */
+            static void eightBitTiles(const std::uint64_t *rows, const std::size_t &stride, const std::size_t &width, const std::size_t &height, char *output, const bool &solidBoundaries = false) {
+                for (std::size_t y = 0; y < height; y++) {
+                    const std::uint64_t *above = y > 0 ? rows + (y - 1) * stride : nullptr;
+                    const std::uint64_t *row = rows + y * stride;
+                    const std::uint64_t *below = y + 1 < height ? rows + (y + 1) * stride : nullptr;
+                    for (std::size_t w = 0; w < stride; w++) {
+                        const std::uint64_t self = autotiler::neighborWord(row, w, stride, width, 0, solidBoundaries);
+                        const std::uint64_t neighbors[8] = {
+                            autotiler::neighborWord(above, w, stride, width, -1, solidBoundaries),
+                            autotiler::neighborWord(above, w, stride, width, 0, solidBoundaries),
+                            autotiler::neighborWord(above, w, stride, width, 1, solidBoundaries),
+                            autotiler::neighborWord(row, w, stride, width, -1, solidBoundaries),
+                            autotiler::neighborWord(row, w, stride, width, 1, solidBoundaries),
+                            autotiler::neighborWord(below, w, stride, width, -1, solidBoundaries),
+                            autotiler::neighborWord(below, w, stride, width, 0, solidBoundaries),
+                            autotiler::neighborWord(below, w, stride, width, 1, solidBoundaries)
+                        };
+
+                        for (std::size_t x = w * 64; x < width && x < w * 64 + 64; x += 8) {
+                            const unsigned char shift = x % 64;
+                            std::uint64_t masks = 0;
+                            for (unsigned char i = 0; i < 8; i++) {
+                                masks |= bengine::byteSpreads.words[(unsigned char)(neighbors[i] >> shift)] << i;
+                            }
+                            const unsigned char filled = self >> shift;
+                            for (unsigned char i = 0; i < 8 && x + i < width; i++) {
+                                output[y * width + x + i] = (filled >> i) & 1 ? bengine::eightBitTable.tiles[(masks >> (i * 8)) & 0xFF] : -1;
+                            }
+                        }
+                    }
+                }
+            }
+
             /** Change a tile and update surrounding ones in a 4-bit autotiling grid
              * @param grid Grid of indexing values that dictate the source frame for the texture sheet
              * @param x x-position of the changed tile in the grid
@@ -299,36 +589,44 @@ namespace bengine {
              * @returns The value of the updated tile
              */
             static char fourBit(std::vector<std::vector<char>> &grid, const unsigned long int &x, const unsigned long int &y, const bool &addTile = true, const bool &solidBoundaries = false) {
-                if (y >= grid.size() || x >= grid.at(0).size()) {
+                if (grid.size() == 0) {
                     return -1;
                 }
-                grid[y][x] = addTile - 1;
-
-                for (char i = -1; i <= 1; i++) {
-                    for (char j = -1; j <= 1; j++) {
-                        // A 4-bit autotiling mask only requires cardinal directions, so the corners are skipped
-                        if (std::abs(i) == 1 && std::abs(j) == 1) {
-                            continue;
-                        }
-                        // Check if the current tile is in-bounds
-                        if (y + i < 0 || y + i >= grid.size() || x + j < 0 || x + j >= grid.at(0).size()) {
-                            continue;
-                        }
-                        // Check to see if the current tile would even display anything
-                        if (grid.at(y + i).at(x + j) < 0) {
-                            continue;
-                        }
-
-                        const bool t = y + i > 0 ? (grid.at(y + i - 1).at(x + j) >= 0) : solidBoundaries;
-                        const bool l = x + j > 0 ? (grid.at(y + i).at(x + j - 1) >= 0) : solidBoundaries;
-                        const bool r = x + j < grid.at(0).size() - 1 ? (grid.at(y + i).at(x + j + 1) >= 0) : solidBoundaries;
-                        const bool b = y + i < grid.size() - 1 ? (grid.at(y + i + 1).at(x + j) >= 0) : solidBoundaries;
-
-                        grid[y + i][x + j] = t + l * 2 + r * 4 + b * 8;
-                    }
-                }
-                return grid.at(y).at(x);
+                return autotiler::updateTile([&grid](const std::size_t &cx, const std::size_t &cy) -> char & {
+                    return grid[cy][cx];
+                }, grid.at(0).size(), grid.size(), x, y, addTile, solidBoundaries, false);
             }
+            /** Change a tile and update surrounding ones in a 4-bit autotiling grid stored as one block of memory
+             * @param grid The first value of the grid (row-major)
+             * @param stride The distance between the starts of consecutive rows
+             * @param width The amount of tiles in each row
+             * @param height The amount of rows
+             * @param x x-position of the changed tile in the grid
+             * @param y y-position of the changed tile in the grid
+             * @param addTile Whether to add or remove a tile in the indicated position
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             * @returns The value of the updated tile
+             */
+            static char fourBit(char *grid, const std::size_t &stride, const std::size_t &width, const std::size_t &height, const std::size_t &x, const std::size_t &y, const bool &addTile = true, const bool &solidBoundaries = false) {
+                return autotiler::updateTile([grid, stride](const std::size_t &cx, const std::size_t &cy) -> char & {
+                    return grid[cy * stride + cx];
+                }, width, height, x, y, addTile, solidBoundaries, false);
+            }
+            /** Change several tiles and update the ones around them in a 4-bit autotiling grid stored as one block of memory (e.g. when placing a whole piece)
+             * @param grid The first value of the grid (row-major)
+             * @param stride The distance between the starts of consecutive rows
+             * @param width The amount of tiles in each row
+             * @param height The amount of rows
+             * @param changes The tiles to change
+             * @param count The amount of tiles to change
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             */
+            static void fourBit(char *grid, const std::size_t &stride, const std::size_t &width, const std::size_t &height, const bengine::tileChange *changes, const std::size_t &count, const bool &solidBoundaries = false) {
+                autotiler::updateTiles([grid, stride](const std::size_t &cx, const std::size_t &cy) -> char & {
+                    return grid[cy * stride + cx];
+                }, width, height, changes, count, solidBoundaries, false);
+            }
+
             /** Change a tile and update surrounding ones in an 8-bit autotiling grid
              * @param grid Grid of indexing values that dictate the source frame for the texture sheet
              * @param x x-position of the changed tile in the grid
@@ -338,49 +636,44 @@ namespace bengine {
              * @returns The value of the updated tile
              */
             static char eightBit(std::vector<std::vector<char>> &grid, const unsigned long int &x, const unsigned long int &y, const bool &addTile = true, const bool &solidBoundaries = false) {
-                if (y >= grid.size() || x >= grid.at(0).size()) {
+                if (grid.size() == 0) {
                     return -1;
                 }
-                grid[y][x] = addTile - 1;
-
-                for (char i = -1; i <= 1; i++) {
-                    for (char j = -1; j <= 1; j++) {
-                        // Check if the current tile is in-bounds
-                        if (y + i < 0 || y + i >= grid.size() || x + j < 0 || x + j >= grid.at(0).size()) {
-                            continue;
-                        }
-                        // Check to see if the current tile would even display anything
-                        if (grid.at(y + i).at(x + j) < 0) {
-                            continue;
-                        }
-
-                        const bool tl = y + i > 0 && x + j > 0 ? (grid.at(y + i - 1).at(x + j - 1) >= 0) : solidBoundaries;
-                        const bool t = y + i > 0 ? (grid.at(y + i - 1).at(x + j) >= 0) : solidBoundaries;
-                        const bool tr = y + i > 0 && x + j < grid.at(0).size() - 1 ? (grid.at(y + i - 1).at(x + j + 1) >= 0) : solidBoundaries;
-                        const bool l = x + j > 0 ? (grid.at(y + i).at(x + j - 1) >= 0) : solidBoundaries;
-                        const bool r = x + j < grid.at(0).size() - 1 ? (grid.at(y + i).at(x + j + 1) >= 0) : solidBoundaries;
-                        const bool bl = y + i < grid.size() - 1 && x + j > 0 ? (grid.at(y + i + 1).at(x + j - 1) >= 0) : solidBoundaries;
-                        const bool b = y + i < grid.size() - 1 ? (grid.at(y + i + 1).at(x + j) >= 0) : solidBoundaries;
-                        const bool br = y + i < grid.size() - 1 && x + j < grid.at(0).size() - 1 ? (grid.at(y + i + 1).at(x + j + 1) >= 0) : solidBoundaries;
-
-                        const unsigned char maskVal = (tl && t && l) + t * 2 + (tr && t && r) * 4 + l * 8 + r * 16 + (bl && b && l) * 32 + b * 64 + (br && b && r) * 128;
-                        if (maskVal == 0) {
-                            grid[y + i][x + j] = 47;
-                            break;
-                        }
-                        for (unsigned char i = 0; i < 48; i++) {
-                            if (maskVal == key[i]) {
-                                grid[y + i][x + j] = i + 1;
-                                break;
-                            }
-                        }
-                    }
-                }
-                return grid.at(y).at(x);
+                return autotiler::updateTile([&grid](const std::size_t &cx, const std::size_t &cy) -> char & {
+                    return grid[cy][cx];
+                }, grid.at(0).size(), grid.size(), x, y, addTile, solidBoundaries, true);
+            }
+            /** Change a tile and update surrounding ones in an 8-bit autotiling grid stored as one block of memory
+             * @param grid The first value of the grid (row-major)
+             * @param stride The distance between the starts of consecutive rows
+             * @param width The amount of tiles in each row
+             * @param height The amount of rows
+             * @param x x-position of the changed tile in the grid
+             * @param y y-position of the changed tile in the grid
+             * @param addTile Whether to add or remove a tile in the indicated position
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             * @returns The value of the updated tile
+             */
+            static char eightBit(char *grid, const std::size_t &stride, const std::size_t &width, const std::size_t &height, const std::size_t &x, const std::size_t &y, const bool &addTile = true, const bool &solidBoundaries = false) {
+                return autotiler::updateTile([grid, stride](const std::size_t &cx, const std::size_t &cy) -> char & {
+                    return grid[cy * stride + cx];
+                }, width, height, x, y, addTile, solidBoundaries, true);
+            }
+            /** Change several tiles and update the ones around them in an 8-bit autotiling grid stored as one block of memory (e.g. when placing a whole piece)
+             * @param grid The first value of the grid (row-major)
+             * @param stride The distance between the starts of consecutive rows
+             * @param width The amount of tiles in each row
+             * @param height The amount of rows
+             * @param changes The tiles to change
+             * @param count The amount of tiles to change
+             * @param solidBoundaries Whether to consider the edges of the grid as full or empty tiles
+             */
+            static void eightBit(char *grid, const std::size_t &stride, const std::size_t &width, const std::size_t &height, const bengine::tileChange *changes, const std::size_t &count, const bool &solidBoundaries = false) {
+                autotiler::updateTiles([grid, stride](const std::size_t &cx, const std::size_t &cy) -> char & {
+                    return grid[cy * stride + cx];
+                }, width, height, changes, count, solidBoundaries, true);
             }
     };
-    /// @brief Key containing the 48 bitmasks relevant to eight-bit autotiling
-    const unsigned char bengine::autotiler::key[48] = {2, 8, 10, 11, 16, 18, 22, 24, 26, 27, 30, 31, 64, 66, 72, 74, 75, 80, 82, 86, 88, 90, 91, 94, 95, 104, 106, 107, 120, 122, 123, 126, 127, 208, 210, 214, 216, 218, 219, 222, 223, 248, 250, 251, 254, 255};
 }
 
 #endif // BENGINE_HELPERS_hpp
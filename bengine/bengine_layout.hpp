@@ -0,0 +1,235 @@
+#ifndef BENGINE_LAYOUT_hpp
+#define BENGINE_LAYOUT_hpp
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+#include "bengine_texture.hpp"
+#include "bengine_window.hpp"
+
+namespace bengine {
+    /** A piece of text that is only turned into a texture again when it changes
+     *
+     * Setting the same text again is just a string compare, so a HUD can set its labels every frame without rasterizing anything
+     */
+    class textLabel {
+        private:
+            /// @brief The font to render with (not owned)
+            TTF_Font *font = nullptr;
+            /// @brief The color of the text
+            SDL_Color color = {255, 255, 255, 255};
+            /// @brief The maximum width of the text before it wraps (px) (zero prevents any wrapping)
+            Uint32 wrapWidth = 0;
+            /// @brief The text
+            std::u16string text = u"";
+            /// @brief The rendered text
+            bengine::basicTexture texture;
+            /// @brief Whether the text, font, or color changed since the texture was rendered
+            bool dirty = true;
+
+        public:
+            /** bengine::textLabel constructor
+             * @param font The font to render with (must outlive the label's last render)
+             * @param color The color of the text
+             * @param wrapWidth The maximum width of the text before it wraps (px) (zero prevents any wrapping)
+             */
+            textLabel(TTF_Font *font = nullptr, const SDL_Color &color = {255, 255, 255, 255}, const Uint32 &wrapWidth = 0) : font(font), color(color), wrapWidth(wrapWidth) {}
+            /// @brief bengine::textLabel deconstructor
+            ~textLabel() {}
+
+            /** Get the text of the label
+             * @returns The text of the label
+             */
+            const std::u16string &getText() const {
+                return this->text;
+            }
+            /** Set the text of the label; nothing is re-rendered if it is the same as before
+             * @param text The new text
+             * @returns Whether the text changed
+             */
+            bool setText(const std::u16string &text) {
+                if (text == this->text) {
+                    return false;
+                }
+                this->text = text;
+                this->dirty = true;
+                return true;
+            }
+            /** Set the font of the label (e.g. once it has finished loading)
+             * @param font The new font (must outlive the label's last render)
+             * @returns The old font
+             */
+            TTF_Font *setFont(TTF_Font *font) {
+                TTF_Font *output = this->font;
+                this->dirty |= font != this->font;
+                this->font = font;
+                return output;
+            }
+            /** Set the color of the label
+             * @param color The new color
+             * @returns The old color
+             */
+            SDL_Color setColor(const SDL_Color &color) {
+                const SDL_Color output = this->color;
+                this->dirty |= color.r != this->color.r || color.g != this->color.g || color.b != this->color.b || color.a != this->color.a;
+                this->color = color;
+                return output;
+            }
+
+            /** Get the rendered text, rendering it first if anything changed
+             * @param window The window to render with
+             * @returns The texture of the text framed to its size (empty if there is no text or font)
+             */
+            const bengine::basicTexture &getTexture(bengine::window &window) {
+                if (this->dirty) {
+                    this->dirty = false;
+                    this->texture = this->font == nullptr || this->text.empty() ? bengine::basicTexture() : window.loadText(this->font, this->text.c_str(), this->color, this->wrapWidth);
+                }
+                return this->texture;
+            }
+            /** Draw the label with its top-left corner at a point
+             * @param window The window to draw to
+             * @param x x-position of the top-left corner of the text (px)
+             * @param y y-position of the top-left corner of the text (px)
+             */
+            void render(bengine::window &window, const int &x, const int &y) {
+                const bengine::basicTexture &texture = this->getTexture(window);
+                if (texture.getTexture() != nullptr) {
+                    window.renderBasicTexture(texture, {x, y, texture.getFrame().w, texture.getFrame().h});
+                }
+            }
+    };
+
+    /** A flat list of draws whose rectangles are worked out once, when the layout changes, rather than every frame
+     *
+     * Items point at the textures and labels they draw, so changing what a texture shows or what a label says does not touch the list; only moving things around needs clear() and the items added again
+     */
+    class cachedLayout {
+        private:
+            typedef enum {
+                LAYOUT_BASIC = 0,
+                LAYOUT_MODDED = 1,
+                LAYOUT_TEXT = 2
+            } layoutItemTypes;
+
+            /// @brief One draw of the layout
+            struct item {
+                /// @brief One of layoutItemTypes
+                unsigned char type;
+                /// @brief Whether the item is drawn
+                bool visible;
+                /// @brief What to draw (not owned; points at a bengine::basicTexture, bengine::moddedTexture, or bengine::textLabel depending on type)
+                void *source;
+                /// @brief Where to draw it (px); only the top-left corner is used for text
+                SDL_Rect dst;
+            };
+
+            /// @brief Every item in drawing order
+            std::vector<item> items = {};
+
+        public:
+            /// @brief bengine::cachedLayout constructor
+            cachedLayout() {}
+            /// @brief bengine::cachedLayout deconstructor
+            ~cachedLayout() {}
+
+            /** Add a texture to the layout
+             * @param texture The texture to draw (must outlive the layout's last render)
+             * @param dst Where to draw it (px)
+             * @returns The index of the item
+             */
+            std::size_t add(const bengine::basicTexture &texture, const SDL_Rect &dst) {
+                this->items.push_back({LAYOUT_BASIC, true, (void *)&texture, dst});
+                return this->items.size() - 1;
+            }
+            /** Add a texture with color modifications to the layout
+             * @param texture The texture to draw (must outlive the layout's last render)
+             * @param dst Where to draw it (px)
+             * @returns The index of the item
+             */
+            std::size_t add(const bengine::moddedTexture &texture, const SDL_Rect &dst) {
+                this->items.push_back({LAYOUT_MODDED, true, (void *)&texture, dst});
+                return this->items.size() - 1;
+            }
+            /** Add a label to the layout
+             * @param label The label to draw (must outlive the layout's last render)
+             * @param x x-position of the top-left corner of the text (px)
+             * @param y y-position of the top-left corner of the text (px)
+             * @returns The index of the item
+             */
+            std::size_t add(bengine::textLabel &label, const int &x, const int &y) {
+                this->items.push_back({LAYOUT_TEXT, true, (void *)&label, {x, y, 0, 0}});
+                return this->items.size() - 1;
+            }
+            /** Show or hide an item without laying everything out again
+             * @param index The index of the item
+             * @param visible Whether the item should be drawn
+             */
+            void setVisible(const std::size_t &index, const bool &visible) {
+                if (index < this->items.size()) {
+                    this->items[index].visible = visible;
+                }
+            }
+            /// @brief Remove every item
+            void clear() {
+                this->items.clear();
+            }
+            /** Get the amount of items in the layout
+             * @returns The amount of items in the layout
+             */
+            std::size_t size() const {
+                return this->items.size();
+            }
+
+            /** Draw every visible item in order
+             * @param window The window to draw to
+             */
+            void render(bengine::window &window) const {
+                for (std::size_t i = 0; i < this->items.size(); i++) {
+                    const item &current = this->items[i];
+                    if (!current.visible) {
+                        continue;
+                    }
+                    switch (current.type) {
+                        case LAYOUT_BASIC:
+                            window.renderBasicTexture(*(const bengine::basicTexture *)current.source, current.dst);
+                            break;
+                        case LAYOUT_MODDED:
+                            window.renderModdedTexture(*(const bengine::moddedTexture *)current.source, current.dst);
+                            break;
+                        case LAYOUT_TEXT:
+                            ((bengine::textLabel *)current.source)->render(window, current.dst.x, current.dst.y);
+                            break;
+                    }
+                }
+            }
+            /** Record every visible item into the window's command list, so that the window can sort and merge the layout's draws and submit them again on later frames
+             * @param window The window to record into (its command list is not cleared first)
+             */
+            void record(bengine::window &window) const {
+                for (std::size_t i = 0; i < this->items.size(); i++) {
+                    const item &current = this->items[i];
+                    if (!current.visible) {
+                        continue;
+                    }
+                    switch (current.type) {
+                        case LAYOUT_BASIC:
+                            window.recordBasicTexture(*(const bengine::basicTexture *)current.source, current.dst);
+                            break;
+                        case LAYOUT_MODDED:
+                            window.recordModdedTexture(*(const bengine::moddedTexture *)current.source, current.dst);
+                            break;
+                        case LAYOUT_TEXT: {
+                            const bengine::basicTexture &texture = ((bengine::textLabel *)current.source)->getTexture(window);
+                            window.recordBasicTexture(texture, {current.dst.x, current.dst.y, texture.getFrame().w, texture.getFrame().h});
+                            break;
+                        }
+                    }
+                }
+            }
+    };
+}
+
+#endif // BENGINE_LAYOUT_hpp
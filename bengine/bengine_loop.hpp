@@ -5,8 +5,10 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <iostream>
+#include <vector>
 
 #include "bengine_window.hpp"
+#include "bengine_pacing.hpp"
 
 namespace bengine {
     /// @brief A virtual class used to contain the basic looping mechanism required to seperate rendering/computing while maintaining consistent computational behavior
@@ -24,8 +26,17 @@ namespace bengine {
 
             /// @brief The window that is interacted with and displays everything
             bengine::window window = bengine::window("window", 1280, 720, SDL_WINDOW_SHOWN);
+            /// @brief Keeps the frames evenly spaced (sleeps at the display's refresh rate by default)
+            bengine::framePacer pacer;
             /// @brief The SDL_Event structure used to process events
             SDL_Event event;
+            /// @brief Whether consecutive mouse motion events are merged into one before handleEvent() sees them
+            bool coalesceMotion = true;
+            /** Every position merged into the motion event being handled, oldest first (the last one is the event's own position)
+             * 
+             * Handlers that need the whole path of a fast drag (e.g. painting) can walk this instead of only seeing where the mouse ended up
+             */
+            std::vector<SDL_Point> motionPath = {};
             /// @brief The state of the keyboard; good for instantaneous feedback on which keys are pressed and which aren't
             const Uint8 *keystate = SDL_GetKeyboardState(NULL);
 
@@ -36,6 +47,64 @@ namespace bengine {
             /// @brief A virtual function that will be called each rendering frame to handle all of the rendering-related tasks
             virtual void render() = 0;
 
+        private:
+            /// @brief The merged mouse motion that has not been handled yet
+            SDL_Event pendingMotion;
+            /// @brief Whether pendingMotion holds anything
+            bool motionPending = false;
+
+            /// @brief Do the loop's own handling of the event in this->event, then pass it on to handleEvent()
+            void dispatchEvent() {
+                switch (this->event.type) {
+                    case SDL_QUIT:
+                        this->loopRunning = false;
+                        break;
+                    case SDL_WINDOWEVENT:
+                        this->window.handleEvent(this->event.window);
+                        this->visualsChanged = true;
+                        break;
+                }
+                this->handleEvent();
+            }
+            /// @brief Hand the merged mouse motion to handleEvent(), if there is any
+            void flushMotion() {
+                if (!this->motionPending) {
+                    return;
+                }
+                this->motionPending = false;
+                this->event = this->pendingMotion;
+                this->dispatchEvent();
+                this->motionPath.clear();
+            }
+            /** Take in one polled event; mouse motion is held back and merged with any motion right after it, and everything else first flushes the held motion so that the order of positions and button presses is kept
+             * @param polled The event
+             */
+            void queueEvent(const SDL_Event &polled) {
+                if (this->coalesceMotion && polled.type == SDL_MOUSEMOTION) {
+                    if (this->motionPending && this->pendingMotion.motion.windowID == polled.motion.windowID && this->pendingMotion.motion.which == polled.motion.which) {
+                        // Keep the newest position and button state while adding up the relative motion
+                        const Sint32 xrel = this->pendingMotion.motion.xrel + polled.motion.xrel;
+                        const Sint32 yrel = this->pendingMotion.motion.yrel + polled.motion.yrel;
+                        this->pendingMotion = polled;
+                        this->pendingMotion.motion.xrel = xrel;
+                        this->pendingMotion.motion.yrel = yrel;
+                    } else {
+                        this->flushMotion();
+                        this->pendingMotion = polled;
+                        this->motionPending = true;
+                    }
+                    this->motionPath.push_back({polled.motion.x, polled.motion.y});
+                    return;
+                }
+
+                this->flushMotion();
+                this->event = polled;
+                if (polled.type == SDL_MOUSEMOTION) {
+                    this->motionPath.assign(1, {polled.motion.x, polled.motion.y});
+                }
+                this->dispatchEvent();
+            }
+
         public:
             /** bengine::loop constructor; mainly creates the window that will be used
              * @param title The title of the window being created
@@ -63,10 +132,14 @@ namespace bengine {
                 this->window.setBaseWidth(width);
                 this->window.setBaseHeight(height);
 
+                this->pacer.apply(this->window);
+
                 SDL_StopTextInput();
             }
             /// @brief bengine::loop deconstructor; pretty much just handles some SDL cleanup
             ~loop() {
+                // The window's textures and renderer have to go before SDL does
+                this->window.close();
                 TTF_Quit();
                 IMG_Quit();
                 SDL_Quit();
@@ -76,33 +149,24 @@ namespace bengine {
              * @returns 0 (anything additional hasn't been added yet)
              */
             int run() {
-                Uint32 startTicks = 0;
-                Uint32 frameTicks = 0;
+                bool presented = false;
+                SDL_Event polled;
                 double currentTime = SDL_GetTicks() * 0.01;
                 long double newTime = 0.0;
                 long double frameTime = 0.0;
                 double accumulator = 0.0;
 
                 while (this->loopRunning) {
-                    startTicks = SDL_GetTicks();
                     newTime = SDL_GetTicks() * 0.01;
                     frameTime = newTime - currentTime;
                     currentTime = newTime;
                     accumulator += frameTime;
 
                     while (accumulator >= this->deltaTime) {
-                        while (SDL_PollEvent(&this->event)) {
-                            switch (this->event.type) {
-                                case SDL_QUIT:
-                                    this->loopRunning = false;
-                                    break;
-                                case SDL_WINDOWEVENT:
-                                    this->window.handleEvent(this->event.window);
-                                    this->visualsChanged = true;
-                                    break;
-                            }
-                            this->handleEvent();
+                        while (SDL_PollEvent(&polled)) {
+                            this->queueEvent(polled);
                         }
+                        this->flushMotion();
 
                         this->compute();
 
@@ -110,19 +174,43 @@ namespace bengine {
                         accumulator -= this->deltaTime;
                     }
 
-                    if (this->visualsChanged) {
+                    if ((presented = this->visualsChanged)) {
                         this->visualsChanged = false;
                         this->window.clear();
                         this->render();
                         this->window.present();
                     }
 
-                    if ((frameTicks = SDL_GetTicks() - startTicks) < (Uint32)(1000 / this->window.refreshRate())) {
-                        SDL_Delay(1000 / this->window.refreshRate() - frameTicks);
-                    }
+                    this->pacer.endFrame(this->window, presented);
                 }
                 return 0;
             }
+
+            /** Set whether consecutive mouse motion events are merged into one before handleEvent() sees them (on by default)
+             * @param state Whether to merge mouse motion
+             * @returns Whether mouse motion was being merged before
+             */
+            bool setMotionCoalescing(const bool &state) {
+                const bool output = this->coalesceMotion;
+                this->coalesceMotion = state;
+                return output;
+            }
+
+            /** Set how the loop's frames are paced
+             * @param mode One of bengine::framePacingModes
+             * @param targetRate The wanted frames per second; 0 follows the display's refresh rate
+             */
+            void setPacing(const unsigned char &mode, const double &targetRate = 0) {
+                this->pacer.setMode(mode);
+                this->pacer.setTargetRate(targetRate);
+                this->pacer.apply(this->window);
+            }
+            /** Get the loop's frame pacer (for its timings or finer settings)
+             * @returns The loop's frame pacer
+             */
+            bengine::framePacer &getPacer() {
+                return this->pacer;
+            }
     };
 }
 
@@ -4,6 +4,8 @@
 #include <SDL2/SDL.h>
 #include <iostream>
 #include <cmath>
+#include <vector>
+#include <algorithm>
 
 #include "btils_main.hpp"
 #include "bengine_window.hpp"
@@ -508,14 +510,39 @@ namespace bengine {
             Uint16 evenWidth = 1;
             /// @brief A height for the matrix that allows for height / rows without a remainder; greater than or equal to the value of the regular height of the matrix
             Uint16 evenHeight = 1;
+            /// @brief The column of every pixel offset from the left edge of the matrix (0 through the width, inclusive)
+            std::vector<Uint16> colLookup = {0};
+            /// @brief The row of every pixel offset from the top edge of the matrix (0 through the height, inclusive)
+            std::vector<Uint16> rowLookup = {0};
 
-            /// @brief Update the matrix's evenWidth
+            /** Fill a pixel-to-cell lookup so that pixel p lands in cell floor(p * cells / length), using only integer adds and compares
+             * @param lookup The lookup to fill; resized to length + 1 (the far edge is inclusive and maps to the last cell)
+             * @param length The length of the matrix along the axis (px)
+             * @param cells The amount of cells along the axis
+             */
+            static void buildLookup(std::vector<Uint16> &lookup, const Uint16 &length, const Uint16 &cells) {
+                lookup.resize((std::size_t)length + 1);
+                Uint16 cell = 0;
+                // next is where the next cell starts, scaled by cells so that it stays an integer: (cell + 1) * length
+                Uint32 next = length;
+                for (Uint32 p = 0, scaled = 0; p <= length; p++, scaled += cells) {
+                    while (cell + 1 < cells && next <= scaled) {
+                        cell++;
+                        next += length;
+                    }
+                    lookup[p] = cell;
+                }
+            }
+
+            /// @brief Update the matrix's evenWidth and the lookup of each pixel's column
             void updateEvenWidth() {
                 this->evenWidth = btils::lcm<Uint16>(this->getW(), this->cols);
+                bengine::clickMatrix::buildLookup(this->colLookup, this->getW(), this->cols);
             }
-            /// @brief Update the matrix's evenHeight
+            /// @brief Update the matrix's evenHeight and the lookup of each pixel's row
             void updateEvenHeight() {
                 this->evenHeight = btils::lcm<Uint16>(this->getH(), this->rows);
+                bengine::clickMatrix::buildLookup(this->rowLookup, this->getH(), this->rows);
             }
 
         public:
@@ -530,8 +557,6 @@ namespace bengine {
             clickMatrix(const Uint16 x1 = 0, const Uint16 y1 = 0, const Uint16 x2 = 0, const Uint16 y2 = 0, const Uint16 &rows = 1, const Uint16 &cols = 1) : clickRectangle(x1, y1, x2, y2) {
                 this->setRows(rows);
                 this->setCols(cols);
-                this->updateEvenWidth();
-                this->updateEvenHeight();
             }
             /// @brief bengine::clickMatrix deconstructor
             ~clickMatrix() {}
@@ -559,6 +584,7 @@ namespace bengine {
                 } else {
                     this->rows = rows;
                 }
+                this->updateEvenHeight();
                 return output;
             }
             /** Get the amount of columns in the matrix
@@ -572,6 +598,7 @@ namespace bengine {
                 } else {
                     this->cols = cols;
                 }
+                this->updateEvenWidth();
                 return output;
             }
             /** Get the width for the matrix that allows for width / cols without a remainder; greater than or equal to the value of the regular width of the matrix
@@ -696,21 +723,55 @@ namespace bengine {
                 this->updateEvenHeight();
             }
 
+            /** Find the cell within the matrix that a point is located in
+             * 
+             * Pixel p (from the matrix's top-left corner) is in column floor(p * cols / width) and row floor(p * rows / height), exactly; both come from lookups built when the matrix's size changes
+             * @param x The x-position of the point
+             * @param y The y-position of the point
+             * @returns The cell within the matrix that the point is located in; UINT32_MAX as a sentinal value if it is outside of the matrix
+             */
+            Uint32 checkPos(const Uint16 &x, const Uint16 &y) const {
+                if (this->getW() == 0 || this->getH() == 0) {
+                    return UINT32_MAX;
+                }
+                if (x < this->x1 || x > this->x2 || y < this->y1 || y > this->y2) {
+                    return UINT32_MAX;
+                }
+                return (Uint32)this->rowLookup[y - this->y1] * this->cols + this->colLookup[x - this->x1];
+            }
             /** Find the cell within the matrix that the mouse is located in
              * @param mouseState The mouse's state
-             * @returns The cell within the matrix that the mouse is located in
+             * @returns The cell within the matrix that the mouse is located in; UINT32_MAX as a sentinal value if it is outside of the matrix
              */
             Uint32 checkPos(const normalMouseState &mouseState) const {
+                return this->checkPos(mouseState.posx(), mouseState.posy());
+            }
+            /** Find the cells within the matrix that several points are located in (e.g. every motion event coalesced into a frame)
+             * @param points The points to check
+             * @param count The amount of points
+             * @param output Filled with the cell of each point in order; UINT32_MAX for points outside of the matrix (must have room for count cells)
+             * @returns The amount of points that were inside of the matrix
+             */
+            std::size_t checkPositions(const SDL_Point *points, const std::size_t &count, Uint32 *output) const {
+                std::size_t inside = 0;
                 if (this->getW() == 0 || this->getH() == 0) {
-                    return UINT32_MAX;
+                    for (std::size_t i = 0; i < count; i++) {
+                        output[i] = UINT32_MAX;
+                    }
+                    return 0;
                 }
-                if (mouseState.posx() < this->x1 || mouseState.posx() > this->x2 || mouseState.posy() < this->y1 || mouseState.posy() > this->y2) {
-                    return UINT32_MAX;
+                for (std::size_t i = 0; i < count; i++) {
+                    // Shifting into the matrix's space first lets one unsigned compare per axis catch both sides
+                    const Uint32 x = (Uint32)(points[i].x - this->x1);
+                    const Uint32 y = (Uint32)(points[i].y - this->y1);
+                    if (x > this->getW() || y > this->getH()) {
+                        output[i] = UINT32_MAX;
+                        continue;
+                    }
+                    output[i] = (Uint32)this->rowLookup[y] * this->cols + this->colLookup[x];
+                    inside++;
                 }
-                const Uint16 col = ((mouseState.posx() - this->x1) * (double)(evenWidth / this->getW())) / (evenWidth / this->cols);
-                const Uint16 row = ((mouseState.posy() - this->y1) * (double)(evenHeight / this->getH())) / (evenHeight / this->rows);
-
-                return (row >= this->rows ? this->rows - 1 : row) * this->cols + (col >= this->cols ? this->cols - 1 : col);
+                return inside;
             }
             /** Find the cell within the matrix that the mouse is located in and confirm that the mouse has clicked the correct button
              * @param mouseState The mouse's state
@@ -722,6 +783,277 @@ namespace bengine {
                 return mouseState.pressed(button) ? pos : UINT32_MAX;
             }
     };
+
+    /** A spatial index over clickable regions that answers which region is on top at a point
+     *
+     * Regions are bucketed into a uniform grid of square cells when the layout changes; each cell keeps the regions overlapping it sorted from the top down, so a lookup checks one cell's few regions no matter how many regions there are.
+     * Adding, moving, or removing regions only marks the index as out of date; the buckets are rebuilt on the next lookup (or by rebuild())
+     */
+    class hitIndex {
+        private:
+            typedef enum {
+                HITSHAPE_RECTANGLE = 0,
+                HITSHAPE_CIRCLE = 1
+            } hitShapes;
+
+            /// @brief A registered region
+            struct region {
+                /// @brief The id given when the region was added
+                Uint32 id;
+                /// @brief The stacking order of the region; higher is on top
+                int z;
+                /// @brief The order the region was (re)placed in; breaks ties in z so that the most recent region is on top
+                Uint32 order;
+                /// @brief One of hitShapes
+                unsigned char shape;
+                /// @brief The bounding box of the region (inclusive, like bengine::clickRectangle)
+                Uint16 x1, y1, x2, y2;
+                /// @brief The radius of a circular region (its center is the middle of the bounding box)
+                Uint16 radius;
+            };
+
+            /// @brief Every registered region
+            std::vector<region> regions = {};
+            /// @brief The order given to the next region that is placed
+            Uint32 nextOrder = 0;
+
+            /// @brief The width of the area covered by the buckets (px); points outside of it never hit anything
+            Uint16 width = 0;
+            /// @brief The height of the area covered by the buckets (px)
+            Uint16 height = 0;
+            /// @brief The log2 of the side length of each bucket (px)
+            unsigned char cellShift = 6;
+            /// @brief The amount of bucket columns
+            Uint16 cols = 0;
+            /// @brief The amount of bucket rows
+            Uint16 rows = 0;
+            /// @brief Where each bucket's entries start within entries (one extra at the end so that a bucket ends where the next one starts)
+            std::vector<Uint32> cellStart = {};
+            /// @brief The indices into regions of every bucket's regions, each bucket sorted from the top down
+            std::vector<Uint32> entries = {};
+            /// @brief Whether the buckets need rebuilding before the next lookup
+            bool dirty = true;
+
+            /** Check whether a point is inside of a region's actual shape
+             * @param area The region
+             * @param x The x-position of the point
+             * @param y The y-position of the point
+             * @returns Whether the point is inside of the region
+             */
+            static bool contains(const region &area, const Uint16 &x, const Uint16 &y) {
+                if (x < area.x1 || x > area.x2 || y < area.y1 || y > area.y2) {
+                    return false;
+                }
+                if (area.shape == HITSHAPE_CIRCLE) {
+                    const int dx = (int)x - ((int)area.x2 - area.radius);
+                    const int dy = (int)y - ((int)area.y2 - area.radius);
+                    return dx * dx + dy * dy <= (int)area.radius * area.radius;
+                }
+                return true;
+            }
+            /** Find a region by its id
+             * @param id The id of the region
+             * @returns The index of the region within regions, or regions.size() if there is none
+             */
+            std::size_t find(const Uint32 &id) const {
+                for (std::size_t i = 0; i < this->regions.size(); i++) {
+                    if (this->regions[i].id == id) {
+                        return i;
+                    }
+                }
+                return this->regions.size();
+            }
+            /** Add a region, or replace the one with the same id
+             * @param area The region (its order is filled in here)
+             */
+            void place(region area) {
+                area.order = this->nextOrder++;
+                const std::size_t index = this->find(area.id);
+                if (index < this->regions.size()) {
+                    this->regions[index] = area;
+                } else {
+                    this->regions.push_back(area);
+                }
+                this->dirty = true;
+            }
+
+        public:
+            /** bengine::hitIndex constructor
+             * @param width The width of the area to cover (px); usually the window's base width
+             * @param height The height of the area to cover (px); usually the window's base height
+             * @param cellShift The log2 of the side length of each bucket (px); smaller buckets hold fewer regions each but take more memory
+             */
+            hitIndex(const Uint16 &width = 1920, const Uint16 &height = 1080, const unsigned char &cellShift = 6) : width(width), height(height), cellShift(cellShift > 15 ? 15 : cellShift) {}
+            /// @brief bengine::hitIndex deconstructor
+            ~hitIndex() {}
+
+            /** Add a rectangular region (or move the region with the same id)
+             * @param id The id that lookups will return for the region; UINT32_MAX is reserved for misses
+             * @param area The area of the region
+             * @param z The stacking order of the region; higher is on top, and the most recently placed region wins ties
+             */
+            void add(const Uint32 &id, const bengine::clickRectangle &area, const int &z = 0) {
+                this->place({id, z, 0, HITSHAPE_RECTANGLE, area.getX1(), area.getY1(), area.getX2(), area.getY2(), 0});
+            }
+            /** Add a circular region (or move the region with the same id)
+             * @param id The id that lookups will return for the region; UINT32_MAX is reserved for misses
+             * @param area The area of the region
+             * @param z The stacking order of the region; higher is on top, and the most recently placed region wins ties
+             */
+            void add(const Uint32 &id, const bengine::clickCircle &area, const int &z = 0) {
+                // The bounding box is clipped at the top-left of the screen, so the center is kept relative to its bottom-right corner
+                const Uint16 r = area.getRadius();
+                const Uint16 x1 = area.getX() < r ? 0 : area.getX() - r;
+                const Uint16 y1 = area.getY() < r ? 0 : area.getY() - r;
+                this->place({id, z, 0, HITSHAPE_CIRCLE, x1, y1, (Uint16)(area.getX() + r), (Uint16)(area.getY() + r), r});
+            }
+            /** Remove a region
+             * @param id The id of the region
+             * @returns Whether there was a region with the id
+             */
+            bool remove(const Uint32 &id) {
+                const std::size_t index = this->find(id);
+                if (index >= this->regions.size()) {
+                    return false;
+                }
+                this->regions.erase(this->regions.begin() + index);
+                this->dirty = true;
+                return true;
+            }
+            /// @brief Remove every region
+            void clear() {
+                this->regions.clear();
+                this->dirty = true;
+            }
+            /** Change the area covered by the buckets (e.g. when the base size of the window changes)
+             * @param width The width of the area to cover (px)
+             * @param height The height of the area to cover (px)
+             */
+            void resize(const Uint16 &width, const Uint16 &height) {
+                this->width = width;
+                this->height = height;
+                this->dirty = true;
+            }
+
+            /// @brief Rebuild the buckets from the registered regions; done automatically by the first lookup after the layout changes
+            void rebuild() {
+                this->dirty = false;
+                this->cols = ((Uint32)this->width + (1 << this->cellShift) - 1) >> this->cellShift;
+                this->rows = ((Uint32)this->height + (1 << this->cellShift) - 1) >> this->cellShift;
+                this->cellStart.assign((std::size_t)this->cols * this->rows + 1, 0);
+                this->entries.clear();
+                if (this->cols == 0 || this->rows == 0) {
+                    return;
+                }
+
+                // Sort from the top down once so that every bucket comes out sorted as well
+                std::vector<Uint32> order(this->regions.size());
+                for (std::size_t i = 0; i < order.size(); i++) {
+                    order[i] = i;
+                }
+                std::sort(order.begin(), order.end(), [this](const Uint32 &a, const Uint32 &b) {
+                    const region &ra = this->regions[a];
+                    const region &rb = this->regions[b];
+                    return ra.z != rb.z ? ra.z > rb.z : ra.order > rb.order;
+                });
+
+                // Count each bucket's regions, turn the counts into starting points, then fill the buckets
+                for (int pass = 0; pass < 2; pass++) {
+                    std::vector<Uint32> fill;
+                    if (pass == 1) {
+                        for (std::size_t i = 1; i < this->cellStart.size(); i++) {
+                            this->cellStart[i] += this->cellStart[i - 1];
+                        }
+                        this->entries.resize(this->cellStart.back());
+                        fill.assign(this->cellStart.begin(), this->cellStart.end() - 1);
+                    }
+                    for (std::size_t i = 0; i < order.size(); i++) {
+                        const region &area = this->regions[order[i]];
+                        if (area.x1 >= this->width || area.y1 >= this->height) {
+                            continue;
+                        }
+                        const Uint16 c1 = area.x1 >> this->cellShift;
+                        const Uint16 r1 = area.y1 >> this->cellShift;
+                        const Uint16 c2 = (area.x2 >= this->width ? this->width - 1 : area.x2) >> this->cellShift;
+                        const Uint16 r2 = (area.y2 >= this->height ? this->height - 1 : area.y2) >> this->cellShift;
+                        for (Uint16 r = r1; r <= r2; r++) {
+                            for (Uint16 c = c1; c <= c2; c++) {
+                                if (pass == 0) {
+                                    this->cellStart[(std::size_t)r * this->cols + c + 1]++;
+                                } else {
+                                    this->entries[fill[(std::size_t)r * this->cols + c]++] = order[i];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            /** Find the topmost region at a point
+             * @param x The x-position of the point
+             * @param y The y-position of the point
+             * @returns The id of the topmost region at the point; UINT32_MAX if there is none
+             */
+            Uint32 query(const Uint16 &x, const Uint16 &y) {
+                if (this->dirty) {
+                    this->rebuild();
+                }
+                if (x >= this->width || y >= this->height) {
+                    return UINT32_MAX;
+                }
+                const std::size_t cell = (std::size_t)(y >> this->cellShift) * this->cols + (x >> this->cellShift);
+                for (Uint32 i = this->cellStart[cell]; i < this->cellStart[cell + 1]; i++) {
+                    if (bengine::hitIndex::contains(this->regions[this->entries[i]], x, y)) {
+                        return this->regions[this->entries[i]].id;
+                    }
+                }
+                return UINT32_MAX;
+            }
+            /** Find every region at a point
+             * @param x The x-position of the point
+             * @param y The y-position of the point
+             * @param output Filled with the ids of every region at the point, from the top down (cleared first)
+             * @returns The amount of regions at the point
+             */
+            std::size_t queryAll(const Uint16 &x, const Uint16 &y, std::vector<Uint32> &output) {
+                output.clear();
+                if (this->dirty) {
+                    this->rebuild();
+                }
+                if (x >= this->width || y >= this->height) {
+                    return 0;
+                }
+                const std::size_t cell = (std::size_t)(y >> this->cellShift) * this->cols + (x >> this->cellShift);
+                for (Uint32 i = this->cellStart[cell]; i < this->cellStart[cell + 1]; i++) {
+                    if (bengine::hitIndex::contains(this->regions[this->entries[i]], x, y)) {
+                        output.push_back(this->regions[this->entries[i]].id);
+                    }
+                }
+                return output.size();
+            }
+            /** Find the topmost region that the mouse is over
+             * @param mouseState The mouse's state
+             * @returns The id of the topmost region under the mouse; UINT32_MAX if there is none
+             */
+            Uint32 checkPos(const normalMouseState &mouseState) {
+                return this->query(mouseState.posx(), mouseState.posy());
+            }
+            /** Find the topmost region that the mouse is over and confirm that the mouse has clicked the correct button
+             * @param mouseState The mouse's state
+             * @param button Which buttons to check for (OR'd together from bengine::mouseButtonTitles)
+             * @returns The id of the topmost region under the mouse if the mouse has clicked the correct button; UINT32_MAX as a sentinal value otherwise
+             */
+            Uint32 checkButton(const normalMouseState &mouseState, const Uint8 &button) {
+                return mouseState.pressed(button) ? this->checkPos(mouseState) : UINT32_MAX;
+            }
+
+            /** Get the amount of registered regions
+             * @returns The amount of registered regions
+             */
+            std::size_t size() const {
+                return this->regions.size();
+            }
+    };
 }
 
 #endif // BENGINE_MOUSE_hpp
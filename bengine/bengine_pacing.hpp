@@ -0,0 +1,188 @@
+#ifndef BENGINE_PACING_hpp
+#define BENGINE_PACING_hpp
+
+#include <SDL2/SDL.h>
+
+#include "bengine_window.hpp"
+
+namespace bengine {
+    typedef enum {
+        PACING_VSYNC = 0,       // Let presenting wait for the display's vertical blank
+        PACING_ADAPTIVE = 1,    // Use vsync while frames keep up with the display, and stop waiting for it while they don't (so a slow frame tears instead of halving the frame rate)
+        PACING_SLEEP = 2        // Sleep for most of the remaining frame time and then spin until the deadline; works at any target rate
+    } framePacingModes;
+
+    /** Keeps a loop's frames evenly spaced
+     *
+     * Only the performance counter is read each frame; the display's refresh rate comes from the window's cached display information.
+     * Frames that are not presented (nothing changed) cannot wait on vsync, so they are always paced by sleeping
+     */
+    class framePacer {
+        private:
+            /// @brief How frames are paced (one of bengine::framePacingModes)
+            unsigned char mode = bengine::PACING_SLEEP;
+            /// @brief The wanted frames per second; 0 follows the display's refresh rate
+            double targetRate = 0;
+            /// @brief How long before the deadline to stop sleeping and start spinning (ms); covers the scheduler's wake-up jitter
+            double spinMargin = 2;
+
+            /// @brief Counts per second of SDL's performance counter
+            Uint64 frequency = SDL_GetPerformanceFrequency();
+            /// @brief When the current frame is due to end (performance counter)
+            Uint64 deadline = 0;
+            /// @brief When the last frame ended (performance counter)
+            Uint64 lastEnd = 0;
+            /// @brief How long the last frame took, including waiting (ms)
+            double lastFrame = 0;
+            /// @brief A running average of how long frames take, including waiting (ms)
+            double averageFrame = 0;
+            /// @brief The amount of frames in a row that missed their deadline by more than lateTolerance (used by PACING_ADAPTIVE)
+            unsigned char lateFrames = 0;
+            /// @brief The amount of frames in a row that finished at least lateTolerance before their deadline (used by PACING_ADAPTIVE)
+            unsigned char earlyFrames = 0;
+            /// @brief How far past its deadline a frame can end before it counts as late (fraction of a frame); absorbs the display's vblank jitter
+            static constexpr double lateTolerance = 0.25;
+            /// @brief How many late frames in a row turn vsync off (PACING_ADAPTIVE)
+            static const unsigned char lateLimit = 3;
+            /// @brief How many early frames in a row turn vsync back on (PACING_ADAPTIVE); much larger than lateLimit so that a borderline load settles instead of flapping
+            static const unsigned char earlyLimit = 60;
+
+        public:
+            /** bengine::framePacer constructor
+             * @param mode How frames are paced (one of bengine::framePacingModes)
+             * @param targetRate The wanted frames per second; 0 follows the display's refresh rate
+             */
+            framePacer(const unsigned char &mode = bengine::PACING_SLEEP, const double &targetRate = 0) : mode(mode > bengine::PACING_SLEEP ? bengine::PACING_SLEEP : mode), targetRate(targetRate < 0 ? 0 : targetRate) {}
+
+            /** Get the length of a frame at the current target
+             * @param window The window being paced (for its refresh rate)
+             * @returns The length of a frame (performance counter ticks)
+             */
+            Uint64 frameLength(const bengine::window &window) const {
+                const double rate = this->targetRate > 0 ? this->targetRate : window.refreshRate();
+                return (Uint64)(this->frequency / rate);
+            }
+
+            /** Turn the window's vsync on or off to match the pacing mode; call whenever the mode changes
+             *
+             * If the renderer cannot turn vsync on (e.g. SDL is older than 2.0.18), the pacer falls back to PACING_SLEEP
+             * @param window The window being paced
+             */
+            void apply(bengine::window &window) {
+                if (!window.setVSync(this->mode != bengine::PACING_SLEEP)) {
+                    this->mode = bengine::PACING_SLEEP;
+                }
+                this->lateFrames = 0;
+                this->earlyFrames = 0;
+            }
+
+            /** Wait until the current frame should end, then start the next one
+             * @param window The window being paced
+             * @param presented Whether the frame was presented (only presented frames can be paced by vsync)
+             */
+            void endFrame(bengine::window &window, const bool &presented) {
+                const Uint64 length = this->frameLength(window);
+                Uint64 now = SDL_GetPerformanceCounter();
+                if (this->deadline == 0) {
+                    this->deadline = now;
+                }
+                this->deadline += length;
+
+                if (this->mode == bengine::PACING_ADAPTIVE && presented) {
+                    // Give up on vsync after a few clearly late frames, and only go back to it once frames have fit with room to spare for a while
+                    const Uint64 tolerance = (Uint64)(length * bengine::framePacer::lateTolerance);
+                    this->lateFrames = now > this->deadline + tolerance ? (this->lateFrames < 255 ? this->lateFrames + 1 : 255) : 0;
+                    this->earlyFrames = now + tolerance <= this->deadline ? (this->earlyFrames < 255 ? this->earlyFrames + 1 : 255) : 0;
+                    if (window.hasVSync() && this->lateFrames >= bengine::framePacer::lateLimit) {
+                        window.setVSync(false);
+                        this->earlyFrames = 0;
+                    } else if (!window.hasVSync() && this->earlyFrames >= bengine::framePacer::earlyLimit) {
+                        if (!window.setVSync(true)) {
+                            this->mode = bengine::PACING_SLEEP;
+                        }
+                        this->lateFrames = 0;
+                    }
+                }
+
+                if (presented && window.hasVSync()) {
+                    // Presenting already waited for the display
+                    this->deadline = now;
+                } else if (now >= this->deadline) {
+                    // Too far behind to catch up; start over from now rather than rushing the next frames
+                    this->deadline = now;
+                } else {
+                    const double remaining = (this->deadline - now) * 1000.0 / this->frequency;
+                    if (remaining > this->spinMargin) {
+                        SDL_Delay((Uint32)(remaining - this->spinMargin));
+                    }
+                    while ((now = SDL_GetPerformanceCounter()) < this->deadline) {}
+                }
+
+                if (this->lastEnd != 0) {
+                    this->lastFrame = (now - this->lastEnd) * 1000.0 / this->frequency;
+                    this->averageFrame = this->averageFrame == 0 ? this->lastFrame : this->averageFrame * 0.95 + this->lastFrame * 0.05;
+                }
+                this->lastEnd = now;
+            }
+
+            /** Get how frames are paced
+             * @returns One of bengine::framePacingModes
+             */
+            unsigned char getMode() const {
+                return this->mode;
+            }
+            /** Set how frames are paced (apply() has to be called afterwards)
+             * @param mode One of bengine::framePacingModes
+             * @returns The old pacing mode
+             */
+            unsigned char setMode(const unsigned char &mode) {
+                const unsigned char output = this->mode;
+                this->mode = mode > bengine::PACING_SLEEP ? bengine::PACING_SLEEP : mode;
+                return output;
+            }
+            /** Get the wanted frames per second
+             * @returns The wanted frames per second (0 follows the display's refresh rate)
+             */
+            double getTargetRate() const {
+                return this->targetRate;
+            }
+            /** Set the wanted frames per second (vsync modes can only slow down to it, not speed up past the display)
+             * @param targetRate The new frames per second (0 follows the display's refresh rate)
+             * @returns The old frames per second
+             */
+            double setTargetRate(const double &targetRate) {
+                const double output = this->targetRate;
+                this->targetRate = targetRate < 0 ? 0 : targetRate;
+                return output;
+            }
+            /** Get how long before a deadline sleeping stops and spinning starts
+             * @returns The spin margin (ms)
+             */
+            double getSpinMargin() const {
+                return this->spinMargin;
+            }
+            /** Set how long before a deadline sleeping stops and spinning starts (larger is steadier but burns more CPU)
+             * @param spinMargin The new spin margin (ms)
+             * @returns The old spin margin (ms)
+             */
+            double setSpinMargin(const double &spinMargin) {
+                const double output = this->spinMargin;
+                this->spinMargin = spinMargin < 0 ? 0 : spinMargin;
+                return output;
+            }
+            /** Get how long the last frame took, including waiting
+             * @returns The length of the last frame (ms)
+             */
+            double getLastFrame() const {
+                return this->lastFrame;
+            }
+            /** Get a running average of how long frames take, including waiting
+             * @returns The average length of a frame (ms)
+             */
+            double getAverageFrame() const {
+                return this->averageFrame;
+            }
+    };
+}
+
+#endif // BENGINE_PACING_hpp
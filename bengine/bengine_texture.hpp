@@ -3,51 +3,214 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace bengine {
+    /// @brief Shared ownership of an SDL_Texture; the texture is destroyed once the last handle to it goes away
+    typedef std::shared_ptr<SDL_Texture> textureHandle;
+
+    /// @brief Totals kept by a bengine::textureCache for every texture it has handed out
+    struct textureStats {
+        /// @brief The amount of textures currently alive
+        std::size_t liveTextures = 0;
+        /// @brief The (estimated) amount of GPU memory used by the textures currently alive, in bytes
+        std::size_t liveBytes = 0;
+        /// @brief The most GPU memory used at once, in bytes
+        std::size_t peakBytes = 0;
+        /// @brief The amount of textures created (or adopted) so far
+        std::size_t created = 0;
+        /// @brief The amount of textures destroyed so far
+        std::size_t destroyed = 0;
+        /// @brief The amount of loads answered with an already-loaded texture
+        std::size_t cacheHits = 0;
+    };
+
+    /** Hands out reference-counted textures and keeps track of how much GPU memory they use
+     *
+     * Images loaded from a path are shared: loading a path that is still alive somewhere returns the same texture. Anything else (render targets, text) can be adopted so that its memory is counted too
+     */
+    class textureCache {
+        private:
+            /// @brief The renderer textures are created with
+            SDL_Renderer *renderer = nullptr;
+            /// @brief The totals; shared with every handle's deleter so that handles outliving the cache stay safe
+            std::shared_ptr<bengine::textureStats> stats = std::make_shared<bengine::textureStats>();
+            /// @brief Textures loaded from files, by path (entries expire with the last handle)
+            std::unordered_map<std::string, std::weak_ptr<SDL_Texture>> loaded = {};
+
+        public:
+            /** bengine::textureCache constructor
+             * @param renderer The renderer to create textures with
+             */
+            textureCache(SDL_Renderer *renderer = nullptr) : renderer(renderer) {}
+
+            /** Set the renderer that textures are created with
+             * @param renderer The new renderer
+             * @returns The old renderer
+             */
+            SDL_Renderer *setRenderer(SDL_Renderer *renderer) {
+                SDL_Renderer *output = this->renderer;
+                this->renderer = renderer;
+                return output;
+            }
+
+            /** Estimate the GPU memory taken by a texture
+             * @param texture The texture
+             * @returns The width times the height times the bytes per pixel of the texture
+             */
+            static std::size_t textureBytes(SDL_Texture *texture) {
+                Uint32 format;
+                int w, h;
+                if (texture == nullptr || SDL_QueryTexture(texture, &format, NULL, &w, &h) != 0) {
+                    return 0;
+                }
+                const std::size_t pixelBytes = SDL_ISPIXELFORMAT_FOURCC(format) ? 4 : SDL_BYTESPERPIXEL(format);
+                return (std::size_t)w * h * pixelBytes;
+            }
+
+            /** Take ownership of a texture
+             * @param texture The texture (destroyed once the last handle goes away)
+             * @returns A handle to the texture (empty if texture is NULL)
+             */
+            bengine::textureHandle adopt(SDL_Texture *texture) {
+                if (texture == nullptr) {
+                    return nullptr;
+                }
+                const std::size_t bytes = bengine::textureCache::textureBytes(texture);
+                this->stats->liveTextures++;
+                this->stats->liveBytes += bytes;
+                this->stats->peakBytes = this->stats->liveBytes > this->stats->peakBytes ? this->stats->liveBytes : this->stats->peakBytes;
+                this->stats->created++;
+
+                const std::shared_ptr<bengine::textureStats> counters = this->stats;
+                return bengine::textureHandle(texture, [counters, bytes](SDL_Texture *texture) {
+                    SDL_DestroyTexture(texture);
+                    counters->liveTextures--;
+                    counters->liveBytes -= bytes;
+                    counters->destroyed++;
+                });
+            }
+            /** Find an image that is already loaded
+             * @param path The path of the image
+             * @returns A handle to the image's texture (empty if it is not loaded)
+             */
+            bengine::textureHandle find(const std::string &path) {
+                std::unordered_map<std::string, std::weak_ptr<SDL_Texture>>::iterator found = this->loaded.find(path);
+                if (found == this->loaded.end()) {
+                    return nullptr;
+                }
+                bengine::textureHandle output = found->second.lock();
+                if (output != nullptr) {
+                    this->stats->cacheHits++;
+                }
+                return output;
+            }
+            /** Take ownership of a texture made from an image so that later loads of the same path share it
+             * @param path The path of the image
+             * @param texture The texture (destroyed once the last handle goes away)
+             * @returns A handle to the texture (empty if texture is NULL)
+             */
+            bengine::textureHandle insert(const std::string &path, SDL_Texture *texture) {
+                bengine::textureHandle output = this->adopt(texture);
+                if (output != nullptr) {
+                    this->loaded[path] = output;
+                }
+                return output;
+            }
+            /** Load an image, sharing the texture with anything else that loaded the same path
+             * @param path The path of the image
+             * @returns A handle to the texture (empty if the image could not be loaded)
+             */
+            bengine::textureHandle load(const std::string &path) {
+                bengine::textureHandle output = this->find(path);
+                if (output != nullptr) {
+                    return output;
+                }
+                return this->insert(path, IMG_LoadTexture(this->renderer, path.c_str()));
+            }
+            /** Upload an already-decoded image, sharing the texture with anything else that loads the same path
+             * @param path The path the image was decoded from
+             * @param surface The decoded image (still owned by the caller)
+             * @returns A handle to the texture (empty if it could not be created)
+             */
+            bengine::textureHandle upload(const std::string &path, SDL_Surface *surface) {
+                bengine::textureHandle output = this->find(path);
+                if (output != nullptr) {
+                    return output;
+                }
+                return this->insert(path, SDL_CreateTextureFromSurface(this->renderer, surface));
+            }
+            /** Create a blank texture
+             * @param format The SDL_PixelFormatEnum of the texture
+             * @param access The SDL_TextureAccess of the texture
+             * @param width The width of the texture (px)
+             * @param height The height of the texture (px)
+             * @returns A handle to the texture (empty if it could not be created)
+             */
+            bengine::textureHandle create(const Uint32 &format, const int &access, const int &width, const int &height) {
+                return this->adopt(SDL_CreateTexture(this->renderer, format, access, width, height));
+            }
+            /// @brief Forget the paths whose textures have already been destroyed
+            void prune() {
+                for (std::unordered_map<std::string, std::weak_ptr<SDL_Texture>>::iterator i = this->loaded.begin(); i != this->loaded.end();) {
+                    i = i->second.expired() ? this->loaded.erase(i) : std::next(i);
+                }
+            }
+
+            /** Get the totals for every texture handed out
+             * @returns The totals for every texture handed out
+             */
+            const bengine::textureStats &getStats() const {
+                return *this->stats;
+            }
+    };
+
     /// @brief A wrapper class for the SDL_Texture that pretty much just contains the source texture and frame
     class basicTexture {
         protected:
-            /// @brief The source texture to use
-            SDL_Texture *source = nullptr;
+            /// @brief The source texture to use (shared with every copy of this texture)
+            bengine::textureHandle source = nullptr;
             /// @brief The portion of the source texture to actually display
             SDL_Rect frame = {};
 
         public:
             /** bengine::basicTexture constructor
-             * @param texture The SDL_Texture to use as a source
+             * @param texture The texture to use as a source
              * @param frame The portion of the source texture to actually display
              */
-            basicTexture(SDL_Texture *texture = NULL, const SDL_Rect &frame = {}) {
+            basicTexture(const bengine::textureHandle &texture = nullptr, const SDL_Rect &frame = {}) {
                 bengine::basicTexture::setTexture(texture);
                 bengine::basicTexture::setFrame(frame);
             }
-            /// @brief bengine::basicTexture deconstructor; pretty much just handles some SDL cleanup
-            ~basicTexture() {
-                SDL_DestroyTexture(this->source);
-                this->source = nullptr;
-            }
 
             /** Assignment operator overload
              * @param rhs The bengine::basicTexture to inherit from
              */
             void operator=(const bengine::basicTexture &rhs) {
-                bengine::basicTexture::setTexture(rhs.getTexture());
+                bengine::basicTexture::setTexture(rhs.getHandle());
                 bengine::basicTexture::setFrame(rhs.getFrame());
             }
 
             /** Get the source texture
-             * @returns The source SDL_Texture
+             * @returns The source SDL_Texture (owned by the handle; do not destroy it)
              */
             SDL_Texture *getTexture() const {
+                return this->source.get();
+            }
+            /** Get the handle to the source texture
+             * @returns The handle to the source texture
+             */
+            bengine::textureHandle getHandle() const {
                 return this->source;
             }
-            /** Set the source texture to a new one
+            /** Set the source texture to a new one; the old one is destroyed if nothing else holds it
              * @param texture The new texture
              * @returns The old texture
              */
-            SDL_Texture *setTexture(SDL_Texture *texture) {
-                SDL_Texture* output = this->source;
+            bengine::textureHandle setTexture(const bengine::textureHandle &texture) {
+                const bengine::textureHandle output = this->source;
                 this->source = texture;
                 return output;
             }
@@ -81,25 +244,21 @@ namespace bengine {
 
         public:
             /** bengine::moddedTexture constructor
-             * @param texture The SDL_Texture to use as a source
+             * @param texture The texture to use as a source
              * @param frame The portion of the source texture to actually display
              * @param colorMod The color modification for the texture
              */
-            moddedTexture(SDL_Texture *texture = nullptr, const SDL_Rect &frame = {}, const SDL_Color &colorMod = {255, 255, 255, 255}) {
+            moddedTexture(const bengine::textureHandle &texture = nullptr, const SDL_Rect &frame = {}, const SDL_Color &colorMod = {255, 255, 255, 255}) {
                 bengine::basicTexture::setTexture(texture);
                 bengine::basicTexture::setFrame(frame);
                 bengine::moddedTexture::setColorMod(colorMod);
             }
-            /// @brief bengine::moddedTexture deconstructor
-            ~moddedTexture() {
-                bengine::basicTexture::~basicTexture();
-            }
 
             /** Assignment operator overload
              * @param rhs The bengine::moddedTexture to inherit from
              */
             void operator=(const bengine::moddedTexture &rhs) {
-                bengine::basicTexture::setTexture(rhs.getTexture());
+                bengine::basicTexture::setTexture(rhs.getHandle());
                 bengine::basicTexture::setFrame(rhs.getFrame());
                 bengine::moddedTexture::setColorMod(rhs.getColorMod());
                 bengine::moddedTexture::setBlendMode(rhs.getBlendMode());
@@ -116,7 +275,7 @@ namespace bengine {
              * @returns The old SDL_BlendMode that was used on this texture
              */
             SDL_BlendMode setBlendMode(const SDL_BlendMode &blendMode) {
-                SDL_SetTextureBlendMode(this->source, blendMode);
+                SDL_SetTextureBlendMode(this->source.get(), blendMode);
 
                 const SDL_BlendMode output = this->blendMode;
                 this->blendMode = blendMode;
@@ -134,8 +293,8 @@ namespace bengine {
              * @returns The old color that was used on this texture
              */
             SDL_Color setColorMod(const SDL_Color &colorMod) {
-                SDL_SetTextureColorMod(this->source, colorMod.r, colorMod.g, colorMod.b);
-                SDL_SetTextureAlphaMod(this->source, colorMod.a);
+                SDL_SetTextureColorMod(this->source.get(), colorMod.r, colorMod.g, colorMod.b);
+                SDL_SetTextureAlphaMod(this->source.get(), colorMod.a);
 
                 const SDL_Color output = this->colorMod;
                 this->colorMod.r = colorMod.r;
@@ -156,7 +315,7 @@ namespace bengine {
              * @returns The old "amount of red" that was present in the texture
              */
             Uint8 setRedMod(const Uint8 &redMod) {
-                SDL_SetTextureColorMod(this->source, redMod, this->colorMod.g, this->colorMod.b);
+                SDL_SetTextureColorMod(this->source.get(), redMod, this->colorMod.g, this->colorMod.b);
 
                 const Uint8 output = this->colorMod.r;
                 this->colorMod.r = redMod;
@@ -174,7 +333,7 @@ namespace bengine {
              * @returns The old "amount of green" that was present in the texture
              */
             Uint8 setGreenMod(const Uint8 &greenMod) {
-                SDL_SetTextureColorMod(this->source, this->colorMod.r, greenMod, this->colorMod.b);
+                SDL_SetTextureColorMod(this->source.get(), this->colorMod.r, greenMod, this->colorMod.b);
                 
                 const Uint8 output = this->colorMod.g;
                 this->colorMod.g = greenMod;
@@ -192,7 +351,7 @@ namespace bengine {
              * @returns The old "amount of blue" that was present in the texture
              */
             Uint8 setBlueMod(const Uint8 &blueMod) {
-                SDL_SetTextureColorMod(this->source, this->colorMod.r, this->colorMod.g, blueMod);
+                SDL_SetTextureColorMod(this->source.get(), this->colorMod.r, this->colorMod.g, blueMod);
                 
                 const Uint8 output = this->colorMod.b;
                 this->colorMod.b = blueMod;
@@ -210,7 +369,7 @@ namespace bengine {
              * @returns The old opacity of the texture
              */
             Uint8 setAlphaMod(const Uint8 &alphaMod) {
-                SDL_SetTextureAlphaMod(this->source, alphaMod);
+                SDL_SetTextureAlphaMod(this->source.get(), alphaMod);
                 
                 const Uint8 output = this->colorMod.a;
                 this->colorMod.a = alphaMod;
@@ -230,29 +389,25 @@ namespace bengine {
 
         public:
             /** bengine::shiftingTexture constructor
-             * @param texture The SDL_Texture to use as a source
+             * @param texture The texture to use as a source
              * @param frame The portion of the source texture to actually display
              * @param pivot The point for the texture to be rotated about relative to the source frame's top-left corner
              * @param angle The angle for the texture to be rotated at
              * @param colorMod The color modification for the texture
              */
-            shiftingTexture(SDL_Texture *texture = NULL, const SDL_Rect &frame = {}, const SDL_Point &pivot = {}, const double &angle = 0, const SDL_Color &colorMod = {255, 255, 255, 255}) {
+            shiftingTexture(const bengine::textureHandle &texture = nullptr, const SDL_Rect &frame = {}, const SDL_Point &pivot = {}, const double &angle = 0, const SDL_Color &colorMod = {255, 255, 255, 255}) {
                 bengine::basicTexture::setTexture(texture);
                 bengine::basicTexture::setFrame(frame);
                 bengine::moddedTexture::setColorMod(colorMod);
                 bengine::shiftingTexture::setPivot(pivot);
                 bengine::shiftingTexture::setAngle(angle);
             }
-            /// @brief bengine::shiftingTexture deconstructor
-            ~shiftingTexture() {
-                bengine::moddedTexture::~moddedTexture();
-            }
 
             /** Assignment operator overload
              * @param rhs The bengine::shiftingTexture to inherit from
              */
             void operator=(const bengine::shiftingTexture &rhs) {
-                bengine::basicTexture::setTexture(rhs.getTexture());
+                bengine::basicTexture::setTexture(rhs.getHandle());
                 bengine::basicTexture::setFrame(rhs.getFrame());
                 bengine::moddedTexture::setColorMod(rhs.getColorMod());
                 bengine::moddedTexture::setBlendMode(rhs.getBlendMode());
@@ -5,6 +5,8 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 #include "bengine_texture.hpp"
 #include "btils_main.hpp"
@@ -77,6 +79,13 @@ namespace bengine {
             /// @brief Whether the window is fullscreen or not
             bool isFullscreen = false;
 
+            /// @brief The index of the display that the window is on (cached; see updateDisplay())
+            int displayIndex = 0;
+            /// @brief The current mode of the display that the window is on (cached; see updateDisplay())
+            SDL_DisplayMode displayMode = {};
+            /// @brief Whether presenting waits for the display's vertical blank
+            bool vsync = false;
+
             /// @brief Whether to lock the aspect ratio of the window for resizing (WIP)
             bool lockRatio = true;
             /// @brief Smallest possible width for the window (px)
@@ -91,13 +100,55 @@ namespace bengine {
             /// @brief The base height of the window that will be used to determine the amount of vertical stretching that will happen
             Uint16 baseHeight;
 
-            /// @brief The SDL_Texture that is used whenever the window's dummy texture is initialized and drawn to
-            SDL_Texture *dummyTexture = NULL;
+            /// @brief Every texture created through the window; shares loaded images and tracks GPU memory
+            bengine::textureCache textures;
+            /// @brief The texture that is used whenever the window's dummy texture is initialized and drawn to
+            bengine::textureHandle dummyTexture = nullptr;
             /// @brief The SDL_PixelFormat that the window's dummy texture will use
             SDL_PixelFormat pixelFormat;
             /// @brief Whether the renderer is targeting the window (false) or the dummy texture
             bool renderTarget = RENDERTARGET_WINDOW;
 
+            /// @brief A texture draw recorded into the window's command list
+            struct drawCommand {
+                /// @brief The texture to draw (held so that it outlives the list)
+                bengine::textureHandle texture;
+                /// @brief The portion of the texture to draw (px)
+                SDL_Rect src;
+                /// @brief Where to draw it, before stretching (px)
+                SDL_Rect dst;
+                SDL_BlendMode blendMode;
+                /// @brief The color modification, applied through the vertex colors so that it never splits a batch
+                SDL_Color colorMod;
+                /// @brief The earliest layer the draw can be moved to without changing how it overlaps anything recorded before it
+                std::size_t layer;
+            };
+            /// @brief A run of sorted commands that share a texture and blend mode, submitted with one call
+            struct drawBatch {
+                SDL_Texture *texture;
+                SDL_BlendMode blendMode;
+                /// @brief Where the batch's indices start within commandIndices
+                int firstIndex;
+                /// @brief The amount of indices in the batch (6 per quad)
+                int indexCount;
+            };
+            /// @brief Every draw recorded since clearCommands(), in recording order
+            std::vector<drawCommand> commands = {};
+            /// @brief The recorded draws in submission order (sorted into layers, then by texture and blend mode, keeping recording order otherwise)
+            std::vector<std::size_t> commandOrder = {};
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+            /// @brief The corners of every recorded quad, in submission order and already stretched (SDL_RenderGeometry needs SDL 2.0.18)
+            std::vector<SDL_Vertex> commandVertices = {};
+#endif
+            /// @brief Two triangles per recorded quad
+            std::vector<int> commandIndices = {};
+            /// @brief The batches that the sorted commands merge into
+            std::vector<drawBatch> commandBatches = {};
+            /// @brief Whether the batches need building again (anything was recorded or cleared)
+            bool commandsDirty = true;
+            /// @brief The width, height, base width, base height, and stretching that the batches were built for; a change to any of them rebuilds the batches from the same commands
+            int commandScale[5] = {};
+
             /** Pretty much does the same thing as SDL_SetRenderDrawColor, but will also print an error if something goes wrong
              * @param color The SDL_Color to change the renderer's color to
              * @returns 0 on success or a negative error code on failure
@@ -110,6 +161,113 @@ namespace bengine {
                 }
                 return output;
             }
+            /** Apply a texture's color modification and blend mode to its source right before it is drawn, since loaded sources are shared between textures
+             * @param texture The bengine::moddedTexture about to be rendered
+             */
+            void applyMods(const bengine::moddedTexture &texture) {
+                const SDL_Color colorMod = texture.getColorMod();
+                SDL_SetTextureColorMod(texture.getTexture(), colorMod.r, colorMod.g, colorMod.b);
+                SDL_SetTextureAlphaMod(texture.getTexture(), colorMod.a);
+                SDL_SetTextureBlendMode(texture.getTexture(), texture.getBlendMode());
+            }
+            /** Put a texture's color modification and blend mode back to neutral right before it is drawn plainly, since a shared source keeps whatever tint the last modded draw gave it
+             * @param texture The SDL_Texture about to be rendered
+             */
+            void clearMods(SDL_Texture *texture) {
+                SDL_SetTextureColorMod(texture, 255, 255, 255);
+                SDL_SetTextureAlphaMod(texture, 255);
+                SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            }
+            /** Add a draw to the command list, working out which layer it can be sorted into
+             * 
+             * A draw has to stay after every earlier draw it overlaps that needs a different texture or blend mode, so its layer is one past theirs; overlapping draws with the same state can share a layer, as their recording order is kept within it
+             * @param texture The texture to draw
+             * @param src The portion of the texture to draw (px)
+             * @param dst Where to draw it, before stretching (px)
+             * @param blendMode The blend mode to draw with
+             * @param colorMod The color modification to draw with
+             * @returns Whether anything was recorded
+             */
+            bool recordCommand(const bengine::textureHandle &texture, const SDL_Rect &src, const SDL_Rect &dst, const SDL_BlendMode &blendMode, const SDL_Color &colorMod) {
+                if (texture == nullptr || dst.w <= 0 || dst.h <= 0) {
+                    return false;
+                }
+                std::size_t layer = 0;
+                for (std::size_t i = 0; i < this->commands.size(); i++) {
+                    const drawCommand &earlier = this->commands[i];
+                    if (earlier.layer + 1 <= layer || !SDL_HasIntersection(&earlier.dst, &dst)) {
+                        continue;
+                    }
+                    const std::size_t needed = earlier.layer + (earlier.texture == texture && earlier.blendMode == blendMode ? 0 : 1);
+                    layer = needed > layer ? needed : layer;
+                }
+                this->commands.push_back({texture, src, dst, blendMode, colorMod, layer});
+                this->commandsDirty = true;
+                return true;
+            }
+            /// @brief Sort the recorded commands and merge them into batches of quads
+            void buildCommandBatches() {
+                this->commandsDirty = false;
+                this->commandOrder.resize(this->commands.size());
+                for (std::size_t i = 0; i < this->commandOrder.size(); i++) {
+                    this->commandOrder[i] = i;
+                }
+                // A stable sort keeps recording order between draws that tie, which is what keeps overlapping draws with the same state in order
+                std::stable_sort(this->commandOrder.begin(), this->commandOrder.end(), [this](const std::size_t &a, const std::size_t &b) {
+                    const drawCommand &ca = this->commands[a];
+                    const drawCommand &cb = this->commands[b];
+                    if (ca.layer != cb.layer) {
+                        return ca.layer < cb.layer;
+                    }
+                    if (ca.texture != cb.texture) {
+                        return ca.texture.get() < cb.texture.get();
+                    }
+                    // Draws that only differ in color modification stay in recording order, since a later tinted draw may overlap an earlier one in the same layer
+                    return ca.blendMode < cb.blendMode;
+                });
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                this->commandVertices.resize(this->commands.size() * 4);
+                const float scaleX = this->stretchGraphics ? (float)this->width / this->baseWidth : 1;
+                const float scaleY = this->stretchGraphics ? (float)this->height / this->baseHeight : 1;
+                int textureW = 1, textureH = 1;
+#endif
+                this->commandIndices.resize(this->commands.size() * 6);
+                this->commandBatches.clear();
+                for (std::size_t i = 0; i < this->commandOrder.size(); i++) {
+                    const drawCommand &command = this->commands[this->commandOrder[i]];
+                    SDL_Texture *texture = command.texture.get();
+                    if (this->commandBatches.empty() || this->commandBatches.back().texture != texture || this->commandBatches.back().blendMode != command.blendMode) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                        if (this->commandBatches.empty() || this->commandBatches.back().texture != texture) {
+                            SDL_QueryTexture(texture, NULL, NULL, &textureW, &textureH);
+                        }
+#endif
+                        this->commandBatches.push_back({texture, command.blendMode, (int)i * 6, 0});
+                    }
+                    this->commandBatches.back().indexCount += 6;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                    const float x1 = command.dst.x * scaleX, y1 = command.dst.y * scaleY;
+                    const float x2 = (command.dst.x + command.dst.w) * scaleX, y2 = (command.dst.y + command.dst.h) * scaleY;
+                    const float u1 = (float)command.src.x / textureW, v1 = (float)command.src.y / textureH;
+                    const float u2 = (float)(command.src.x + command.src.w) / textureW, v2 = (float)(command.src.y + command.src.h) / textureH;
+                    SDL_Vertex *vertex = &this->commandVertices[i * 4];
+                    vertex[0] = {{x1, y1}, command.colorMod, {u1, v1}};
+                    vertex[1] = {{x2, y1}, command.colorMod, {u2, v1}};
+                    vertex[2] = {{x2, y2}, command.colorMod, {u2, v2}};
+                    vertex[3] = {{x1, y2}, command.colorMod, {u1, v2}};
+#endif
+                    int *index = &this->commandIndices[i * 6];
+                    const int first = i * 4;
+                    index[0] = first;
+                    index[1] = first + 1;
+                    index[2] = first + 2;
+                    index[3] = first;
+                    index[4] = first + 2;
+                    index[5] = first + 3;
+                }
+            }
             /// @brief Print the output of SDL_GetError with a timestamp and some extra formatting
             void printError() const {
                 std::cout << "\nERROR [" << SDL_GetTicks() << "]: " << SDL_GetError() << "\n";
@@ -138,6 +296,7 @@ namespace bengine {
              * @param flags SDL_WINDOW flags that modify how the window will behave as a Uint32 mask
              */
             window(const char* title = "window", const Uint16 &width = 1920, const Uint16 &height = 1080, const Uint32 &flags = SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE) {
+                this->title = title;
                 if ((this->win = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, flags)) == NULL) {
                     std::cout << "Window \"" << title << "\" failed to initialize";
                     bengine::window::printError();
@@ -146,6 +305,7 @@ namespace bengine {
                     std::cout << "Window \"" << title << "\" failed to initialize renderer";
                     bengine::window::printError();
                 }
+                this->textures.setRenderer(this->renderer);
 
                 this->width = width;
                 this->height = height;
@@ -158,30 +318,101 @@ namespace bengine {
                 this->ratioY = this->height / gcd;
 
                 this->setPixelFormat();
+                this->updateDisplay();
             }
             /// @brief bengine::window deconstructor
             ~window() {
-                SDL_DestroyRenderer(this->renderer);
-                SDL_DestroyWindow(this->win);
-                this->renderer = nullptr;
-                this->win = nullptr;
+                this->close();
             }
 
-            /** Get the refresh rate of the monitor that the window was created on
-             *@returns The refresh rate of the monitor that the window was created on
-             */ 
-            Uint16 refreshRate() const {
-                SDL_DisplayMode mode;
-                int displayIndex = SDL_GetWindowDisplayIndex(this->win);
-                if (displayIndex < 0) {
+            /** Destroy the renderer and the window along with every texture the window still holds; safe to call more than once
+             * 
+             * Textures die with their renderer, so the dummy texture and every texture kept alive by the recorded commands are released first. Anything owning the window should call this before SDL_Quit()
+             */
+            void close() {
+                this->clearCommands();
+                this->commandOrder.clear();
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                this->commandVertices.clear();
+#endif
+                this->commandIndices.clear();
+                this->commandBatches.clear();
+                this->dummyTexture = nullptr;
+                if (this->renderer != nullptr) {
+                    SDL_DestroyRenderer(this->renderer);
+                    this->renderer = nullptr;
+                    this->textures.setRenderer(nullptr);
+                }
+                if (this->win != nullptr) {
+                    SDL_DestroyWindow(this->win);
+                    this->win = nullptr;
+                }
+            }
+
+            /** Query which display the window is on and that display's current mode; done when the window is created and whenever it moves between displays
+             * @returns Whether the display information could be fetched (the previous information is kept otherwise)
+             */
+            bool updateDisplay() {
+                const int index = SDL_GetWindowDisplayIndex(this->win);
+                if (index < 0) {
                     std::cout << "Window \"" << this->title << "\" failed to fetch display index";
                     bengine::window::printError();
+                    return false;
                 }
-                if (SDL_GetDisplayMode(displayIndex, 0, &mode) != 0) {
+                SDL_DisplayMode mode;
+                if (SDL_GetCurrentDisplayMode(index, &mode) != 0) {
                     std::cout << "Window \"" << this->title << "\" failed to fetch display mode information";
                     bengine::window::printError();
+                    return false;
+                }
+                this->displayIndex = index;
+                this->displayMode = mode;
+                return true;
+            }
+            /** Get the refresh rate of the monitor that the window is on (cached, so cheap enough to call every frame)
+             *@returns The refresh rate of the monitor that the window is on (60 if the display does not report one)
+             */ 
+            Uint16 refreshRate() const {
+                return this->displayMode.refresh_rate > 0 ? (Uint16)this->displayMode.refresh_rate : 60;
+            }
+            /** Get the index of the display that the window is on
+             * @returns The index of the display that the window is on
+             */
+            int getDisplayIndex() const {
+                return this->displayIndex;
+            }
+            /** Get the current mode of the display that the window is on
+             * @returns The current SDL_DisplayMode of the display that the window is on
+             */
+            SDL_DisplayMode getDisplayMode() const {
+                return this->displayMode;
+            }
+            /** Check whether presenting waits for the display's vertical blank
+             * @returns Whether vsync is on
+             */
+            bool hasVSync() const {
+                return this->vsync;
+            }
+            /** Turn waiting for the display's vertical blank when presenting on or off (needs SDL 2.0.18 or newer)
+             * @param state Whether vsync should be on
+             * @returns Whether the renderer accepted the change; always false when turning vsync on with an older SDL
+             */
+            bool setVSync(const bool &state) {
+                if (state == this->vsync) {
+                    return true;
+                }
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                if (SDL_RenderSetVSync(this->renderer, state ? 1 : 0) != 0) {
+                    std::cout << "Window \"" << this->title << "\" failed to change vsync";
+                    bengine::window::printError();
+                    return false;
                 }
-                return (Uint16)mode.refresh_rate;
+                this->vsync = state;
+                return true;
+#else
+                std::cout << "Window \"" << this->title << "\" cannot change vsync (needs SDL 2.0.18 or newer)\n";
+                return false;
+#endif
             }
             /** Get the SDL_WINDOW flags currently associated with the window
              * @returns The SDL_WINDOW flags currently associated with the window as a Uint32 mask
@@ -385,7 +616,7 @@ namespace bengine {
              * @returns The base height of the window (px) that will be used to determine the amount of vertical stretching that will happen
              */
             Uint16 getBaseHeight() const {
-                return this->height;
+                return this->baseHeight;
             }
             /** Set the base height of the window (px) that will be used to determine the amount of vertical stretching that will happen
              * @param height The new base height of the window (px) that will be used to determine the amount of vertical stretching that will happen
@@ -467,7 +698,7 @@ namespace bengine {
 
                 return output;
             }
-            /** Handles the general behavior that windows should have when certain events trigger (for now, just window resizing)
+            /** Handles the general behavior that windows should have when certain events trigger (resizing, and moving between displays)
              * @param event The SDL_WindowEvent to handle
              */
             void handleEvent(const SDL_WindowEvent &event) {
@@ -486,6 +717,12 @@ namespace bengine {
                         }
                         bengine::window::updateDims();
                         break;
+                    case SDL_WINDOWEVENT_MOVED:
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                    case SDL_WINDOWEVENT_DISPLAY_CHANGED:
+#endif
+                        bengine::window::updateDisplay();
+                        break;
                 }
             }
             /// @brief Center the mouse within the window
@@ -727,18 +964,30 @@ namespace bengine {
                 }
             }
 
-            /** Load an SDL_Texture using the window's renderer
-             * @param filepath The path to the file to load in as an SDL_Texture
-             * @returns An SDL_Texture of the image file located at filepath
+            /** Load a texture using the window's renderer; loading a file that is already loaded shares its texture
+             * @param filepath The path to the file to load in as a texture
+             * @returns A handle to the texture of the image file located at filepath
              */
-            SDL_Texture *loadTexture(const char* filepath) {
-                SDL_Texture *output = NULL;
-                if ((output = IMG_LoadTexture(this->renderer, filepath)) == NULL) {
+            bengine::textureHandle loadTexture(const char* filepath) {
+                bengine::textureHandle output = this->textures.load(filepath);
+                if (output == nullptr) {
                     std::cout << "Window \"" << this->title << "\" failed to load texture";
                     bengine::window::printError();
                 }
                 return output;
             }
+            /** Get the cache that every texture created through the window comes from
+             * @returns The window's texture cache
+             */
+            bengine::textureCache &getTextureCache() {
+                return this->textures;
+            }
+            /** Get the totals (including GPU memory) for every texture created through the window
+             * @returns The window's texture totals
+             */
+            const bengine::textureStats &getTextureStats() const {
+                return this->textures.getStats();
+            }
 
             /** Get the pixelformat that the window's dummy texture uses
              * @returns The pixelformat that the window's dummy texture uses
@@ -770,8 +1019,9 @@ namespace bengine {
                 if (this->pixelFormat.format == SDL_PIXELFORMAT_UNKNOWN) {
                     bengine::window::setPixelFormat();
                 }
-                this->dummyTexture = SDL_CreateTexture(this->renderer, this->pixelFormat.format, SDL_TEXTUREACCESS_TARGET, width, height);
-                if (this->dummyTexture == NULL) {
+                // The old dummy texture is destroyed here unless something (e.g. a copy) still holds it
+                this->dummyTexture = this->textures.create(this->pixelFormat.format, SDL_TEXTUREACCESS_TARGET, width, height);
+                if (this->dummyTexture == nullptr) {
                     std::cout << "Window \"" << this->title << "\" failed to create dummy texture";
                     bengine::window::printError();
                     return -1;
@@ -787,7 +1037,7 @@ namespace bengine {
              * @returns 0 on success or a negative error code on failure
              */
             int targetDummy() {
-                const int output = SDL_SetRenderTarget(this->renderer, this->dummyTexture);
+                const int output = SDL_SetRenderTarget(this->renderer, this->dummyTexture.get());
                 if (output != 0) {
                     std::cout << "Window \"" << this->title << "\" failed to switch the rendering target to the dummy texture";
                     bengine::window::printError();
@@ -809,24 +1059,56 @@ namespace bengine {
                 }
                 return output;
             }
+            /** Create a texture that can be rendered to directly with targetTexture(), in the same pixel format as the dummy texture
+             * @param width The width of the texture (px)
+             * @param height The height of the texture (px)
+             * @returns A handle to the new texture, or nullptr if it could not be created
+             */
+            bengine::textureHandle createTarget(const Uint16 &width, const Uint16 &height) {
+                if (this->pixelFormat.format == SDL_PIXELFORMAT_UNKNOWN) {
+                    bengine::window::setPixelFormat();
+                }
+                bengine::textureHandle output = this->textures.create(this->pixelFormat.format, SDL_TEXTUREACCESS_TARGET, width, height);
+                if (output == nullptr) {
+                    std::cout << "Window \"" << this->title << "\" failed to create a target texture";
+                    bengine::window::printError();
+                }
+                return output;
+            }
+            /** Target the renderer at a texture made by createTarget(); unlike the dummy texture, nothing has to be copied out afterwards
+             * 
+             * Counts as targeting the dummy texture for initDummy() and copyDummy(), which go back to the dummy texture rather than this one; call targetWindow() when done
+             * @param texture The texture to render to
+             * @returns 0 on success or a negative error code on failure
+             */
+            int targetTexture(const bengine::textureHandle &texture) {
+                const int output = SDL_SetRenderTarget(this->renderer, texture.get());
+                if (output != 0) {
+                    std::cout << "Window \"" << this->title << "\" failed to switch the rendering target to a texture";
+                    bengine::window::printError();
+                } else {
+                    this->renderTarget = RENDERTARGET_DUMMY;
+                }
+                return output;
+            }
             /** Copy the dummy texture onto another texture (has a few ramifications but should be fine overall)
-             * @returns An SDL_Texture that reflects the dummy texture
+             * @returns A handle to a texture that reflects the dummy texture
              */
-            SDL_Texture* copyDummy() {
+            bengine::textureHandle copyDummy() {
                 int w, h;
                 SDL_BlendMode blendmode;
 
-                SDL_QueryTexture(this->dummyTexture, NULL, NULL, &w, &h);
-                SDL_GetTextureBlendMode(this->dummyTexture, &blendmode);
+                SDL_QueryTexture(this->dummyTexture.get(), NULL, NULL, &w, &h);
+                SDL_GetTextureBlendMode(this->dummyTexture.get(), &blendmode);
 
-                SDL_Texture* output = SDL_CreateTexture(this->renderer, this->pixelFormat.format, SDL_TEXTUREACCESS_TARGET, w, h);
-                SDL_SetTextureBlendMode(output, SDL_BLENDMODE_NONE);
+                bengine::textureHandle output = this->textures.create(this->pixelFormat.format, SDL_TEXTUREACCESS_TARGET, w, h);
+                SDL_SetTextureBlendMode(output.get(), SDL_BLENDMODE_NONE);
                 
-                SDL_SetRenderTarget(this->renderer, output);
+                SDL_SetRenderTarget(this->renderer, output.get());
                 bengine::window::clear();
-                SDL_RenderCopy(this->renderer, this->dummyTexture, NULL, NULL);
+                SDL_RenderCopy(this->renderer, this->dummyTexture.get(), NULL, NULL);
                 bengine::window::present();
-                SDL_SetTextureBlendMode(output, blendmode);
+                SDL_SetTextureBlendMode(output.get(), blendmode);
 
                 if (this->renderTarget == RENDERTARGET_WINDOW) {
                     bengine::window::targetWindow();
@@ -883,6 +1165,7 @@ namespace bengine {
              * @param dst The portion of the window/dummy texture to copy to (px for all 4 metrics)  (will stretch the texture to fill the given rectangle)
              */
             void renderBasicTexture(const bengine::basicTexture &texture, const SDL_Rect &dst) {
+                bengine::window::clearMods(texture.getTexture());
                 const SDL_Rect frame = texture.getFrame();
                 if (this->stretchGraphics) {
                     const SDL_Rect destination = {bengine::window::stretchX(dst.x), bengine::window::stretchY(dst.y), bengine::window::stretchX(dst.w), bengine::window::stretchY(dst.h)};
@@ -905,6 +1188,7 @@ namespace bengine {
              * @param flip How to flip the rectangle (SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL can be OR'd together)
              */
             void renderBasicTexture(const bengine::basicTexture &texture, const SDL_Rect &dst, const double &angle, const SDL_Point &pivot, const SDL_RendererFlip &flip) {
+                bengine::window::clearMods(texture.getTexture());
                 const SDL_Rect frame = texture.getFrame();
                 if (this->stretchGraphics) {
                     const SDL_Rect destination = {bengine::window::stretchX(dst.x), bengine::window::stretchY(dst.y), bengine::window::stretchX(dst.w), bengine::window::stretchY(dst.h)};
@@ -925,6 +1209,7 @@ namespace bengine {
              * @param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the texture to fill the given rectangle)
              */
             void renderModdedTexture(const bengine::moddedTexture &texture, const SDL_Rect &dst) {
+                bengine::window::applyMods(texture);
                 const SDL_Rect frame = texture.getFrame();
                 if (this->stretchGraphics) {
                     const SDL_Rect destination = {bengine::window::stretchX(dst.x), bengine::window::stretchY(dst.y), bengine::window::stretchX(dst.w), bengine::window::stretchY(dst.h)};
@@ -947,6 +1232,7 @@ namespace bengine {
              * @param flip How to flip the rectangle (SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL can be OR'd together)
              */
             void renderModdedTexture(const bengine::moddedTexture &texture, const SDL_Rect &dst, const double &angle, const SDL_Point &pivot, const SDL_RendererFlip &flip) {
+                bengine::window::applyMods(texture);
                 const SDL_Rect frame = texture.getFrame();
                 if (this->stretchGraphics) {
                     const SDL_Rect destination = {bengine::window::stretchX(dst.x), bengine::window::stretchY(dst.y), bengine::window::stretchX(dst.w), bengine::window::stretchY(dst.h)};
@@ -967,6 +1253,7 @@ namespace bengine {
              * @param dst The portion of the window/dummy texture to copy to (px for all 4 metrics) (will stretch the texture to fill the given rectangle)
              */
             void renderShiftingTexture(const bengine::shiftingTexture &texture, const SDL_Rect &dst) {
+                bengine::window::applyMods(texture);
                 const SDL_Rect frame = texture.getFrame();
                 const SDL_Point pivot = texture.getPivot();
                 if (this->stretchGraphics) {
@@ -983,6 +1270,98 @@ namespace bengine {
                 }
             }
 
+            /** Start a new command list; everything recorded before is dropped
+             * 
+             * The command list is the retained alternative to the render* functions: draws are recorded once, sorted and merged into as few batches as possible, and then submitted every frame until something needs recording again
+             */
+            void clearCommands() {
+                this->commands.clear();
+                this->commandsDirty = true;
+            }
+            /** Record a texture into the command list; later draws still land on top of earlier ones that they overlap
+             * @param texture The bengine::basicTexture to draw (its source is held by the list, its frame is copied)
+             * @param dst Where to draw it (px for all 4 metrics) (stretched with the window like the render* functions)
+             * @returns Whether anything was recorded (nothing is for textures without a source)
+             */
+            bool recordBasicTexture(const bengine::basicTexture &texture, const SDL_Rect &dst) {
+                return this->recordCommand(texture.getHandle(), texture.getFrame(), dst, SDL_BLENDMODE_BLEND, {255, 255, 255, 255});
+            }
+            /** Record a texture with color modifications into the command list; later draws still land on top of earlier ones that they overlap
+             * @param texture The bengine::moddedTexture to draw (its source is held by the list, its frame and modifications are copied)
+             * @param dst Where to draw it (px for all 4 metrics) (stretched with the window like the render* functions)
+             * @returns Whether anything was recorded (nothing is for textures without a source)
+             */
+            bool recordModdedTexture(const bengine::moddedTexture &texture, const SDL_Rect &dst) {
+                return this->recordCommand(texture.getHandle(), texture.getFrame(), dst, texture.getBlendMode(), texture.getColorMod());
+            }
+            /** Draw everything in the command list; the batches are only sorted and built again when something was recorded or the window's scaling changed
+             * @returns The amount of draw calls made
+             */
+            std::size_t submitCommands() {
+                const int scale[5] = {this->width, this->height, this->baseWidth, this->baseHeight, this->stretchGraphics};
+                if (this->commandsDirty || !std::equal(scale, scale + 5, this->commandScale)) {
+                    std::copy(scale, scale + 5, this->commandScale);
+                    this->buildCommandBatches();
+                }
+
+                std::size_t output = 0;
+                for (std::size_t i = 0; i < this->commandBatches.size(); i++) {
+                    const drawBatch &batch = this->commandBatches[i];
+                    // The color modification lives in the vertices, so the texture's own has to be left neutral
+                    bengine::window::clearMods(batch.texture);
+                    SDL_SetTextureBlendMode(batch.texture, batch.blendMode);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                    if (SDL_RenderGeometry(this->renderer, batch.texture, this->commandVertices.data(), this->commandVertices.size(), this->commandIndices.data() + batch.firstIndex, batch.indexCount) == 0) {
+                        output++;
+                        continue;
+                    }
+#endif
+                    // Renderers without geometry support get one copy per quad, still in sorted order
+                    for (int j = batch.firstIndex / 6; j < (batch.firstIndex + batch.indexCount) / 6; j++) {
+                        const drawCommand &command = this->commands[this->commandOrder[j]];
+                        SDL_SetTextureColorMod(batch.texture, command.colorMod.r, command.colorMod.g, command.colorMod.b);
+                        SDL_SetTextureAlphaMod(batch.texture, command.colorMod.a);
+                        bengine::window::renderSDLTexture(batch.texture, command.src, command.dst);
+                        output++;
+                    }
+                }
+                return output;
+            }
+            /** Get the amount of draws in the command list
+             * @returns The amount of recorded draws
+             */
+            std::size_t getCommandCount() const {
+                return this->commands.size();
+            }
+            /** Get the amount of batches that the command list was merged into when it was last submitted
+             * @returns The amount of batches
+             */
+            std::size_t getBatchCount() const {
+                return this->commandBatches.size();
+            }
+
+            /** Render text into a texture once so that it can be drawn any amount of times afterwards (supports most unicode characters)
+             * @param font The TTF_Font to use (represents both the font and size of the font)
+             * @param text The text to render (literals are written as u"[text]", std::u16_string is useful too)
+             * @param color The color of the text as an SDL_Color
+             * @param wrapWidth The maximum width for the text (px) (a width of zero prevents any wrapping)
+             * @returns A texture of the text framed to its size (empty if it could not be rendered)
+             */
+            bengine::basicTexture loadText(TTF_Font *font, const char16_t *text, const SDL_Color &color = bengine::colors[bengine::COLOR_WHITE], const Uint32 &wrapWidth = 0) {
+                SDL_Surface *surface = TTF_RenderUNICODE_Blended_Wrapped(font, (Uint16*)text, color, wrapWidth);
+                if (surface == NULL) {
+                    std::cout << "Window \"" << this->title << "\" failed to render text\nERROR: " << TTF_GetError() << "\n";
+                    return bengine::basicTexture();
+                }
+                const bengine::textureHandle texture = this->textures.adopt(SDL_CreateTextureFromSurface(this->renderer, surface));
+                const SDL_Rect frame = {0, 0, surface->w, surface->h};
+                SDL_FreeSurface(surface);
+                if (texture == nullptr) {
+                    std::cout << "Window \"" << this->title << "\" failed to create a texture for text";
+                    bengine::window::printError();
+                }
+                return bengine::basicTexture(texture, frame);
+            }
             /** Render text using a TTF_Font based off of a point (supports most unicode characters)
              * @param font The TTF_Font to use (represents both the font and size of the font)
              * @param text The text to display (literals are written as u"[text]", std::u16_string is useful too)
@@ -994,12 +1373,16 @@ namespace bengine {
             void renderText(TTF_Font *font, const char16_t *text, const int &x, const int &y, const Uint32 &wrapWidth = 0, const SDL_Color &color = bengine::colors[bengine::COLOR_WHITE]) {
                 SDL_Surface *surface = TTF_RenderUNICODE_Blended_Wrapped(font, (Uint16*)text, color, wrapWidth);
 
+                SDL_Texture *texture = SDL_CreateTextureFromSurface(this->renderer, surface);
+
                 const SDL_Rect src = {0, 0, surface->w, surface->h};
                 const SDL_Rect dst = {x, y, surface->w, surface->h};
-                bengine::window::renderSDLTexture(SDL_CreateTextureFromSurface(this->renderer, surface), src, dst);
+                bengine::window::renderSDLTexture(texture, src, dst);
                 
                 SDL_FreeSurface(surface);
+                SDL_DestroyTexture(texture);
                 surface = nullptr;
+                texture = nullptr;
             }
             /** Render text using a TTF_Font based off of a point (supports most unicode characters)
              * @param font The TTF_Font to use (represents both the font and size of the font)
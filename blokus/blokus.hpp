@@ -2,8 +2,23 @@
 #define BLOKUS_hpp
 
 #include "blokus_polyominoes.hpp"
+#include "blokus_orientations.hpp"
+#include "blokus_bitboard.hpp"
+#include "blokus_state.hpp"
+#include "blokus_symmetry.hpp"
+#include "blokus_regions.hpp"
+#include "blokus_endgame.hpp"
+#include "blokus_file.hpp"
+#include "blokus_book.hpp"
+#include "blokus_network.hpp"
+#include "blokus_samples.hpp"
+#include "blokus_record.hpp"
+#include "blokus_computer.hpp"
 #include "blokus_piece.hpp"
 #include "blokus_player.hpp"
+#include "blokus_snapshot.hpp"
+#include "blokus_thumbnails.hpp"
+#include "blokus_boardview.hpp"
 #include "blokus_game.hpp"
 
 #endif // BLOKUS_hpp
@@ -0,0 +1,164 @@
+#ifndef BLOKUS_BASEPIECES_hpp
+#define BLOKUS_BASEPIECES_hpp
+
+#include <vector>
+
+#include "btils_matrix.hpp"
+
+namespace blokus {
+    /// @brief The grid of a base piece exactly as it appears in dev/polyominoes/base.txt
+    struct baseGrid {
+        /// @brief The amount of rows in the grid
+        unsigned char rows;
+        /// @brief The amount of columns in the grid
+        unsigned char cols;
+        /// @brief The rows of the grid; bit j of row i is the cell at row i, column j
+        unsigned char bits[5];
+    };
+
+    /// @brief The 21 base pieces (monomino through pentominoes), in base set order
+    constexpr blokus::baseGrid baseGrids[21] = {
+        {1, 1, {1}},
+        {1, 2, {3}},
+        {1, 3, {7}},
+        {2, 2, {2, 3}},
+        {1, 4, {15}},
+        {2, 3, {4, 7}},
+        {2, 3, {6, 3}},
+        {2, 3, {2, 7}},
+        {2, 2, {3, 3}},
+        {1, 5, {31}},
+        {2, 4, {8, 15}},
+        {2, 4, {4, 15}},
+        {3, 3, {2, 7, 4}},
+        {3, 3, {1, 7, 4}},
+        {3, 3, {7, 1, 1}},
+        {3, 3, {6, 3, 1}},
+        {2, 3, {5, 7}},
+        {3, 3, {2, 7, 2}},
+        {3, 3, {2, 2, 7}},
+        {2, 3, {7, 3}},
+        {2, 4, {12, 7}}
+    };
+
+    /// @brief A single cell within an orientation, relative to the orientation's top-left corner
+    struct orientationCell {
+        /// @brief x-offset of the cell from the orientation's left edge
+        unsigned char x = 0;
+        /// @brief y-offset of the cell from the orientation's top edge
+        unsigned char y = 0;
+    };
+
+    /// @brief One distinct rotation/reflection of a polyomino, stored as a list of cells for fast placement checks (no polyomino in play has more than 8 cells)
+    struct orientation {
+        /// @brief The width of the orientation's bounding box
+        unsigned char width = 0;
+        /// @brief The height of the orientation's bounding box
+        unsigned char height = 0;
+        /// @brief The amount of cells that the orientation covers
+        unsigned char cellCount = 0;
+        /// @brief The cells that the orientation covers, in row-major order
+        blokus::orientationCell cells[8] = {};
+        /// @brief The rows of the orientation as bitmasks; bit x of rows[y] is the cell at (x, y)
+        unsigned char rows[8] = {};
+    };
+
+    /// @brief Every orientation of every base piece
+    struct basePieceTable {
+        /// @brief The amount of distinct orientations of each base piece
+        unsigned char orientationCounts[21] = {};
+        /// @brief The orientations of each base piece, in the same order as blokus::generateOrientations()
+        blokus::orientation orientations[21][8] = {};
+    };
+
+    /** Convert a trimmed grid into an orientation
+     * @param grid The trimmed grid of the orientation
+     * @returns The orientation
+     */
+    constexpr blokus::orientation buildBaseOrientation(const btils::bitMatrix<5, 5> &grid) {
+        blokus::orientation output;
+        output.width = grid.getCols();
+        output.height = grid.getRows();
+        for (unsigned char y = 0; y < output.height; y++) {
+            output.rows[y] = grid.getRow(y);
+            for (unsigned char x = 0; x < output.width; x++) {
+                if (grid.get(y, x)) {
+                    output.cells[output.cellCount].x = x;
+                    output.cells[output.cellCount].y = y;
+                    output.cellCount++;
+                }
+            }
+        }
+        return output;
+    }
+
+    /** Generate every orientation of every base piece; done at compile time to build blokus::basePieces
+     *
+     * Matches blokus::generateOrientations(): the four counter-clockwise rotations of the grid, then the four rotations of its horizontal mirror, with duplicates removed
+     * @returns The table of base piece orientations
+     */
+    constexpr blokus::basePieceTable buildBasePieceTable() {
+        blokus::basePieceTable output;
+        for (unsigned char p = 0; p < 21; p++) {
+            btils::bitMatrix<5, 5> grid(blokus::baseGrids[p].rows, blokus::baseGrids[p].cols);
+            for (unsigned char y = 0; y < blokus::baseGrids[p].rows; y++) {
+                grid.setRow(y, blokus::baseGrids[p].bits[y]);
+            }
+
+            btils::bitMatrix<5, 5> found[8] = {};
+            btils::bitMatrix<5, 5> current = grid;
+            for (unsigned char i = 0; i < 8; i++) {
+                if (i == 4) {
+                    current = grid.flipped(false);
+                } else if (i > 0) {
+                    current = current.rotated(true);
+                }
+
+                const btils::bitMatrix<5, 5> candidate = current.trimmed();
+                bool duplicate = false;
+                for (unsigned char j = 0; j < output.orientationCounts[p]; j++) {
+                    duplicate |= found[j] == candidate;
+                }
+                if (!duplicate) {
+                    found[output.orientationCounts[p]] = candidate;
+                    output.orientations[p][output.orientationCounts[p]] = blokus::buildBaseOrientation(candidate);
+                    output.orientationCounts[p]++;
+                }
+            }
+        }
+        return output;
+    }
+
+    /// @brief Every orientation of every base piece, generated at compile time
+    constexpr blokus::basePieceTable basePieces = blokus::buildBasePieceTable();
+
+    /** Count the orientations within the base piece table
+     * @returns The total amount of base piece orientations
+     */
+    constexpr unsigned short basePieceOrientationTotal() {
+        unsigned short output = 0;
+        for (unsigned char p = 0; p < 21; p++) {
+            output += blokus::basePieces.orientationCounts[p];
+        }
+        return output;
+    }
+    static_assert(blokus::basePieceOrientationTotal() == 91, "The 21 base pieces have 91 distinct orientations");
+
+    /** Get the grids of the base pieces in the same form as blokus::readPolyominoFile() gives them
+     * @returns A list of grids for the base pieces
+     */
+    std::vector<std::vector<std::vector<bool>>> basePolyominoGrids() {
+        std::vector<std::vector<std::vector<bool>>> output;
+        for (unsigned char p = 0; p < 21; p++) {
+            output.emplace_back(blokus::baseGrids[p].rows, std::vector<bool>(blokus::baseGrids[p].cols, false));
+            for (unsigned char i = 0; i < blokus::baseGrids[p].rows; i++) {
+                for (unsigned char j = 0; j < blokus::baseGrids[p].cols; j++) {
+                    output[p][i][j] = (blokus::baseGrids[p].bits[i] >> j) & 1;
+                }
+            }
+        }
+        return output;
+    }
+}
+
+#endif // BLOKUS_BASEPIECES_hpp
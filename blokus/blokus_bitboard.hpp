@@ -0,0 +1,476 @@
+#ifndef BLOKUS_BITBOARD_hpp
+#define BLOKUS_BITBOARD_hpp
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+namespace blokus {
+    /// @brief A square grid of bits stored row-by-row in 64-bit words; used to hold occupancy/anchor/etc. data for a board of up to 100x100 cells
+    class bitboard {
+        private:
+            /// @brief The side length of the board in cells
+            unsigned char size = 0;
+            /// @brief The amount of 64-bit words used for each row of the board
+            unsigned char stride = 0;
+            /// @brief The words making up the board; row y occupies words [y * stride, (y + 1) * stride)
+            std::vector<std::uint64_t> words = {};
+
+            /** Get the mask of the bits that are actually in use for a given word of a row
+             * @param word The index of the word within the row
+             * @returns A mask with every in-bounds bit of the word set
+             */
+            std::uint64_t rowMask(const unsigned char &word) const {
+                const unsigned short bits = this->size - word * 64;
+                return bits >= 64 ? UINT64_MAX : (((std::uint64_t)1 << bits) - 1);
+            }
+            /** Add the neighbors of every set cell in place, one row at a time
+             * @param allowed The cells that may be added (nullptr for any in-bounds cell)
+             * @param diagonals Whether cells touching by a corner count as neighbors
+             * @returns Whether any cell was added
+             */
+            bool expandRows(const blokus::bitboard *allowed, const bool &diagonals) {
+                bool changed = false;
+                // Rows are overwritten as they are finished, so the row above is kept as it was before
+                std::uint64_t above[2] = {0, 0};
+                for (unsigned char y = 0; y < this->size; y++) {
+                    std::uint64_t *row = &this->words[y * this->stride];
+                    const std::uint64_t original[2] = {row[0], this->stride > 1 ? row[1] : 0};
+                    std::uint64_t vertical[2] = {0, 0};
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        vertical[w] = above[w] | original[w] | (y + 1 < this->size ? row[this->stride + w] : 0);
+                    }
+                    // Corner neighbors are the edge neighbors of the cells above and below, so spread the whole column sideways
+                    const std::uint64_t *spread = diagonals ? vertical : original;
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        std::uint64_t grown = vertical[w] | (spread[w] << 1) | (spread[w] >> 1);
+                        if (w > 0) {
+                            grown |= spread[w - 1] >> 63;
+                        }
+                        if (w + 1 < this->stride) {
+                            grown |= spread[w + 1] << 63;
+                        }
+                        grown &= this->rowMask(w);
+                        if (allowed != nullptr) {
+                            grown &= allowed->words[y * this->stride + w];
+                        }
+                        row[w] = original[w] | grown;
+                        changed |= row[w] != original[w];
+                    }
+                    above[0] = original[0];
+                    above[1] = original[1];
+                }
+                return changed;
+            }
+
+        public:
+            /** blokus::bitboard constructor
+             * @param size The side length of the board in cells
+             */
+            bitboard(const unsigned char &size = 20) : size(size), stride((size + 63) / 64) {
+                this->words.assign((std::size_t)this->size * this->stride, 0);
+            }
+
+            /** Get the side length of the board
+             * @returns The side length of the board in cells
+             */
+            unsigned char getSize() const {
+                return this->size;
+            }
+            /** Get the amount of 64-bit words used for each row
+             * @returns The amount of 64-bit words used for each row
+             */
+            unsigned char getStride() const {
+                return this->stride;
+            }
+            /** Get the raw words of the board (row-major, getStride() words per row)
+             * @returns The raw words of the board
+             */
+            const std::vector<std::uint64_t> &getWords() const {
+                return this->words;
+            }
+            /** Get the raw words of the board (row-major, getStride() words per row)
+             * @returns The raw words of the board
+             */
+            std::vector<std::uint64_t> &getWords() {
+                return this->words;
+            }
+
+            /** Get the cells of a row starting at a column, as one word (no bounds checking on y)
+             * @param x x-position of the first cell
+             * @param y y-position of the row
+             * @returns A word where bit i is the cell at (x + i, y); cells past the edge of the board are clear
+             */
+            std::uint64_t rowBits(const int &x, const int &y) const {
+                const std::uint64_t *row = this->words.data() + y * this->stride;
+                const unsigned char word = x / 64, shift = x % 64;
+                std::uint64_t output = row[word] >> shift;
+                if (shift > 0 && word + 1 < this->stride) {
+                    output |= row[word + 1] << (64 - shift);
+                }
+                return output;
+            }
+            /** Check whether a cell is set
+             * @param x x-position of the cell
+             * @param y y-position of the cell
+             * @returns Whether the cell is set; out-of-bounds cells are never set
+             */
+            bool test(const int &x, const int &y) const {
+                if (x < 0 || y < 0 || x >= this->size || y >= this->size) {
+                    return false;
+                }
+                return (this->words[y * this->stride + x / 64] >> (x % 64)) & 1;
+            }
+            /** Set a cell (no bounds checking)
+             * @param x x-position of the cell
+             * @param y y-position of the cell
+             */
+            void set(const int &x, const int &y) {
+                this->words[y * this->stride + x / 64] |= (std::uint64_t)1 << (x % 64);
+            }
+            /** Clear a cell (no bounds checking)
+             * @param x x-position of the cell
+             * @param y y-position of the cell
+             */
+            void reset(const int &x, const int &y) {
+                this->words[y * this->stride + x / 64] &= ~((std::uint64_t)1 << (x % 64));
+            }
+            /// @brief Clear every cell
+            void clear() {
+                for (std::size_t i = 0; i < this->words.size(); i++) {
+                    this->words[i] = 0;
+                }
+            }
+            /// @brief Set every in-bounds cell
+            void fill() {
+                for (unsigned char y = 0; y < this->size; y++) {
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        this->words[y * this->stride + w] = this->rowMask(w);
+                    }
+                }
+            }
+
+            /** Count the amount of set cells
+             * @returns The amount of set cells
+             */
+            std::size_t count() const {
+                std::size_t output = 0;
+                for (std::size_t i = 0; i < this->words.size(); i++) {
+                    output += __builtin_popcountll(this->words[i]);
+                }
+                return output;
+            }
+            /** Check whether any cell is set
+             * @returns Whether any cell is set
+             */
+            bool any() const {
+                for (std::size_t i = 0; i < this->words.size(); i++) {
+                    if (this->words[i] != 0) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            /** Check whether this board shares any set cell with another
+             * @param rhs The board to compare against (must be the same size)
+             * @returns Whether the two boards share any set cell
+             */
+            bool intersects(const blokus::bitboard &rhs) const {
+                for (std::size_t i = 0; i < this->words.size(); i++) {
+                    if ((this->words[i] & rhs.words[i]) != 0) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool operator==(const blokus::bitboard &rhs) const {
+                return this->size == rhs.size && this->words == rhs.words;
+            }
+            bool operator!=(const blokus::bitboard &rhs) const {
+                return !(*this == rhs);
+            }
+            blokus::bitboard &operator|=(const blokus::bitboard &rhs) {
+                for (std::size_t i = 0; i < this->words.size(); i++) {
+                    this->words[i] |= rhs.words[i];
+                }
+                return *this;
+            }
+            blokus::bitboard &operator&=(const blokus::bitboard &rhs) {
+                for (std::size_t i = 0; i < this->words.size(); i++) {
+                    this->words[i] &= rhs.words[i];
+                }
+                return *this;
+            }
+            blokus::bitboard operator|(const blokus::bitboard &rhs) const {
+                blokus::bitboard output = *this;
+                return output |= rhs;
+            }
+            blokus::bitboard operator&(const blokus::bitboard &rhs) const {
+                blokus::bitboard output = *this;
+                return output &= rhs;
+            }
+            /** Clear every cell that is set in another board (this &= ~rhs)
+             * @param rhs The board whose set cells will be cleared from this one
+             * @returns A reference to this board
+             */
+            blokus::bitboard &remove(const blokus::bitboard &rhs) {
+                for (std::size_t i = 0; i < this->words.size(); i++) {
+                    this->words[i] &= ~rhs.words[i];
+                }
+                return *this;
+            }
+            /** Get the complement of the board (only in-bounds cells are set)
+             * @returns A board with every in-bounds cell flipped
+             */
+            blokus::bitboard inverted() const {
+                blokus::bitboard output = *this;
+                for (unsigned char y = 0; y < this->size; y++) {
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        output.words[y * this->stride + w] = ~output.words[y * this->stride + w] & this->rowMask(w);
+                    }
+                }
+                return output;
+            }
+            /// @brief Flip every in-bounds cell in place
+            void invert() {
+                for (unsigned char y = 0; y < this->size; y++) {
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        this->words[y * this->stride + w] = ~this->words[y * this->stride + w] & this->rowMask(w);
+                    }
+                }
+            }
+            /** Add every neighbor of a set cell in place (the allocation-free form of edgeNeighbors()/cornerNeighbors())
+             * @param diagonals Whether cells touching by a corner are added as well
+             * @returns Whether any cell was added
+             */
+            bool expand(const bool &diagonals = false) {
+                return this->expandRows(nullptr, diagonals);
+            }
+            /** Add every neighbor of a set cell that is also set in another board, in place; repeating until nothing changes flood-fills through that board
+             * @param allowed The cells that may be added (must be the same size)
+             * @param diagonals Whether cells touching by a corner are added as well
+             * @returns Whether any cell was added
+             */
+            bool expand(const blokus::bitboard &allowed, const bool &diagonals = false) {
+                return this->expandRows(&allowed, diagonals);
+            }
+
+            /** Shift every cell one row up (towards y = 0); the bottom row becomes empty
+             * @returns The shifted board
+             */
+            blokus::bitboard shiftedNorth() const {
+                blokus::bitboard output(this->size);
+                for (std::size_t i = this->stride; i < this->words.size(); i++) {
+                    output.words[i - this->stride] = this->words[i];
+                }
+                return output;
+            }
+            /** Shift every cell one row down (towards y = size - 1); the top row becomes empty
+             * @returns The shifted board
+             */
+            blokus::bitboard shiftedSouth() const {
+                blokus::bitboard output(this->size);
+                for (std::size_t i = this->stride; i < this->words.size(); i++) {
+                    output.words[i] = this->words[i - this->stride];
+                }
+                return output;
+            }
+            /** Shift every cell one column right (towards x = size - 1); the leftmost column becomes empty
+             * @returns The shifted board
+             */
+            blokus::bitboard shiftedEast() const {
+                blokus::bitboard output(this->size);
+                for (unsigned char y = 0; y < this->size; y++) {
+                    std::uint64_t carry = 0;
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        const std::uint64_t word = this->words[y * this->stride + w];
+                        output.words[y * this->stride + w] = ((word << 1) | carry) & this->rowMask(w);
+                        carry = word >> 63;
+                    }
+                }
+                return output;
+            }
+            /** Shift every cell one column left (towards x = 0); the rightmost column becomes empty
+             * @returns The shifted board
+             */
+            blokus::bitboard shiftedWest() const {
+                blokus::bitboard output(this->size);
+                for (unsigned char y = 0; y < this->size; y++) {
+                    std::uint64_t carry = 0;
+                    for (unsigned char w = this->stride; w--;) {
+                        const std::uint64_t word = this->words[y * this->stride + w];
+                        output.words[y * this->stride + w] = (word >> 1) | carry;
+                        carry = word << 63;
+                    }
+                }
+                return output;
+            }
+
+            /** Get every cell that shares an edge with a set cell (excluding the set cells themselves unless they also neighbor one)
+             * @returns A board of every edge-adjacent neighbor
+             */
+            blokus::bitboard edgeNeighbors() const {
+                blokus::bitboard output = this->shiftedNorth();
+                output |= this->shiftedSouth();
+                output |= this->shiftedEast();
+                output |= this->shiftedWest();
+                return output;
+            }
+            /** Get every cell that touches a set cell by a corner only
+             * @returns A board of every diagonal neighbor
+             */
+            blokus::bitboard cornerNeighbors() const {
+                const blokus::bitboard east = this->shiftedEast();
+                const blokus::bitboard west = this->shiftedWest();
+                blokus::bitboard output = east.shiftedNorth();
+                output |= east.shiftedSouth();
+                output |= west.shiftedNorth();
+                output |= west.shiftedSouth();
+                return output;
+            }
+
+            /** Reverse the order of the bits within a word
+             * @param word The word to reverse
+             * @returns The word with bit 0 swapped with bit 63, bit 1 with bit 62, etc.
+             */
+            static std::uint64_t reverseBits(std::uint64_t word) {
+                word = ((word >> 1) & 0x5555555555555555ULL) | ((word & 0x5555555555555555ULL) << 1);
+                word = ((word >> 2) & 0x3333333333333333ULL) | ((word & 0x3333333333333333ULL) << 2);
+                word = ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+                return __builtin_bswap64(word);
+            }
+            /** Transpose a square block of bits in place (bit x of word y swaps with bit y of word x)
+             * @tparam Word The type of the words making up the block (std::uint32_t or std::uint64_t)
+             * @tparam Bits The amount of bits within a word (also the amount of words)
+             * @param block The words making up the block
+             */
+            template <typename Word, unsigned char Bits> static void transposeBlock(Word block[Bits]) {
+                Word mask = ((Word)1 << (Bits / 2)) - 1;
+                for (unsigned char j = Bits / 2; j != 0; j >>= 1, mask ^= mask << j) {
+                    for (unsigned char k = 0; k < Bits; k = ((k | j) + 1) & ~j) {
+                        const Word swap = ((block[k] >> j) ^ block[k | j]) & mask;
+                        block[k] ^= swap << j;
+                        block[k | j] ^= swap;
+                    }
+                }
+            }
+
+            /// @brief Mirror the board left-right in place
+            void mirrorX() {
+                const unsigned short padding = this->stride * 64 - this->size;
+                std::uint64_t reversed[2];
+                for (unsigned char y = 0; y < this->size; y++) {
+                    std::uint64_t *row = &this->words[y * this->stride];
+                    // Reverse the whole padded row, then slide it back over the padding
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        reversed[w] = blokus::bitboard::reverseBits(row[this->stride - 1 - w]);
+                    }
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        row[w] = padding == 0 ? reversed[w] : (reversed[w] >> padding) | (w + 1 < this->stride ? reversed[w + 1] << (64 - padding) : 0);
+                    }
+                }
+            }
+            /// @brief Mirror the board top-bottom in place
+            void mirrorY() {
+                for (unsigned char y = 0; y < this->size / 2; y++) {
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        std::swap(this->words[y * this->stride + w], this->words[(this->size - 1 - y) * this->stride + w]);
+                    }
+                }
+            }
+            /// @brief Mirror the board across its main (top-left to bottom-right) diagonal in place
+            void transpose() {
+                // Boards of up to 32x32 (including every standard board) fit within a single 32-bit block
+                if (this->size <= 32) {
+                    std::uint32_t block[32] = {};
+                    for (unsigned char y = 0; y < this->size; y++) {
+                        block[y] = this->words[y];
+                    }
+                    blokus::bitboard::transposeBlock<std::uint32_t, 32>(block);
+                    for (unsigned char y = 0; y < this->size; y++) {
+                        this->words[y] = block[y];
+                    }
+                    return;
+                }
+
+                std::uint64_t blocks[2][2][64];
+                for (unsigned char by = 0; by < this->stride; by++) {
+                    for (unsigned char bx = 0; bx < this->stride; bx++) {
+                        std::uint64_t *block = blocks[bx][by];
+                        for (unsigned char i = 0; i < 64; i++) {
+                            const unsigned short y = by * 64 + i;
+                            block[i] = y < this->size ? this->words[y * this->stride + bx] : 0;
+                        }
+                        blokus::bitboard::transposeBlock<std::uint64_t, 64>(block);
+                    }
+                }
+                for (unsigned char by = 0; by < this->stride; by++) {
+                    for (unsigned char bx = 0; bx < this->stride; bx++) {
+                        for (unsigned char i = 0; i < 64 && by * 64 + i < this->size; i++) {
+                            this->words[(by * 64 + i) * this->stride + bx] = blocks[by][bx][i];
+                        }
+                    }
+                }
+            }
+            /** Apply one of the 8 symmetries of the square board in place (same numbering as blokus::boardTransforms)
+             *
+             * The odd transforms are exactly the ones that start with a transpose, so a caller needing several of them can transpose once and finish each with an even transform
+             * @param transform 0 = identity, 1/2/3 = rotate 90/180/270 degrees clockwise, 4 = mirror left-right, 5 = transpose, 6 = mirror top-bottom, 7 = anti-transpose
+             */
+            void transform(const unsigned char &transform) {
+                if (transform == 1 || transform == 3 || transform == 5 || transform == 7) {
+                    this->transpose();
+                }
+                if (transform == 1 || transform == 2 || transform == 4 || transform == 7) {
+                    this->mirrorX();
+                }
+                if (transform == 2 || transform == 3 || transform == 6 || transform == 7) {
+                    this->mirrorY();
+                }
+            }
+            /** Get the board after one of the 8 symmetries of the square board
+             * @param transform The symmetry to apply (see transform())
+             * @returns The transformed board
+             */
+            blokus::bitboard transformed(const unsigned char &transform) const {
+                blokus::bitboard output = *this;
+                output.transform(transform);
+                return output;
+            }
+
+            /** Find the first set cell in row-major order
+             * @param x Set to the x-position of the first set cell
+             * @param y Set to the y-position of the first set cell
+             * @returns Whether any cell is set (x and y are untouched if not)
+             */
+            bool findFirst(int &x, int &y) const {
+                for (std::size_t i = 0; i < this->words.size(); i++) {
+                    if (this->words[i] != 0) {
+                        x = (i % this->stride) * 64 + __builtin_ctzll(this->words[i]);
+                        y = i / this->stride;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /** Call a function for each set cell in row-major order
+             * @tparam Callback A callable taking (int x, int y)
+             * @param callback The function to call for each set cell
+             */
+            template <typename Callback> void forEach(Callback callback) const {
+                for (unsigned char y = 0; y < this->size; y++) {
+                    for (unsigned char w = 0; w < this->stride; w++) {
+                        std::uint64_t word = this->words[y * this->stride + w];
+                        while (word != 0) {
+                            callback(w * 64 + __builtin_ctzll(word), (int)y);
+                            word &= word - 1;
+                        }
+                    }
+                }
+            }
+    };
+}
+
+#endif // BLOKUS_BITBOARD_hpp
@@ -0,0 +1,435 @@
+#ifndef BLOKUS_BOARDVIEW_hpp
+#define BLOKUS_BOARDVIEW_hpp
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+
+#include "bengine.hpp"
+
+#include "blokus_player.hpp"
+
+namespace blokus {
+    typedef enum {
+        BOARDLOD_64 = 0,      // Tiles rendered at 64 px per cell (the tilesets' own size)
+        BOARDLOD_32 = 1,      // Tiles rendered at 32 px per cell
+        BOARDLOD_16 = 2,      // Tiles rendered at 16 px per cell
+        BOARDLOD_FLAT = 3     // Tiles rendered as flat colored cells at 4 px per cell; cheap enough to always render on the spot
+    } boardLevelsOfDetail;
+
+    /** A zoomable, pannable view of the board that draws from a cache of pre-rendered tiles
+     *
+     * The board is split into tiles of 16x16 cells, and each tile is rendered into its own texture at the level of detail that the current zoom needs (the smallest one that is not magnified, or flat colors when cells are too small for their edges to show).
+     * Only the tiles inside of the viewport are drawn, each as one quad; tiles are rendered straight into their own textures when first seen and only again (into the same texture) once a cell within them changes, and at most a few detailed tiles are rendered per frame so that zooming and panning never stall (coarser tiles stand in until then)
+     */
+    class boardView {
+        private:
+            /// @brief A rendered tile
+            struct tile {
+                /// @brief The tile's own render target; it is created once and rendered into again whenever the tile goes out of date
+                bengine::basicTexture texture;
+                /// @brief The last frame the tile was drawn in; the least recently drawn tiles are dropped first
+                std::uint64_t lastUsed = 0;
+                /// @brief Whether a cell within the tile changed since it was rendered (its texture is kept to render into again)
+                bool stale = false;
+            };
+
+            /// @brief The amount of cells along each side of a tile
+            static constexpr Uint16 tileCells = 16;
+            /// @brief The size of each cell within a tile at each level of detail (px)
+            static constexpr Uint16 levelCellSize[4] = {64, 32, 16, 4};
+
+            /// @brief Where the board is drawn on screen (px)
+            SDL_Rect viewport = {867, 27, 1026, 1026};
+            /// @brief The amount of cells along each side of the board
+            Uint16 size = 0;
+            /// @brief The amount of tiles along each side of the board
+            Uint16 tilesAcross = 0;
+
+            /// @brief The size of a cell on screen (px)
+            double zoom = 1;
+            /// @brief The smallest zoom; the whole board fits the viewport
+            double minZoom = 1;
+            /// @brief The largest zoom
+            double maxZoom = 128;
+            /// @brief Below this zoom, cells are drawn as flat colors
+            double flatBelow = 12;
+            /// @brief The column of the board at the left edge of the viewport (cells, fractional)
+            double originX = 0;
+            /// @brief The row of the board at the top edge of the viewport (cells, fractional)
+            double originY = 0;
+
+            /// @brief Rendered tiles keyed by tile index (high bits) and level of detail (low 2 bits)
+            std::unordered_map<std::uint32_t, tile> tiles = {};
+            /// @brief The most tiles kept at once
+            std::size_t maxTiles = 96;
+            /// @brief The most detailed tiles rendered in one frame
+            Uint8 tileBudget = 4;
+            /// @brief The color of empty cells in flat tiles
+            SDL_Color emptyColor = {85, 85, 85, 255};
+            /// @brief Counts calls to record(); used to find the least recently drawn tiles
+            std::uint64_t frame = 0;
+
+            /// @brief Keep the zoom within its limits and the viewport on the board (a board smaller than the viewport is centered)
+            void clampCamera() {
+                this->zoom = this->zoom < this->minZoom ? this->minZoom : (this->zoom > this->maxZoom ? this->maxZoom : this->zoom);
+                const double visibleX = this->viewport.w / this->zoom;
+                const double visibleY = this->viewport.h / this->zoom;
+                if (visibleX >= this->size) {
+                    this->originX = (this->size - visibleX) / 2;
+                } else {
+                    this->originX = this->originX < 0 ? 0 : (this->originX > this->size - visibleX ? this->size - visibleX : this->originX);
+                }
+                if (visibleY >= this->size) {
+                    this->originY = (this->size - visibleY) / 2;
+                } else {
+                    this->originY = this->originY < 0 ? 0 : (this->originY > this->size - visibleY ? this->size - visibleY : this->originY);
+                }
+            }
+            /** Get the level of detail that the current zoom needs
+             * @returns One of blokus::boardLevelsOfDetail
+             */
+            Uint8 currentLevel() const {
+                if (this->zoom < this->flatBelow) {
+                    return blokus::BOARDLOD_FLAT;
+                }
+                return this->zoom <= 16 ? blokus::BOARDLOD_16 : (this->zoom <= 32 ? blokus::BOARDLOD_32 : blokus::BOARDLOD_64);
+            }
+            /** Get the key of a tile at a level of detail
+             * @param tx The column of the tile
+             * @param ty The row of the tile
+             * @param level One of blokus::boardLevelsOfDetail
+             * @returns The key of the tile within tiles
+             */
+            std::uint32_t tileKey(const Uint16 &tx, const Uint16 &ty, const Uint8 &level) const {
+                return ((std::uint32_t)ty * this->tilesAcross + tx) << 2 | level;
+            }
+
+            /** Find a tile that is up to date
+             * @param tx The column of the tile
+             * @param ty The row of the tile
+             * @param level One of blokus::boardLevelsOfDetail
+             * @returns The tile, or tiles.end() if it is not cached or is stale
+             */
+            std::unordered_map<std::uint32_t, tile>::iterator findTile(const Uint16 &tx, const Uint16 &ty, const Uint8 &level) {
+                std::unordered_map<std::uint32_t, tile>::iterator output = this->tiles.find(this->tileKey(tx, ty, level));
+                return output == this->tiles.end() || output->second.stale ? this->tiles.end() : output;
+            }
+            /** Render one tile into its own texture, creating the texture the first time (must happen before anything else is drawn in the frame, as the render target is switched)
+             * @param target The tile to render into
+             * @param window The window to render with
+             * @param board The owner and autotile mask of every cell (as kept by blokus::game)
+             * @param players The players (for their colors)
+             * @param tx The column of the tile
+             * @param ty The row of the tile
+             * @param level One of blokus::boardLevelsOfDetail
+             * @param background The texture stretched behind the whole board
+             * @param emptyCell The texture of an empty cell
+             * @param baseTiles The tileset for the pieces' fill (frames and color are set while rendering)
+             * @param edgeTiles The tileset for the pieces' edges (frames are set while rendering)
+             * @returns Whether the tile could be rendered
+             */
+            bool renderTile(tile &target, bengine::window &window, const std::vector<std::vector<Uint8>> &board, const blokus::playerTable &players, const Uint16 &tx, const Uint16 &ty, const Uint8 &level, const bengine::basicTexture &background, const bengine::basicTexture &emptyCell, bengine::moddedTexture &baseTiles, bengine::basicTexture &edgeTiles) const {
+                const int cell = blokus::boardView::levelCellSize[level];
+                const Uint16 x0 = tx * tileCells, y0 = ty * tileCells;
+                const Uint16 cols = this->size - x0 < tileCells ? this->size - x0 : tileCells;
+                const Uint16 rows = this->size - y0 < tileCells ? this->size - y0 : tileCells;
+
+                if (target.texture.getHandle() == nullptr) {
+                    const bengine::textureHandle created = window.createTarget(cols * cell, rows * cell);
+                    if (created == nullptr) {
+                        return false;
+                    }
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+                    if (level == blokus::BOARDLOD_FLAT) {
+                        // Flat tiles are always magnified; filtering them would blur the borders between cells
+                        SDL_SetTextureScaleMode(created.get(), SDL_ScaleModeNearest);
+                    }
+#endif
+                    target.texture.setTexture(created);
+                }
+                if (window.targetTexture(target.texture.getHandle()) != 0) {
+                    window.targetWindow();
+                    return false;
+                }
+                window.clear();
+
+                if (level == blokus::BOARDLOD_FLAT) {
+                    // One rectangle per run of cells with the same owner along each row
+                    for (Uint16 i = 0; i < rows; i++) {
+                        Uint16 start = 0;
+                        for (Uint16 j = 1; j <= cols; j++) {
+                            const Uint8 owner = board[y0 + i][x0 + start] == 0 ? 0 : (board[y0 + i][x0 + start] - 1) / 16 + 1;
+                            if (j < cols && (board[y0 + i][x0 + j] == 0 ? 0 : (board[y0 + i][x0 + j] - 1) / 16 + 1) == owner) {
+                                continue;
+                            }
+                            window.fillRectangle(start * cell, i * cell, (j - start) * cell, cell, owner == 0 ? this->emptyColor : players.getColor(owner - 1));
+                            start = j;
+                        }
+                    }
+                } else {
+                    // The background is stretched over the whole board, so each tile shows its share of it
+                    bengine::basicTexture backgroundPart = background;
+                    const SDL_Rect frame = background.getFrame();
+                    backgroundPart.setFrame({frame.x + frame.w * x0 / this->size, frame.y + frame.h * y0 / this->size, frame.w * cols / this->size, frame.h * rows / this->size});
+                    window.renderBasicTexture(backgroundPart, {0, 0, cols * cell, rows * cell});
+
+                    for (Uint16 i = 0; i < rows; i++) {
+                        for (Uint16 j = 0; j < cols; j++) {
+                            const Uint8 value = board[y0 + i][x0 + j];
+                            if (value == 0) {
+                                window.renderBasicTexture(emptyCell, {j * cell, i * cell, cell, cell});
+                                continue;
+                            }
+                            const Uint8 cellId = (value - 1) / 16;
+                            const Uint8 cellMask = value - (cellId * 16) - 1;
+                            baseTiles.setColorMod(players.getColor(cellId));
+                            baseTiles.setFrame({cellMask % 4 * 64, cellMask / 4 * 64, 64, 64});
+                            edgeTiles.setFrame({cellMask % 4 * 64, cellMask / 4 * 64, 64, 64});
+                            window.renderModdedTexture(baseTiles, {j * cell, i * cell, cell, cell});
+                            window.renderBasicTexture(edgeTiles, {j * cell, i * cell, cell, cell});
+                        }
+                    }
+                }
+                window.targetWindow();
+                target.stale = false;
+                return true;
+            }
+            /// @brief Drop the least recently drawn tiles until no more than maxTiles are kept (tiles drawn this frame are always kept)
+            void evict() {
+                while (this->tiles.size() > this->maxTiles) {
+                    std::unordered_map<std::uint32_t, tile>::iterator oldest = this->tiles.end();
+                    for (std::unordered_map<std::uint32_t, tile>::iterator i = this->tiles.begin(); i != this->tiles.end(); i++) {
+                        if (i->second.lastUsed != this->frame && (oldest == this->tiles.end() || i->second.lastUsed < oldest->second.lastUsed)) {
+                            oldest = i;
+                        }
+                    }
+                    if (oldest == this->tiles.end()) {
+                        return;
+                    }
+                    this->tiles.erase(oldest);
+                }
+            }
+
+        public:
+            /** blokus::boardView constructor
+             * @param viewport Where the board is drawn on screen (px)
+             */
+            boardView(const SDL_Rect &viewport = {867, 27, 1026, 1026}) : viewport(viewport) {}
+            /// @brief blokus::boardView deconstructor
+            ~boardView() {}
+
+            /** Start viewing a (new) board; every cached tile is dropped and the whole board is fit to the viewport
+             * @param size The amount of cells along each side of the board
+             */
+            void reset(const Uint16 &size) {
+                this->size = size;
+                this->tilesAcross = (size + tileCells - 1) / tileCells;
+                this->tiles.clear();
+                this->minZoom = size == 0 ? 1 : (double)(this->viewport.w < this->viewport.h ? this->viewport.w : this->viewport.h) / size;
+                this->fit();
+            }
+            /// @brief Zoom all of the way out so that the whole board fits the viewport
+            void fit() {
+                this->zoom = this->minZoom;
+                this->clampCamera();
+            }
+            /** Zoom in or out while keeping the point under a screen position in place
+             * @param factor How much to multiply the zoom by
+             * @param x x-position on screen to zoom around (px)
+             * @param y y-position on screen to zoom around (px)
+             * @returns Whether the view changed
+             */
+            bool zoomAt(const double &factor, const int &x, const int &y) {
+                const double oldZoom = this->zoom, oldX = this->originX, oldY = this->originY;
+                const double cellX = this->originX + (x - this->viewport.x) / this->zoom;
+                const double cellY = this->originY + (y - this->viewport.y) / this->zoom;
+                this->zoom *= factor;
+                this->zoom = this->zoom < this->minZoom ? this->minZoom : (this->zoom > this->maxZoom ? this->maxZoom : this->zoom);
+                this->originX = cellX - (x - this->viewport.x) / this->zoom;
+                this->originY = cellY - (y - this->viewport.y) / this->zoom;
+                this->clampCamera();
+                return this->zoom != oldZoom || this->originX != oldX || this->originY != oldY;
+            }
+            /** Move the view by an amount of screen pixels
+             * @param dx How far to move right (px)
+             * @param dy How far to move down (px)
+             * @returns Whether the view changed (it stops at the edges of the board)
+             */
+            bool pan(const int &dx, const int &dy) {
+                const double oldX = this->originX, oldY = this->originY;
+                this->originX += dx / this->zoom;
+                this->originY += dy / this->zoom;
+                this->clampCamera();
+                return this->originX != oldX || this->originY != oldY;
+            }
+
+            /** Find the cell under a screen position
+             * @param x x-position on screen (px)
+             * @param y y-position on screen (px)
+             * @returns The cell under the position as row * size + column; UINT32_MAX as a sentinal value if it is off of the board
+             */
+            Uint32 cellAt(const int &x, const int &y) const {
+                if (x < this->viewport.x || y < this->viewport.y || x >= this->viewport.x + this->viewport.w || y >= this->viewport.y + this->viewport.h) {
+                    return UINT32_MAX;
+                }
+                const double col = std::floor(this->originX + (x - this->viewport.x) / this->zoom);
+                const double row = std::floor(this->originY + (y - this->viewport.y) / this->zoom);
+                if (col < 0 || row < 0 || col >= this->size || row >= this->size) {
+                    return UINT32_MAX;
+                }
+                return (Uint32)row * this->size + (Uint32)col;
+            }
+
+            /** Mark the tiles holding a cell and its neighbors as out of date (a cell's autotile mask depends on its neighbors)
+             * @param x The column of the cell
+             * @param y The row of the cell
+             */
+            void invalidate(const Uint16 &x, const Uint16 &y) {
+                for (int ty = (y == 0 ? 0 : y - 1) / tileCells; ty <= (y + 1 < this->size ? y + 1 : y) / tileCells; ty++) {
+                    for (int tx = (x == 0 ? 0 : x - 1) / tileCells; tx <= (x + 1 < this->size ? x + 1 : x) / tileCells; tx++) {
+                        for (Uint8 level = blokus::BOARDLOD_64; level <= blokus::BOARDLOD_FLAT; level++) {
+                            std::unordered_map<std::uint32_t, tile>::iterator found = this->tiles.find(this->tileKey(tx, ty, level));
+                            if (found != this->tiles.end()) {
+                                found->second.stale = true;
+                            }
+                        }
+                    }
+                }
+            }
+            /// @brief Mark every tile as out of date
+            void invalidateAll() {
+                for (std::unordered_map<std::uint32_t, tile>::iterator i = this->tiles.begin(); i != this->tiles.end(); i++) {
+                    i->second.stale = true;
+                }
+            }
+
+            /** Record the visible part of the board into the window's command list, rendering any tiles that are missing first (so call this before anything is drawn in the frame)
+             * @param window The window to render and record with
+             * @param board The owner and autotile mask of every cell (as kept by blokus::game)
+             * @param players The players (for their colors)
+             * @param background The texture stretched behind the whole board
+             * @param emptyCell The texture of an empty cell
+             * @param baseTiles The tileset for the pieces' fill
+             * @param edgeTiles The tileset for the pieces' edges
+             * @returns Whether every visible tile was drawn at the level of detail the zoom needs; if not, coarser tiles stood in and recording again next frame will refine them
+             */
+            bool record(bengine::window &window, const std::vector<std::vector<Uint8>> &board, const blokus::playerTable &players, const bengine::basicTexture &background, const bengine::basicTexture &emptyCell, bengine::moddedTexture &baseTiles, bengine::basicTexture &edgeTiles) {
+                if (this->size == 0) {
+                    return true;
+                }
+                this->frame++;
+                const Uint8 level = this->currentLevel();
+                Uint8 budget = this->tileBudget;
+                bool complete = true;
+
+                const double right = this->originX + this->viewport.w / this->zoom;
+                const double bottom = this->originY + this->viewport.h / this->zoom;
+                const int tx1 = this->originX < 0 ? 0 : (int)(this->originX / tileCells);
+                const int ty1 = this->originY < 0 ? 0 : (int)(this->originY / tileCells);
+                const int tx2 = right >= this->size ? this->tilesAcross - 1 : (int)(right / tileCells);
+                const int ty2 = bottom >= this->size ? this->tilesAcross - 1 : (int)(bottom / tileCells);
+
+                for (int ty = ty1; ty <= ty2; ty++) {
+                    for (int tx = tx1; tx <= tx2; tx++) {
+                        // Use the wanted level if it is cached or there is budget left for it, otherwise the most detailed level that is cached, otherwise flat colors (always affordable)
+                        Uint8 used = level;
+                        std::unordered_map<std::uint32_t, tile>::iterator found = this->findTile(tx, ty, level);
+                        if (found == this->tiles.end() && level != blokus::BOARDLOD_FLAT && budget == 0) {
+                            complete = false;
+                            for (used = blokus::BOARDLOD_64; used <= blokus::BOARDLOD_FLAT; used++) {
+                                if ((found = this->findTile(tx, ty, used)) != this->tiles.end()) {
+                                    break;
+                                }
+                            }
+                            used = used > blokus::BOARDLOD_FLAT ? blokus::BOARDLOD_FLAT : used;
+                        }
+                        if (found == this->tiles.end()) {
+                            if (used != blokus::BOARDLOD_FLAT) {
+                                budget--;
+                            }
+                            found = this->tiles.emplace(this->tileKey(tx, ty, used), tile()).first;
+                            if (!this->renderTile(found->second, window, board, players, tx, ty, used, background, emptyCell, baseTiles, edgeTiles)) {
+                                this->tiles.erase(found);
+                                complete = false;
+                                continue;
+                            }
+                        }
+                        found->second.lastUsed = this->frame;
+
+                        // Round both edges of the tile the same way its neighbors do so that no seams open up between them, then clip it to the viewport
+                        const Uint16 cols = this->size - tx * tileCells < tileCells ? this->size - tx * tileCells : tileCells;
+                        const Uint16 rows = this->size - ty * tileCells < tileCells ? this->size - ty * tileCells : tileCells;
+                        const double left = this->viewport.x + (tx * tileCells - this->originX) * this->zoom;
+                        const double top = this->viewport.y + (ty * tileCells - this->originY) * this->zoom;
+                        const int x1 = (int)std::lround(left), y1 = (int)std::lround(top);
+                        const int x2 = (int)std::lround(left + cols * this->zoom), y2 = (int)std::lround(top + rows * this->zoom);
+                        const int cx1 = x1 > this->viewport.x ? x1 : this->viewport.x;
+                        const int cy1 = y1 > this->viewport.y ? y1 : this->viewport.y;
+                        const int cx2 = x2 < this->viewport.x + this->viewport.w ? x2 : this->viewport.x + this->viewport.w;
+                        const int cy2 = y2 < this->viewport.y + this->viewport.h ? y2 : this->viewport.y + this->viewport.h;
+                        if (cx2 <= cx1 || cy2 <= cy1) {
+                            continue;
+                        }
+                        const double texels = (double)blokus::boardView::levelCellSize[used] / this->zoom;
+                        bengine::basicTexture part = found->second.texture;
+                        part.setFrame({(int)((cx1 - left) * texels), (int)((cy1 - top) * texels), (int)std::ceil((cx2 - cx1) * texels), (int)std::ceil((cy2 - cy1) * texels)});
+                        window.recordBasicTexture(part, {cx1, cy1, cx2 - cx1, cy2 - cy1});
+                    }
+                }
+
+                this->evict();
+                return complete;
+            }
+
+            /** Get the size of a cell on screen
+             * @returns The zoom (px per cell)
+             */
+            double getZoom() const {
+                return this->zoom;
+            }
+            /** Get where the board is drawn on screen
+             * @returns The viewport (px)
+             */
+            SDL_Rect getViewport() const {
+                return this->viewport;
+            }
+            /** Get the amount of tiles currently cached
+             * @returns The amount of cached tiles (over every level of detail)
+             */
+            std::size_t getTileCount() const {
+                return this->tiles.size();
+            }
+            /** Set the zoom below which cells are drawn as flat colors
+             * @param flatBelow The new zoom (px per cell)
+             * @returns The old zoom (px per cell)
+             */
+            double setFlatThreshold(const double &flatBelow) {
+                const double output = this->flatBelow;
+                this->flatBelow = flatBelow;
+                return output;
+            }
+            /** Set the most detailed tiles rendered in one frame (flat tiles are not counted)
+             * @param tileBudget The new most tiles per frame
+             * @returns The old most tiles per frame
+             */
+            Uint8 setTileBudget(const Uint8 &tileBudget) {
+                const Uint8 output = this->tileBudget;
+                this->tileBudget = tileBudget;
+                return output;
+            }
+            /** Set the most tiles kept at once (a 64 px per cell tile is 1024x1024)
+             * @param maxTiles The new most tiles kept at once
+             * @returns The old most tiles kept at once
+             */
+            std::size_t setMaxTiles(const std::size_t &maxTiles) {
+                const std::size_t output = this->maxTiles;
+                this->maxTiles = maxTiles;
+                return output;
+            }
+    };
+}
+
+#endif // BLOKUS_BOARDVIEW_hpp
@@ -0,0 +1,208 @@
+#ifndef BLOKUS_BOOK_hpp
+#define BLOKUS_BOOK_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include "blokus_file.hpp"
+#include "blokus_state.hpp"
+#include "blokus_symmetry.hpp"
+
+namespace blokus {
+    /// @brief The version of the opening book file format
+    const std::uint32_t bookVersion = 2;
+
+    /// @brief The header at the start of an opening book file
+    struct bookHeader {
+        /// @brief Always "BLKBOOK" followed by a null character
+        char magic[8] = {'B', 'L', 'K', 'B', 'O', 'O', 'K', '\0'};
+        /// @brief The version of the file format (blokus::bookVersion)
+        std::uint32_t version = blokus::bookVersion;
+        /// @brief The amount of entries following the header
+        std::uint32_t entryCount = 0;
+        /// @brief The side length of the board the book was built for
+        std::uint8_t size = 20;
+        /// @brief The amount of players the book was built for
+        std::uint8_t playerCount = 4;
+        /// @brief The amount of base, hexomino, heptomino, and octomino sets the book was built for
+        std::uint8_t sets[4] = {1, 0, 0, 0};
+        /// @brief The amount of plies from the start position the book covers
+        std::uint8_t plies = 0;
+        std::uint8_t reserved = 0;
+        std::uint64_t reserved2 = 0;
+    };
+
+    /// @brief A single position within an opening book; entries are sorted by key so they can be binary searched straight out of the file
+    struct bookEntry {
+        /// @brief The symmetry-canonical hash of the position (see blokus::canonicalHash())
+        std::uint64_t key = 0;
+        /// @brief The global id of the polyomino to play
+        std::uint16_t polyomino = 0;
+        /// @brief The orientation of the polyomino, relative to the canonical form of the position
+        std::uint8_t orientation = 0;
+        /// @brief x-position of the move, relative to the canonical form of the position
+        std::uint8_t x = 0;
+        /// @brief y-position of the move, relative to the canonical form of the position
+        std::uint8_t y = 0;
+        /// @brief The amount of games the move was played in (saturates at 255)
+        std::uint8_t games = 0;
+        /// @brief The average final margin (own tiles minus the best opponent's) of the games the move was played in
+        std::int16_t score = 0;
+    };
+
+    static_assert(sizeof(blokus::bookHeader) == 32, "blokus::bookHeader must match the file layout");
+    static_assert(sizeof(blokus::bookEntry) == 16, "blokus::bookEntry must match the file layout");
+
+    /** Read-only opening book
+     *
+     * The file is opened through blokus::mappedFile and entries are looked up with a binary search, so opening a book costs next to nothing.
+     * Positions are stored under their symmetry-canonical hash, so a line is found no matter which corner the game was rotated/mirrored onto
+     */
+    class openingBook {
+        private:
+            /// @brief The header of the open file
+            blokus::bookHeader header;
+            /// @brief The sorted entries of the open file
+            const blokus::bookEntry *entries = nullptr;
+            /// @brief The amount of entries within the open file
+            std::size_t count = 0;
+
+            /// @brief The open file
+            blokus::mappedFile file;
+
+        public:
+            openingBook() {}
+            /** blokus::openingBook constructor
+             * @param path The path of the book file to open
+             */
+            openingBook(const std::string &path) {
+                this->open(path);
+            }
+            ~openingBook() {
+                this->close();
+            }
+            openingBook(const blokus::openingBook &) = delete;
+            blokus::openingBook &operator=(const blokus::openingBook &) = delete;
+
+            /** Open a book file (closing the current one)
+             * @param path The path of the book file to open
+             * @returns Whether the book was opened
+             */
+            bool open(const std::string &path) {
+                this->close();
+
+                if (!this->file.open(path)) {
+                    return false;
+                }
+                if (this->file.size() < sizeof(blokus::bookHeader)) {
+                    std::cout << "ERROR: \"" << path << "\" is not an opening book\n";
+                    this->close();
+                    return false;
+                }
+                std::memcpy(&this->header, this->file.data(), sizeof(blokus::bookHeader));
+                if (std::memcmp(this->header.magic, blokus::bookHeader().magic, 8) != 0 || this->header.version != blokus::bookVersion) {
+                    std::cout << "ERROR: \"" << path << "\" is not a version " << blokus::bookVersion << " opening book\n";
+                    this->close();
+                    return false;
+                }
+                if (sizeof(blokus::bookHeader) + (std::size_t)this->header.entryCount * sizeof(blokus::bookEntry) > this->file.size()) {
+                    std::cout << "ERROR: Opening book \"" << path << "\" is truncated\n";
+                    this->close();
+                    return false;
+                }
+                this->entries = (const blokus::bookEntry *)(this->file.data() + sizeof(blokus::bookHeader));
+                this->count = this->header.entryCount;
+                return true;
+            }
+            /// @brief Close the current book file
+            void close() {
+                this->file.close();
+                this->entries = nullptr;
+                this->count = 0;
+                this->header = blokus::bookHeader();
+            }
+
+            /** Check whether a book is open
+             * @returns Whether a book is open
+             */
+            bool isOpen() const {
+                return this->entries != nullptr;
+            }
+            /** Get the header of the open book
+             * @returns The header of the open book
+             */
+            const blokus::bookHeader &getHeader() const {
+                return this->header;
+            }
+            /** Get the amount of positions within the open book
+             * @returns The amount of positions within the open book
+             */
+            std::size_t size() const {
+                return this->count;
+            }
+
+            /** Find the entry for a canonical position key
+             * @param key The canonical hash of the position
+             * @returns A pointer to the entry, or nullptr if the position is not in the book
+             */
+            const blokus::bookEntry *find(const std::uint64_t &key) const {
+                const blokus::bookEntry *end = this->entries + this->count;
+                const blokus::bookEntry *output = std::lower_bound(this->entries, end, key, [](const blokus::bookEntry &entry, const std::uint64_t &value) {
+                    return entry.key < value;
+                });
+                return output != end && output->key == key ? output : nullptr;
+            }
+
+            /** Look up the book move for the player to move
+             * @param s The state to look up
+             * @param output Set to the book move (mapped back from the canonical form of the position)
+             * @returns Whether a legal book move was found
+             */
+            bool lookup(const blokus::state &s, blokus::move &output) const {
+                if (!this->isOpen() || s.getSize() != this->header.size || s.getPlayerCount() != this->header.playerCount || s.getPly() >= this->header.plies) {
+                    return false;
+                }
+
+                unsigned char transform;
+                const blokus::bookEntry *entry = this->find(blokus::canonicalHash(s, transform));
+                if (entry == nullptr) {
+                    return false;
+                }
+                const blokus::move canonical = {entry->polyomino, entry->orientation, entry->x, entry->y};
+                output = blokus::transformMove(canonical, blokus::inverseTransforms[transform], s.getSize());
+                return s.isLegal(s.getTurn(), output);
+            }
+
+            /** Write a book file
+             * @param path The path of the file to write
+             * @param header The header of the book (entryCount is filled in)
+             * @param entries The entries of the book (sorted before writing; duplicate keys keep their first entry)
+             * @returns Whether the file was written
+             */
+            static bool write(const std::string &path, blokus::bookHeader header, std::vector<blokus::bookEntry> entries) {
+                std::stable_sort(entries.begin(), entries.end(), [](const blokus::bookEntry &a, const blokus::bookEntry &b) {
+                    return a.key < b.key;
+                });
+                entries.erase(std::unique(entries.begin(), entries.end(), [](const blokus::bookEntry &a, const blokus::bookEntry &b) {
+                    return a.key == b.key;
+                }), entries.end());
+                header.entryCount = entries.size();
+
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) {
+                    std::cout << "ERROR: Could not write opening book \"" << path << "\"\n";
+                    return false;
+                }
+                file.write((const char *)&header, sizeof(blokus::bookHeader));
+                file.write((const char *)entries.data(), entries.size() * sizeof(blokus::bookEntry));
+                return file.good();
+            }
+    };
+}
+
+#endif // BLOKUS_BOOK_hpp
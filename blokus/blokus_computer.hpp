@@ -0,0 +1,90 @@
+#ifndef BLOKUS_COMPUTER_hpp
+#define BLOKUS_COMPUTER_hpp
+
+#include <vector>
+#include <cstdlib>
+
+#include "btils_memory.hpp"
+
+#include "blokus_state.hpp"
+#include "blokus_endgame.hpp"
+#include "blokus_book.hpp"
+
+namespace blokus {
+    /// @brief A computer-controlled player; plays from its opening book, then a greedy heuristic until the endgame solver can take over
+    class computer {
+        private:
+            /// @brief The exact solver used once few enough moves remain
+            blokus::endgameSolver solver;
+            /// @brief The opening book consulted before anything else (not owned; nullptr for none)
+            const blokus::openingBook *book = nullptr;
+
+        public:
+            /** Score a move with a cheap heuristic (bigger pieces first, then placements closer to the middle of the board)
+             * @param s The state the move would be played in
+             * @param m The move to score
+             * @returns The heuristic score of the move (higher is better)
+             */
+            static int heuristic(const blokus::state &s, const blokus::move &m) {
+                const blokus::orientation &o = blokus::orientations(m.polyomino).at(m.orientation);
+                const int centerX = m.x * 2 + o.width;
+                const int centerY = m.y * 2 + o.height;
+                return (int)o.cellCount * 1000 - std::abs(centerX - s.getSize()) - std::abs(centerY - s.getSize());
+            }
+
+            /** blokus::computer constructor
+             * @param endgameThreshold The most legal moves (summed over every player still in the game) a position may have for the endgame solver to take over
+             */
+            computer(const std::size_t &endgameThreshold = 24) : solver(endgameThreshold) {}
+
+            /** Choose a move for the player to move
+             * @param s The state to choose a move in (left unchanged)
+             * @returns The chosen move (a pass if the player has no legal moves)
+             */
+            blokus::move chooseMove(blokus::state &s) {
+                blokus::move bookMove;
+                if (this->book != nullptr && this->book->lookup(s, bookMove)) {
+                    return bookMove;
+                }
+
+                if (this->solver.applies(s)) {
+                    const blokus::endgameResult result = this->solver.solve(s);
+                    if (result.solved) {
+                        return result.best;
+                    }
+                }
+
+                const btils::arenaScope scope(btils::threadArena());
+                btils::arenaList<blokus::move> moves(btils::threadArena());
+                s.legalMoves(moves);
+                if (moves.size() == 0) {
+                    return blokus::move::pass();
+                }
+                std::size_t best = 0;
+                int bestScore = blokus::computer::heuristic(s, moves[0]);
+                for (std::size_t i = 1; i < moves.size(); i++) {
+                    const int score = blokus::computer::heuristic(s, moves[i]);
+                    if (score > bestScore) {
+                        best = i;
+                        bestScore = score;
+                    }
+                }
+                return moves[best];
+            }
+
+            /** Get the endgame solver used by the player
+             * @returns The endgame solver used by the player
+             */
+            blokus::endgameSolver &getSolver() {
+                return this->solver;
+            }
+            /** Set the opening book consulted before searching
+             * @param book The opening book (must outlive the player; nullptr for none)
+             */
+            void setBook(const blokus::openingBook *book) {
+                this->book = book;
+            }
+    };
+}
+
+#endif // BLOKUS_COMPUTER_hpp
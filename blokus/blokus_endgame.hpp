@@ -0,0 +1,318 @@
+#ifndef BLOKUS_ENDGAME_hpp
+#define BLOKUS_ENDGAME_hpp
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+#include <functional>
+
+#include "btils_memory.hpp"
+
+#include "blokus_bitboard.hpp"
+#include "blokus_state.hpp"
+#include "blokus_regions.hpp"
+#include "blokus_symmetry.hpp"
+
+namespace blokus {
+    /// @brief The outcome of an exhaustively solved position
+    struct endgameResult {
+        /// @brief The final amount of tiles each player will have placed under optimal play
+        unsigned short tiles[blokus::maxPlayers] = {0, 0, 0, 0};
+        /// @brief The optimal move for the player to move (a pass if they have none)
+        blokus::move best = blokus::move::pass();
+        /// @brief Whether the search finished; an unsolved result is only a partial answer and should not be trusted
+        bool solved = false;
+    };
+
+    /** Exact solver for the last few moves of a game
+     *
+     * Every player is assumed to maximize their own final tile count (ties are broken by minimizing the best opponent's count); results are memoised by symmetry-canonical key, so rotated/mirrored positions share entries.
+     * Players whose reachable cells cannot overlap (see blokus::regionMap) are split into independent groups and solved separately, which removes the cross-product of their moves from the search.
+     */
+    class endgameSolver {
+        private:
+            /// @brief The most legal moves (summed over every player still in the game) a position may have for the solver to take over
+            std::size_t threshold = 24;
+            /// @brief The most nodes a single solve may visit before giving up
+            std::size_t nodeLimit = 2000000;
+            /// @brief The most entries the memo table may hold before being cleared
+            std::size_t maxEntries = 1 << 20;
+
+            typedef std::pair<const std::uint64_t, blokus::endgameResult> tableEntry;
+            typedef std::unordered_map<std::uint64_t, blokus::endgameResult, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, btils::poolAllocator<tableEntry>> tableType;
+
+            /// @brief The working space of one depth of the search
+            struct ply {
+                /// @brief The regions of the position at this depth (filled in by the parent before descending)
+                blokus::regionMap regions;
+                /// @brief The canonical form of the position at this depth
+                blokus::canonicalPosition canonical;
+                /// @brief Working space for canonicalizing the position
+                blokus::canonicalBuffer canonicalScratch;
+            };
+
+            /// @brief The move lists of every node on the current line (rewound as the search backs up, reset by each solve)
+            btils::arena moveArena;
+            /// @brief The working space of each depth of the current line; kept between solves and only grown when a line goes deeper than any before it (a deque so growing never moves the plies still in use)
+            std::deque<ply> plies;
+            /// @brief The nodes of the memo table; sized for an entry plus the hash table's link and cached hash
+            btils::blockPool entryPool;
+            /// @brief Memoised results (stored relative to the canonical form of the position) keyed by canonical key mixed with the set of players being solved for
+            tableType table;
+            /// @brief The amount of nodes visited by the current/last solve
+            std::size_t nodes = 0;
+            /// @brief Whether the current solve ran out of nodes
+            bool aborted = false;
+
+            /** Fill a result with the tiles currently placed by each player
+             * @param s The state to read from
+             * @param output The result to fill
+             */
+            static void fillPlaced(const blokus::state &s, blokus::endgameResult &output) {
+                for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                    output.tiles[i] = s.getPlacedTiles(i);
+                }
+            }
+
+            /** Check whether one result is better than another for a player
+             * @param lhs The candidate result
+             * @param rhs The current best result
+             * @param player The player choosing between the results
+             * @param playerCount The amount of players in the game
+             * @returns Whether lhs is strictly better than rhs for the player
+             */
+            static bool better(const blokus::endgameResult &lhs, const blokus::endgameResult &rhs, const unsigned char &player, const unsigned char &playerCount) {
+                if (lhs.tiles[player] != rhs.tiles[player]) {
+                    return lhs.tiles[player] > rhs.tiles[player];
+                }
+                unsigned short lhsOpponent = 0, rhsOpponent = 0;
+                for (unsigned char i = 0; i < playerCount; i++) {
+                    if (i == player) {
+                        continue;
+                    }
+                    lhsOpponent = lhs.tiles[i] > lhsOpponent ? lhs.tiles[i] : lhsOpponent;
+                    rhsOpponent = rhs.tiles[i] > rhsOpponent ? rhs.tiles[i] : rhsOpponent;
+                }
+                return lhsOpponent < rhsOpponent;
+            }
+
+            /** Get the working space of a depth, making room for it if the search has not been this deep before
+             * @param depth The depth
+             * @returns The working space of the depth
+             */
+            ply &plyAt(const std::size_t &depth) {
+                while (this->plies.size() <= depth) {
+                    this->plies.emplace_back();
+                }
+                return this->plies[depth];
+            }
+
+            /** Solve a state for a set of players (every other player is made to pass)
+             * @param s The state to solve (restored before returning)
+             * @param depth The depth of the state within the search; plyAt(depth).regions must hold its regions, which are used to split the players into independent groups
+             * @param mask A bitmask of the players to solve for
+             * @returns The optimal result for the players within the mask
+             */
+            blokus::endgameResult search(blokus::state &s, const std::size_t &depth, const unsigned char &mask) {
+                blokus::endgameResult output;
+                this->nodes++;
+                if (this->nodes > this->nodeLimit) {
+                    this->aborted = true;
+                    return output;
+                }
+                if (s.isOver()) {
+                    blokus::endgameSolver::fillPlaced(s, output);
+                    output.solved = true;
+                    return output;
+                }
+
+                // Children work on the next ply's copy of the regions, which is updated in place
+                ply &current = this->plyAt(depth);
+                ply &next = this->plyAt(depth + 1);
+                const unsigned char player = s.getTurn();
+                if (((mask >> player) & 1) == 0) {
+                    s.play(blokus::move::pass());
+                    next.regions.assign(current.regions);
+                    next.regions.update(s, blokus::move::pass(), player);
+                    output = this->search(s, depth + 1, mask);
+                    s.undo();
+                    output.best = blokus::move::pass();
+                    return output;
+                }
+
+                const blokus::canonicalPosition &canonical = current.canonical;
+                blokus::canonicalize(s, current.canonical, current.canonicalScratch);
+                unsigned char canonicalMask = 0;
+                for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                    canonicalMask |= ((mask >> i) & 1) << canonical.permutation[i];
+                }
+                const std::uint64_t key = canonical.key ^ (0x9E3779B97F4A7C15ULL * (canonicalMask + 1));
+                const tableType::const_iterator found = this->table.find(key);
+                if (found != this->table.end()) {
+                    for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                        output.tiles[i] = found->second.tiles[canonical.permutation[i]];
+                    }
+                    output.best = blokus::transformMove(found->second.best, blokus::inverseTransforms[canonical.transform], s.getSize());
+                    output.solved = found->second.solved;
+                    return output;
+                }
+
+                // Split the players into independent groups and solve each on its own
+                const unsigned char active = mask & ~s.getPassed();
+                unsigned char groups[blokus::maxPlayers] = {0, 0, 0, 0};
+                const unsigned char groupCount = current.regions.interactionGroups(active, groups);
+                if (groupCount > 1) {
+                    blokus::endgameSolver::fillPlaced(s, output);
+                    // Nothing is played before descending, so every group can share one copy of the regions
+                    next.regions.assign(current.regions);
+                    for (unsigned char g = 0; g < groupCount && !this->aborted; g++) {
+                        const blokus::endgameResult part = this->search(s, depth + 1, groups[g]);
+                        for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                            if ((groups[g] >> i) & 1) {
+                                output.tiles[i] = part.tiles[i];
+                            }
+                        }
+                        if ((groups[g] >> player) & 1) {
+                            output.best = part.best;
+                        }
+                    }
+                } else {
+                    const btils::arenaScope scope(this->moveArena);
+                    btils::arenaList<blokus::move> moves(this->moveArena);
+                    s.legalMoves(player, moves);
+                    if (moves.size() == 0) {
+                        moves.push_back(blokus::move::pass());
+                    }
+                    bool first = true;
+                    for (std::size_t i = 0; i < moves.size() && !this->aborted; i++) {
+                        s.play(moves[i]);
+                        next.regions.assign(current.regions);
+                        next.regions.update(s, moves[i], player);
+                        const blokus::endgameResult child = this->search(s, depth + 1, mask);
+                        s.undo();
+                        if (first || blokus::endgameSolver::better(child, output, player, s.getPlayerCount())) {
+                            output = child;
+                            output.best = moves[i];
+                            first = false;
+                        }
+                    }
+                }
+
+                if (this->aborted) {
+                    output.solved = false;
+                    return output;
+                }
+                output.solved = true;
+                if (this->table.size() >= this->maxEntries) {
+                    this->table.clear();
+                }
+                blokus::endgameResult &stored = this->table[key];
+                for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                    stored.tiles[canonical.permutation[i]] = output.tiles[i];
+                }
+                stored.best = blokus::transformMove(output.best, canonical.transform, s.getSize());
+                stored.solved = true;
+                return output;
+            }
+
+        public:
+            /** blokus::endgameSolver constructor
+             * @param threshold The most legal moves (summed over every player still in the game) a position may have for the solver to take over
+             * @param nodeLimit The most nodes a single solve may visit before giving up
+             */
+            endgameSolver(const std::size_t &threshold = 24, const std::size_t &nodeLimit = 2000000) : threshold(threshold), nodeLimit(nodeLimit), moveArena(1 << 16), entryPool(sizeof(tableEntry) + 2 * sizeof(void *)), table(0, std::hash<std::uint64_t>(), std::equal_to<std::uint64_t>(), btils::poolAllocator<tableEntry>(entryPool)) {}
+
+            /** Check whether a state is far enough into the endgame for the solver to take over
+             * @param s The state to check
+             * @returns Whether the total amount of legal moves is at most the solver's threshold
+             */
+            bool applies(const blokus::state &s) const {
+                if (s.isOver()) {
+                    return false;
+                }
+                std::size_t remaining = this->threshold + 1;
+                for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                    if (s.hasPassed(i)) {
+                        continue;
+                    }
+                    remaining -= s.countLegalMoves(i, remaining);
+                    if (remaining == 0) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /** Solve a state exactly
+             * @param s The state to solve (left unchanged)
+             * @returns The final tile counts under optimal play and the best move for the player to move; check endgameResult::solved before trusting it
+             */
+            blokus::endgameResult solve(blokus::state &s) {
+                this->nodes = 0;
+                this->aborted = false;
+                this->moveArena.reset();
+                this->plyAt(0).regions.rebuild(s);
+                blokus::endgameResult output = this->search(s, 0, (1 << s.getPlayerCount()) - 1);
+                output.solved = !this->aborted;
+                return output;
+            }
+
+            /// @brief Forget every memoised result
+            void clear() {
+                this->table.clear();
+            }
+
+            /** Get the counters of the arena holding the search's move lists
+             * @returns The arena's counters
+             */
+            const btils::allocationStats &getMoveStats() const {
+                return this->moveArena.getStats();
+            }
+            /** Get the counters of the pool holding the memo table's entries
+             * @returns The pool's counters
+             */
+            const btils::allocationStats &getTableStats() const {
+                return this->entryPool.getStats();
+            }
+
+            /** Get the amount of nodes visited by the last solve
+             * @returns The amount of nodes visited by the last solve
+             */
+            std::size_t getNodes() const {
+                return this->nodes;
+            }
+            /** Get the move-count threshold at which the solver takes over
+             * @returns The move-count threshold
+             */
+            std::size_t getThreshold() const {
+                return this->threshold;
+            }
+            /** Set the move-count threshold at which the solver takes over
+             * @param threshold The new move-count threshold
+             * @returns The old move-count threshold
+             */
+            std::size_t setThreshold(const std::size_t &threshold) {
+                const std::size_t output = this->threshold;
+                this->threshold = threshold;
+                return output;
+            }
+            /** Get the most nodes a single solve may visit
+             * @returns The node limit
+             */
+            std::size_t getNodeLimit() const {
+                return this->nodeLimit;
+            }
+            /** Set the most nodes a single solve may visit
+             * @param nodeLimit The new node limit
+             * @returns The old node limit
+             */
+            std::size_t setNodeLimit(const std::size_t &nodeLimit) {
+                const std::size_t output = this->nodeLimit;
+                this->nodeLimit = nodeLimit;
+                return output;
+            }
+    };
+}
+
+#endif // BLOKUS_ENDGAME_hpp
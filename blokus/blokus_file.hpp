@@ -0,0 +1,130 @@
+#ifndef BLOKUS_FILE_hpp
+#define BLOKUS_FILE_hpp
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace blokus {
+    /// @brief A read-only view of a whole file; memory-mapped where possible (POSIX) and read into memory otherwise
+    class mappedFile {
+        private:
+            /// @brief The start of the file's contents
+            const char *contents = nullptr;
+            /// @brief The size of the file in bytes
+            std::size_t length = 0;
+            /// @brief Whether a file is open
+            bool opened = false;
+            /// @brief Whether contents points at a mapping (rather than into fallback)
+            bool mapped = false;
+            /// @brief The contents of the file when it could not be mapped
+            std::vector<char> fallback = {};
+
+        public:
+            mappedFile() {}
+            /** blokus::mappedFile constructor
+             * @param path The path of the file to open
+             */
+            mappedFile(const std::string &path) {
+                this->open(path);
+            }
+            ~mappedFile() {
+                this->close();
+            }
+            mappedFile(const blokus::mappedFile &) = delete;
+            blokus::mappedFile &operator=(const blokus::mappedFile &) = delete;
+
+            /** Open a file (closing the current one)
+             * @param path The path of the file to open
+             * @returns Whether the file was opened
+             */
+            bool open(const std::string &path) {
+                this->close();
+
+                #if !defined(_WIN32)
+                const int descriptor = ::open(path.c_str(), O_RDONLY);
+                if (descriptor < 0) {
+                    std::cout << "ERROR: Could not open \"" << path << "\"\n";
+                    return false;
+                }
+                struct stat info;
+                if (fstat(descriptor, &info) != 0) {
+                    std::cout << "ERROR: Could not read \"" << path << "\"\n";
+                    ::close(descriptor);
+                    return false;
+                }
+                if (info.st_size > 0) {
+                    void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                    if (mapping != MAP_FAILED) {
+                        ::close(descriptor);
+                        this->contents = (const char *)mapping;
+                        this->length = info.st_size;
+                        this->mapped = true;
+                        this->opened = true;
+                        return true;
+                    }
+                }
+                ::close(descriptor);
+                #endif
+
+                std::ifstream file(path, std::ios::binary | std::ios::ate);
+                if (!file.is_open()) {
+                    std::cout << "ERROR: Could not open \"" << path << "\"\n";
+                    return false;
+                }
+                this->fallback.resize(file.tellg());
+                file.seekg(0);
+                if (!file.read(this->fallback.data(), this->fallback.size())) {
+                    std::cout << "ERROR: Could not read \"" << path << "\"\n";
+                    this->fallback.clear();
+                    return false;
+                }
+                this->contents = this->fallback.data();
+                this->length = this->fallback.size();
+                this->opened = true;
+                return true;
+            }
+            /// @brief Close the current file
+            void close() {
+                #if !defined(_WIN32)
+                if (this->mapped) {
+                    munmap((void *)this->contents, this->length);
+                }
+                #endif
+                this->contents = nullptr;
+                this->length = 0;
+                this->opened = false;
+                this->mapped = false;
+                this->fallback.clear();
+            }
+
+            /** Check whether a file is open
+             * @returns Whether a file is open
+             */
+            bool isOpen() const {
+                return this->opened;
+            }
+            /** Get the contents of the file
+             * @returns A pointer to the first byte of the file
+             */
+            const char *data() const {
+                return this->contents;
+            }
+            /** Get the size of the file
+             * @returns The size of the file in bytes
+             */
+            std::size_t size() const {
+                return this->length;
+            }
+    };
+}
+
+#endif // BLOKUS_FILE_hpp
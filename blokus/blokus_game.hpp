@@ -8,20 +8,39 @@
 #include <vector>
 #include <cmath>
 #include <ctime>
+#include <cstring>
+#include <string>
 
 #include "btils.hpp"
 #include "bengine.hpp"
 
 #include "blokus_polyominoes.hpp"
+#include "blokus_bitboard.hpp"
 #include "blokus_piece.hpp"
 #include "blokus_player.hpp"
+#include "blokus_snapshot.hpp"
+#include "blokus_thumbnails.hpp"
+#include "blokus_boardview.hpp"
 
 namespace blokus {
     class game : public bengine::loop {
         private:
+            /// @brief The ids of the regions registered in hitAreas
+            typedef enum {
+                HIT_BOARD = 0
+            } hitRegions;
+            /// @brief The slots of hudKeys
+            typedef enum {
+                HUD_PREVIEW_HEADER = 0,
+                HUD_PAGE_INFO = 1,
+                HUD_TEXTURE_STATS = 2,
+                HUD_SLOT_COUNT = 3
+            } hudSlots;
+
             bengine::normalMouseState mstate;
 
-            std::vector<blokus::player> players = {};
+            /// @brief Every player's pieces, names, and colors
+            blokus::playerTable players;
             Uint8 pieceSets[6] = {1, 0, 0, 0, 0, 0};
             Uint8 turn = 0;
 
@@ -32,28 +51,53 @@ namespace blokus {
              * The bitmask of each tile (used for autotiling) is determined by "bitmask = value - (playerid * 16) - 1"
              */
             std::vector<std::vector<Uint8>> board = {};
-
-            TTF_Font* font_general = TTF_OpenFont("dev/fonts/GNU-Unifont.ttf", 35);
-            TTF_Font* font_pageInfo = TTF_OpenFont("dev/fonts/GNU-Unifont.ttf", 32);
-
-            bengine::basicTexture texture_background = bengine::basicTexture(this->window.loadTexture("dev/png/background.png"), {0, 0, 1920, 1080});
-            bengine::basicTexture texture_boardframe = bengine::basicTexture(this->window.loadTexture("dev/png/boardframe.png"), {0, 0, 1064, 1064});
-            bengine::basicTexture texture_emptyCell = bengine::basicTexture(this->window.loadTexture("dev/png/empty_cell.png"), {0, 0, 64, 64});
-            bengine::basicTexture texture_grid;
-
-            bengine::moddedTexture texture_piece_base = bengine::moddedTexture(this->window.loadTexture("dev/png/tilesets/piece_bases_sheet.png"), {0, 0, 256, 256}, {255, 0, 0, 255});
-            bengine::basicTexture texture_piece_edge = bengine::basicTexture(this->window.loadTexture("dev/png/tilesets/piece_edges_sheet.png"), {0, 0, 256, 256});
+            /// @brief Whether the autotile masks within board and the board's tiles need rebuilding (done on the next render so that restoring a snapshot stays cheap)
+            bool boardDirty = false;
+            /// @brief Where the quicksave keys save and load snapshots
+            const std::string quicksavePath = "dev/saves/quicksave.blks";
+
+            // Every font and texture starts out empty and is filled in by assets; nothing is drawn with them until it has finished
+            TTF_Font* font_general = nullptr;
+            TTF_Font* font_pageInfo = nullptr;
+
+            bengine::basicTexture texture_background = bengine::basicTexture(nullptr, {0, 0, 1920, 1080});
+            bengine::basicTexture texture_boardframe = bengine::basicTexture(nullptr, {0, 0, 1064, 1064});
+            bengine::basicTexture texture_emptyCell = bengine::basicTexture(nullptr, {0, 0, 64, 64});
+            /// @brief The zoomable, pannable view of the board, drawn from cached tiles of cells
+            blokus::boardView boardView = blokus::boardView({867, 27, 1026, 1026});
+
+            bengine::moddedTexture texture_piece_base = bengine::moddedTexture(nullptr, {0, 0, 256, 256}, {255, 0, 0, 255});
+            bengine::basicTexture texture_piece_edge = bengine::basicTexture(nullptr, {0, 0, 256, 256});
             bengine::autotiler tiler;
 
-            bengine::basicTexture texture_playerframe_small = bengine::basicTexture(this->window.loadTexture("dev/png/playerframe_small.png"), {0, 0, 800, 260});
-            bengine::basicTexture texture_playerframe_large = bengine::basicTexture(this->window.loadTexture("dev/png/playerframe_large.png"), {0, 0, 800, 1064});
-            bengine::moddedTexture texture_shaded_frame = bengine::moddedTexture(this->window.loadTexture("dev/png/shaded_frame.png"), {0, 0, 192, 192});
+            bengine::basicTexture texture_playerframe_large = bengine::basicTexture(nullptr, {0, 0, 800, 1064});
+            bengine::moddedTexture texture_shaded_frame = bengine::moddedTexture(nullptr, {0, 0, 192, 192});
+
+            /// @brief Decodes the fonts and textures above on worker threads while the loading frame is shown
+            bengine::assetLoader assets = bengine::assetLoader(this->window);
+            /// @brief The most time each frame may spend uploading decoded images (ms)
+            const Uint32 uploadBudget = 8;
 
-            bengine::clickMatrix gridClickArea;
+            /// @brief Every clickable region; looked up once per click instead of checking each region in turn
+            bengine::hitIndex hitAreas;
             std::string textInput = "";
 
             bengine::paddedGrid piecesPreviewGrid = bengine::paddedGrid(766, 881, 5, 6, 4, 4, bengine::ALIGN_CTR_CTR);
             Uint8 piecesPreviewPage = 0;
+            /// @brief Rendered pages of the piece preview grid
+            blokus::pieceAtlas pieceThumbnails;
+
+            /// @brief The board and piece preview, laid out once by layoutHud()
+            bengine::cachedLayout hud;
+            bengine::textLabel label_previewHeader;
+            bengine::textLabel label_pageInfo;
+            /// @brief The texture cache's totals, drawn over the corner of the board while showTextureStats is on (toggled with F3)
+            bengine::textLabel label_textureStats;
+            bool showTextureStats = false;
+            /// @brief The values that each HUD label's text was last built from, so that text is only formatted again when its values change
+            std::vector<Uint64> hudKeys = {};
+            /// @brief Whether the HUD has to be recorded into the window's command list again (anything it draws or says changed); otherwise last frame's list is submitted as is
+            bool hudDirty = true;
 
             Uint16 maxPieces() const {
                 Uint16 output = 0;
@@ -79,10 +123,24 @@ namespace blokus {
             }
 
             void handleEvent() override {
+                if (!this->assets.finished()) {
+                    return;
+                }
                 Uint32 gridpos;
                 switch (this->event.type) {
                     case SDL_MOUSEMOTION:
                         this->mstate.update(this->event);
+                        // Dragging with the right mouse button pans the board
+                        if (this->mstate.pressed(bengine::MOUSE2) && this->boardView.pan(-this->event.motion.xrel, -this->event.motion.yrel)) {
+                            this->hudDirty = true;
+                            this->visualsChanged = true;
+                        }
+                        break;
+                    case SDL_MOUSEWHEEL:
+                        if (this->hitAreas.checkPos(this->mstate) == HIT_BOARD && this->boardView.zoomAt(std::pow(1.25, this->event.wheel.y), this->mstate.posx(), this->mstate.posy())) {
+                            this->hudDirty = true;
+                            this->visualsChanged = true;
+                        }
                         break;
                     case SDL_MOUSEBUTTONDOWN:
                         this->mstate.pressButton(this->event);
@@ -94,31 +152,31 @@ namespace blokus {
                             }
                             this->visualsChanged = true;
                         }
-                        gridpos = this->gridClickArea.checkButton(this->mstate, bengine::MOUSE1);
-                        if (gridpos != UINT32_MAX && this->board.at(gridpos % this->board.size()).at(gridpos / this->board.size()) == 0) {
-                            std::vector<std::vector<char>> playerMask;
-                            for (Uint8 i = 0; i < this->board.size(); i++) {
-                                playerMask.emplace_back();
-                                for (Uint8 j = 0; j < this->board.size(); j++) {
-                                    if (this->board.at(i).at(j) < this->turn * 16 || this->board.at(i).at(j) > (this->turn + 1) * 16) {
-                                        playerMask[i].emplace_back(-1);
-                                        continue;
+                        gridpos = this->hitAreas.checkButton(this->mstate, bengine::MOUSE1) == HIT_BOARD ? this->boardView.cellAt(this->mstate.posx(), this->mstate.posy()) : UINT32_MAX;
+                        if (gridpos != UINT32_MAX && this->board.at(gridpos / this->board.size()).at(gridpos % this->board.size()) == 0) {
+                            // Autotile only against the current player's tiles; every other cell is treated as empty (-1)
+                            const Uint8 size = this->board.size();
+                            std::vector<char> playerMask((std::size_t)size * size, -1);
+                            for (Uint8 i = 0; i < size; i++) {
+                                for (Uint8 j = 0; j < size; j++) {
+                                    if (this->board[i][j] != 0 && (this->board[i][j] - 1) / 16 == this->turn) {
+                                        playerMask[i * size + j] = this->board[i][j] - (this->turn * 16) - 1;
                                     }
-                                    playerMask[i].emplace_back(this->board.at(i).at(j) - (this->turn * 16) - 1);
                                 }
                             }
-                            this->tiler.fourBit(playerMask, gridpos % this->board.size(), gridpos / this->board.size(), true, false);
+                            this->tiler.fourBit(playerMask.data(), size, size, size, gridpos % size, gridpos / size, true, false);
 
-                            for (Uint8 i = 0; i < this->board.size(); i++) {
-                                for (Uint8 j = 0; j < this->board.size(); j++) {
-                                    if (playerMask.at(i).at(j) < 0) {
-                                        continue;
+                            for (Uint8 i = 0; i < size; i++) {
+                                for (Uint8 j = 0; j < size; j++) {
+                                    if (playerMask[i * size + j] >= 0) {
+                                        this->board[i][j] = (playerMask[i * size + j] + 1) + (16 * this->turn);
                                     }
-                                    this->board[i][j] = (playerMask.at(i).at(j) + 1) + (16 * turn);
                                 }
                             }
 
-                            this->updateBoardTexture();
+                            // Placing a tile can only change the masks of the tile's neighbors
+                            this->boardView.invalidate(gridpos % size, gridpos / size);
+                            this->hudDirty = true;
                             this->visualsChanged = true;
                         }
                         break;
@@ -146,11 +204,49 @@ namespace blokus {
                                     break;
                             }
                         }
+                        if (this->event.key.keysym.scancode == SDL_SCANCODE_F5) {
+                            this->saveSnapshot(this->quicksavePath);
+                        } else if (this->event.key.keysym.scancode == SDL_SCANCODE_F9) {
+                            this->loadSnapshot(this->quicksavePath);
+                        } else if (this->event.key.keysym.scancode == SDL_SCANCODE_F3) {
+                            this->showTextureStats = !this->showTextureStats;
+                            this->hudDirty = true;
+                            this->visualsChanged = true;
+                        }
+                        if (!SDL_IsTextInputActive()) {
+                            const SDL_Rect viewport = this->boardView.getViewport();
+                            bool viewChanged = false;
+                            switch (this->event.key.keysym.scancode) {
+                                case SDL_SCANCODE_EQUALS:
+                                    viewChanged = this->boardView.zoomAt(1.25, viewport.x + viewport.w / 2, viewport.y + viewport.h / 2);
+                                    break;
+                                case SDL_SCANCODE_MINUS:
+                                    viewChanged = this->boardView.zoomAt(0.8, viewport.x + viewport.w / 2, viewport.y + viewport.h / 2);
+                                    break;
+                                case SDL_SCANCODE_R:
+                                    this->boardView.fit();
+                                    viewChanged = true;
+                                    break;
+                                default:
+                                    break;
+                            }
+                            if (viewChanged) {
+                                this->hudDirty = true;
+                                this->visualsChanged = true;
+                            }
+                        }
                         if (keystate[SDL_SCANCODE_SPACE]) {
                             this->turn++;
                             this->turn %= this->players.size();
                             this->visualsChanged = true;
                         }
+                        if (this->event.key.keysym.scancode == SDL_SCANCODE_LEFT && this->piecesPreviewPage > 0) {
+                            this->piecesPreviewPage--;
+                            this->visualsChanged = true;
+                        } else if (this->event.key.keysym.scancode == SDL_SCANCODE_RIGHT && this->piecesPreviewPage + 1 < this->previewPageCount(this->turn)) {
+                            this->piecesPreviewPage++;
+                            this->visualsChanged = true;
+                        }
                         break;
                     default:
                         break;
@@ -158,87 +254,193 @@ namespace blokus {
             }
 
             void compute() override {
+                if (!this->assets.finished()) {
+                    this->assets.update(this->uploadBudget);
+                    this->visualsChanged = true;
+                    return;
+                }
                 this->mstate.stopMotion();
             }
 
-            void renderPlayer(const Uint8 &id) {
-                const Uint16 xpos = 20;
-                const Uint16 ypos = 8 + 268 * id;
-                const char16_t* setTitles[6] = {u"Base:        ", u"Hexominoes:  ", u"Heptominoes: ", u"Octominoes:  ", u"Nonominoes:  ", u"Decominoes:  "};
-
-                this->window.renderBasicTexture(this->texture_playerframe_small, {xpos, ypos, 800, 260});
-                this->window.renderText(this->font_general, (u"Player " + btils::to_u16string<Uint8>(id + 1) + u" - " + this->players.at(id).getName()).c_str(), xpos + 12, ypos + 10, 0, bengine::colors[bengine::COLOR_WHITE]);
-            
-                this->window.renderText(this->font_general, (u"Tiles Left: " + btils::to_u16string(btils::tstr_AddZeros<Uint16>(this->players.at(id).getRemainingTiles(blokus::POLYTYPE_SENTINAL), 4, 0) + "/" + btils::tstr_AddZeros<Uint16>(this->maxTiles(), 4, 0) + " (" + btils::tstr_AddZeros<Uint16>((this->maxTiles() - this->players.at(id).getRemainingTiles(blokus::POLYTYPE_SENTINAL)) / this->maxTiles() * 100, 3, 0) + "%)")).c_str(), xpos + 12, ypos + 50, 0, bengine::colors[bengine::COLOR_WHITE]);
-                for (polyType i = blokus::POLYTYPE_BASE; i <= blokus::POLYTYPE_OCT; i++) {
-                    if (this->pieceSets[i] > 0) {
-                        this->window.renderText(this->font_general, (setTitles[i] + btils::to_u16string(btils::tstr_AddZeros<Uint16>(this->players.at(id).getRemainingPieces(i), 3, 0) + "/" + btils::tstr_AddZeros<Uint16>(this->pieceSets[i] * blokus::polyominoAmounts[i], 3, 0) + "  (" + btils::tstr_AddZeros<Uint16>((this->pieceSets[i] * blokus::polyominoAmounts[i] - this->players.at(id).getRemainingPieces(i)) / (this->pieceSets[i] * blokus::polyominoAmounts[i]) * 100, 3, 0) + "%)")).c_str(), xpos + 12, ypos + 92 + 36 * (int)i, 0, bengine::colors[bengine::COLOR_WHITE]);
-                    }
+            /** Check whether the values behind a HUD label changed since its text was last built, remembering the new values if so
+             * @param slot The label's slot (from hudSlots)
+             * @param value The label's values packed into one integer
+             * @returns Whether the label's text needs building again
+             */
+            bool hudChanged(const std::size_t &slot, const Uint64 &value) {
+                if (this->hudKeys[slot] == value) {
+                    return false;
                 }
-                this->window.renderModdedTexture(this->texture_shaded_frame, {xpos + 559, ypos + 53, 192, 192});
+                this->hudKeys[slot] = value;
+                this->hudDirty = true;
+                return true;
             }
-            void renderPiecePreview(const Uint8 &id) {
-                this->window.renderBasicTexture(this->texture_playerframe_large, {20, 8, 800, 1064});
-                this->window.renderText(this->font_general, (u"Player " + btils::to_u16string<Uint8>(id + 1) + u" - " + this->players.at(id).getName()).c_str(), 32, 18, 0, bengine::colors[bengine::COLOR_WHITE]);
-                this->window.renderText(this->font_pageInfo, (u"Showing Pieces " + btils::to_u16string(btils::tstr_AddZeros<Uint8>(1, 4, 0)) + u"-" + btils::to_u16string(btils::tstr_AddZeros<Uint8>(21, 4, 0)) + u"/" + btils::to_u16string(btils::tstr_AddZeros<Uint16>(this->maxPieces(), 4, 0)) + u" on Page " + btils::to_u16string(btils::tstr_AddZeros<Uint8>(this->piecesPreviewPage + 1, 3, 0)) + u"/" + btils::to_u16string(btils::tstr_AddZeros<Uint8>(this->maxPieces() / (this->piecesPreviewGrid.getRows() * this->piecesPreviewGrid.getCols()) + 1, 3, 0))).c_str(), 76, 1025, 0, bengine::colors[bengine::COLOR_WHITE]);
-
-                // Uint16 pieceId = 0;
-                const Uint8 previewCells = this->piecesPreviewGrid.getRows() * this->piecesPreviewGrid.getCols();
-                Uint8 maxPages = 0;
-                for (blokus::polyType i = blokus::POLYTYPE_BASE; i <= blokus::POLYTYPE_DEC; i++) {
-                    if (this->pieceSets[i] < 1) {
+            /** Get the amount of pages needed to preview every piece a player has left
+             * @param id The player
+             * @returns The amount of preview pages (at least 1)
+             */
+            Uint16 previewPageCount(const Uint8 &id) const {
+                const Uint16 cells = this->piecesPreviewGrid.getRows() * this->piecesPreviewGrid.getCols();
+                const Uint16 pieces = this->players.getRemainingPieces(id, blokus::POLYTYPE_SENTINAL);
+                return pieces == 0 ? 1 : (pieces + cells - 1) / cells;
+            }
+            /** Get the pieces shown on a page of the preview grid (base pieces first, then hexominoes, etc.)
+             * @param id The player
+             * @param index The page
+             * @returns The pieces on the page in cell order
+             */
+            std::vector<const blokus::piece *> previewPieces(const Uint8 &id, const Uint16 &index) const {
+                const std::size_t cells = this->piecesPreviewGrid.getRows() * this->piecesPreviewGrid.getCols();
+                std::size_t skip = index * cells;
+                std::vector<const blokus::piece *> output;
+                for (blokus::polyType i = blokus::POLYTYPE_BASE; i <= blokus::POLYTYPE_OCT && output.size() < cells; i++) {
+                    const std::vector<blokus::piece> &pieces = this->players.getPieces(id, i);
+                    if (skip >= pieces.size()) {
+                        skip -= pieces.size();
                         continue;
                     }
-                    maxPages += this->pieceSets[i] * blokus::polyominoAmounts[i] / previewCells + 1;
+                    for (std::size_t j = skip; j < pieces.size() && output.size() < cells; j++) {
+                        output.push_back(&pieces[j]);
+                    }
+                    skip = 0;
+                }
+                return output;
+            }
+            /** Get the current page of a player's piece previews ready to be recorded (any thumbnail the atlas is missing is rendered first, so call this before drawing anything else in the frame)
+             * @param id The player
+             * @returns Whether the page looks any different from last frame's
+             */
+            bool preparePreviewPage(const Uint8 &id) {
+                if (this->piecesPreviewPage >= this->previewPageCount(id)) {
+                    this->piecesPreviewPage = this->previewPageCount(id) - 1;
+                }
+                return this->pieceThumbnails.preparePage(this->window, this->piecesPreviewGrid, this->previewPieces(id, this->piecesPreviewPage), this->players.getColor(id), this->texture_piece_base, this->texture_piece_edge);
+            }
+            /** Bring the piece preview's labels up to date; text is only built for the values that changed
+             * @param id The player whose pieces are being previewed
+             */
+            void updatePreviewLabels(const Uint8 &id) {
+                this->label_previewHeader.setFont(this->font_general);
+                if (this->hudChanged(HUD_PREVIEW_HEADER, id)) {
+                    this->label_previewHeader.setText(u"Player " + btils::to_u16string<Uint8>(id + 1) + u" - " + this->players.getName(id));
                 }
 
-                for (Uint8 i = 0; i < this->piecesPreviewGrid.getRows(); i++) {
-                    for (Uint8 j = 0; j < this->piecesPreviewGrid.getCols(); j++) {
-                        this->texture_shaded_frame.setColorMod({(Uint8)(std::rand() % 255), (Uint8)(std::rand() % 255), (Uint8)(std::rand() % 255), 255});
-                        this->window.renderModdedTexture(this->texture_shaded_frame, {(int)(36 + this->piecesPreviewGrid.getXOffset() + j * (this->piecesPreviewGrid.getCellWidth() + this->piecesPreviewGrid.getGapWidth())), (int)(139 + this->piecesPreviewGrid.getYOffset() + i * (this->piecesPreviewGrid.getCellHeight() + this->piecesPreviewGrid.getGapHeight())), (int)this->piecesPreviewGrid.getCellWidth(), (int)this->piecesPreviewGrid.getCellHeight()});
-                    }
+                const Uint16 cells = this->piecesPreviewGrid.getRows() * this->piecesPreviewGrid.getCols();
+                const Uint16 remaining = this->players.getRemainingPieces(id, blokus::POLYTYPE_SENTINAL);
+                const Uint16 first = remaining == 0 ? 0 : this->piecesPreviewPage * cells + 1;
+                const Uint16 last = (this->piecesPreviewPage + 1) * cells < remaining ? (this->piecesPreviewPage + 1) * cells : remaining;
+                const Uint16 pages = this->previewPageCount(id);
+                this->label_pageInfo.setFont(this->font_pageInfo);
+                if (this->hudChanged(HUD_PAGE_INFO, (Uint64)first << 48 | (Uint64)last << 32 | (Uint64)remaining << 16 | (Uint64)(this->piecesPreviewPage + 1) << 8 | (pages & 0xFF))) {
+                    this->label_pageInfo.setText(u"Showing Pieces " + btils::to_u16string(btils::tstr_AddZeros<Uint16>(first, 4, 0)) + u"-" + btils::to_u16string(btils::tstr_AddZeros<Uint16>(last, 4, 0)) + u"/" + btils::to_u16string(btils::tstr_AddZeros<Uint16>(remaining, 4, 0)) + u" on Page " + btils::to_u16string(btils::tstr_AddZeros<Uint16>(this->piecesPreviewPage + 1, 3, 0)) + u"/" + btils::to_u16string(btils::tstr_AddZeros<Uint16>(pages, 3, 0)));
                 }
             }
 
-            void updateBoardTexture() {
-                this->window.targetDummy();
-                this->window.initDummy(this->board.size() * 64, this->board.size() * 64);
-                this->window.clear();
+            /// @brief Bring the texture stats overlay up to date; its text is only built again when the totals change
+            void updateTextureStatsLabel() {
+                if (!this->showTextureStats) {
+                    return;
+                }
+                const bengine::textureStats &stats = this->window.getTextureStats();
+                this->label_textureStats.setFont(this->font_pageInfo);
+                // Every other total follows from these three, which only ever count up
+                if (this->hudChanged(HUD_TEXTURE_STATS, (Uint64)stats.created << 40 ^ (Uint64)stats.destroyed << 16 ^ (Uint64)stats.cacheHits)) {
+                    this->label_textureStats.setText(u"Textures: " + btils::to_u16string<std::size_t>(stats.liveTextures) + u" alive (" + btils::to_u16string<std::size_t>(stats.liveBytes / 1024) + u" KiB, peak " + btils::to_u16string<std::size_t>(stats.peakBytes / 1024) + u" KiB), " + btils::to_u16string<std::size_t>(stats.created) + u" created, " + btils::to_u16string<std::size_t>(stats.destroyed) + u" destroyed, " + btils::to_u16string<std::size_t>(stats.cacheHits) + u" cache hits");
+                }
+            }
 
-                this->window.renderBasicTexture(this->texture_background, {0, 0, (int)this->board.size() * 64, (int)this->board.size() * 64});
-                for (Uint8 i = 0; i < this->board.size(); i++) {
-                    for (Uint8 j = 0; j < this->board.size(); j++) {
-                        // Render empty tile
-                        if (this->board.at(i).at(j) == 0) {
-                            this->window.renderBasicTexture(this->texture_emptyCell, {j * 64, i * 64, 64, 64});
-                            continue;
+            /** Work out where everything on screen goes; only needed when the board's size or the window's base size changes
+             * 
+             * Everything is placed in the window's base coordinates (the window stretches them to its actual size), and the layout points at the textures and labels instead of copying them, so new text or a new page does not need laying out again
+             */
+            void layoutHud() {
+                this->hud.clear();
+                this->hud.add(this->texture_background, {0, 0, this->window.getBaseWidth(), this->window.getBaseHeight()});
+                this->hud.add(this->texture_boardframe, {848, 8, 1064, 1064});
+                this->hud.add(this->texture_playerframe_large, {20, 8, 800, 1064});
+                this->hud.add(this->label_previewHeader, 32, 18);
+                this->hud.add(this->label_pageInfo, 76, 1025);
+
+                // Names may have changed along with the layout, so every label is built again
+                this->hudKeys.assign(HUD_SLOT_COUNT, UINT64_MAX);
+                this->hudDirty = true;
+            }
+
+            /// @brief Lay out the clickable regions; needed whenever the board's size or the window's base size changes
+            void layoutHitAreas() {
+                const SDL_Rect viewport = this->boardView.getViewport();
+                this->hitAreas.resize(this->window.getBaseWidth(), this->window.getBaseHeight());
+                this->hitAreas.add(HIT_BOARD, bengine::clickRectangle(viewport.x, viewport.y, viewport.x + viewport.w, viewport.y + viewport.h));
+            }
+
+            /// @brief Recompute the 4-bit autotile mask of every occupied cell from which player owns it and its neighbors
+            void rebuildBoardMasks() {
+                const Uint8 size = this->board.size();
+                std::vector<blokus::bitboard> owned(this->players.size(), blokus::bitboard(size));
+                for (Uint8 i = 0; i < size; i++) {
+                    for (Uint8 j = 0; j < size; j++) {
+                        if (this->board[i][j] != 0) {
+                            owned.at((this->board[i][j] - 1) / 16).set(j, i);
+                        }
+                    }
+                }
+
+                std::vector<char> masks((std::size_t)size * size);
+                for (Uint8 p = 0; p < owned.size(); p++) {
+                    bengine::autotiler::fourBitMasks(owned[p].getWords().data(), owned[p].getStride(), size, size, masks.data(), false);
+                    for (std::size_t i = 0; i < masks.size(); i++) {
+                        if (masks[i] >= 0) {
+                            this->board[i / size][i % size] = p * 16 + masks[i] + 1;
                         }
-                        // Determine the id of the player occupying the cell & change color of base texture
-                        const Uint8 cellId = (this->board.at(i).at(j) - 1) / 16;
-                        this->texture_piece_base.setColorMod(this->players.at(cellId).getColor());
-
-                        // Determine the correct tile to use and then render it
-                        const Uint8 cellMask = this->board.at(i).at(j) - (cellId * 16) - 1;
-                        this->texture_piece_base.setFrame({cellMask % 4 * 64, cellMask / 4 * 64, 64, 64});
-                        this->texture_piece_edge.setFrame({cellMask % 4 * 64, cellMask / 4 * 64, 64, 64});
-                        this->window.renderModdedTexture(this->texture_piece_base, {j * 64, i * 64, 64, 64});
-                        this->window.renderBasicTexture(this->texture_piece_edge, {j * 64, i * 64, 64, 64});
                     }
                 }
-                this->window.present();
-                this->texture_grid.setTexture(this->window.copyDummy());
-                this->window.targetWindow();
-                this->window.clear();
+            }
+
+            /// @brief Render the progress of the asset loader; drawn with plain shapes since no textures or fonts are ready yet
+            void renderLoading() {
+                const double progress = this->assets.progress();
+                this->window.fillRectangle(0, 0, this->window.getWidth(), this->window.getHeight(), bengine::colors[bengine::COLOR_DARK_GRAY]);
+                this->window.drawThickRectangle(660, 520, 600, 40, 4, THICKSHAPE_OUTER, bengine::colors[bengine::COLOR_WHITE]);
+                this->window.fillRectangle(660, 520, (int)(600 * progress), 40, bengine::colors[bengine::COLOR_LIGHT_GRAY]);
             }
             void render() override {
-                this->window.renderBasicTexture(this->texture_background, {0, 0, this->window.getWidth(), this->window.getHeight()});
-                this->window.renderBasicTexture(this->texture_boardframe, {848, 8, 1064, 1064});
-                this->window.renderBasicTexture(this->texture_grid, {867, 27, 1026, 1026});
-                
-                // for (Uint8 i = 0; i < this->players.size(); i++) {
-                //     this->renderPlayer(i);
-                // }
-                this->renderPiecePreview(turn);
+                if (!this->assets.finished()) {
+                    this->renderLoading();
+                    return;
+                }
+                // Anything drawn through the dummy texture has to happen before the frame itself is drawn
+                if (this->boardDirty) {
+                    this->boardDirty = false;
+                    this->rebuildBoardMasks();
+                    this->boardView.invalidateAll();
+                    this->hudDirty = true;
+                }
+                if (this->preparePreviewPage(this->turn)) {
+                    this->hudDirty = true;
+                }
+                this->updatePreviewLabels(this->turn);
+                this->updateTextureStatsLabel();
+
+                // The whole HUD is one sorted, merged command list that is only recorded again when something in it changed
+                if (this->hudDirty) {
+                    this->hudDirty = false;
+                    this->window.clearCommands();
+                    this->hud.record(this->window);
+                    // The piece preview grid's zone starts at (36, 139); its thumbnails all come from the atlas, so they merge into one batch
+                    this->pieceThumbnails.recordPage(this->window, this->piecesPreviewGrid, 36, 139, this->texture_shaded_frame);
+                    // Tiles that could not be rendered at full detail within this frame's budget are refined over the next frames
+                    if (!this->boardView.record(this->window, this->board, this->players, this->texture_background, this->texture_emptyCell, this->texture_piece_base, this->texture_piece_edge)) {
+                        this->hudDirty = true;
+                        this->visualsChanged = true;
+                    }
+                    // Recorded after the board so that it lands on top of it
+                    if (this->showTextureStats) {
+                        const SDL_Rect viewport = this->boardView.getViewport();
+                        const bengine::basicTexture &stats = this->label_textureStats.getTexture(this->window);
+                        this->window.recordBasicTexture(stats, {viewport.x + 8, viewport.y + 8, stats.getFrame().w, stats.getFrame().h});
+                    }
+                }
+                this->window.submitCommands();
             }
 
         public:
@@ -264,45 +466,114 @@ namespace blokus {
                 this->pieceSets[blokus::POLYTYPE_OCT] = blokus::processPolyominoSet(blokus::POLYTYPE_OCT, octSets);
 
                 // Player setup, stuff after the for loop shall be removed later
-                for (Uint8 i = 0; i < players; i++) {
-                    this->players.emplace_back(blokus::player(this->pieceSets[blokus::POLYTYPE_BASE], this->pieceSets[blokus::POLYTYPE_HEX], this->pieceSets[blokus::POLYTYPE_HEPT], this->pieceSets[blokus::POLYTYPE_OCT]));
-                }
-                this->players[0].setColor({255, 0, 0, 255});
-                this->players[0].setName(u"Bearslay");
-                this->players[1].setColor({0, 255, 0, 255});
-                this->players[1].setName(u"Barfunkel");
+                this->players.reset(players, this->pieceSets[blokus::POLYTYPE_BASE], this->pieceSets[blokus::POLYTYPE_HEX], this->pieceSets[blokus::POLYTYPE_HEPT], this->pieceSets[blokus::POLYTYPE_OCT]);
+                this->players.setColor(0, {255, 0, 0, 255});
+                this->players.setName(0, u"Bearslay");
+                this->players.setColor(1, {0, 255, 0, 255});
+                this->players.setName(1, u"Barfunkel");
                 if (this->players.size() > 2) {
-                    this->players[2].setColor({0, 0, 255, 255});
-                    this->players[2].setName(u"Belay");
+                    this->players.setColor(2, {0, 0, 255, 255});
+                    this->players.setName(2, u"Belay");
                 }
                 if (this->players.size() > 3) {
-                    this->players[3].setColor({255, 255, 0, 255});
-                    this->players[3].setName(u"Charlie");
+                    this->players.setColor(3, {255, 255, 0, 255});
+                    this->players.setName(3, u"Charlie");
                 }
 
-                this->texture_grid.setFrame({0, 0, size * 64, size * 64});
+                // Grid setup; the board's tiles are drawn by the first render after the assets have loaded
+                this->board.assign(size, std::vector<Uint8>(size, 0));
+                this->boardView.reset(size);
+                this->boardDirty = true;
+
+                this->assets.requestFont("dev/fonts/GNU-Unifont.ttf", 35, this->font_general);
+                this->assets.requestFont("dev/fonts/GNU-Unifont.ttf", 32, this->font_pageInfo);
+                this->assets.requestTexture("dev/png/background.png", this->texture_background);
+                this->assets.requestTexture("dev/png/boardframe.png", this->texture_boardframe);
+                this->assets.requestTexture("dev/png/empty_cell.png", this->texture_emptyCell);
+                this->assets.requestTexture("dev/png/tilesets/piece_bases_sheet.png", this->texture_piece_base);
+                this->assets.requestTexture("dev/png/tilesets/piece_edges_sheet.png", this->texture_piece_edge);
+                this->assets.requestTexture("dev/png/playerframe_large.png", this->texture_playerframe_large);
+                this->assets.requestTexture("dev/png/shaded_frame.png", this->texture_shaded_frame);
+
+                this->layoutHitAreas();
+                this->layoutHud();
+                this->piecesPreviewGrid.setCellSquareness(true);
+            }
+            /** Save the current game to a snapshot file
+             * @param path The path of the file
+             * @returns Whether the snapshot was saved
+             */
+            bool saveSnapshot(const std::string &path) const {
+                blokus::snapshot output;
+                output.size = this->board.size();
+                output.turn = this->turn;
+                std::memcpy(output.pieceSets, this->pieceSets, 6);
+
+                output.owners.resize(output.size * output.size);
+                for (Uint8 i = 0; i < output.size; i++) {
+                    for (Uint8 j = 0; j < output.size; j++) {
+                        output.owners[i * output.size + j] = this->board[i][j] == 0 ? 0 : (this->board[i][j] - 1) / 16 + 1;
+                    }
+                }
 
-                // Grid setup; includes initializing the board itself as well as the grid's initial texture of empty cells
-                this->window.targetDummy();
-                this->window.initDummy(size * 64, size * 64);
+                for (Uint8 i = 0; i < this->players.size(); i++) {
+                    output.players.emplace_back();
+                    const SDL_Color color = this->players.getColor(i);
+                    output.players.back().name = this->players.getName(i);
+                    output.players.back().color[0] = color.r;
+                    output.players.back().color[1] = color.g;
+                    output.players.back().color[2] = color.b;
+                    output.players.back().color[3] = color.a;
+                    for (blokus::polyType j = blokus::POLYTYPE_BASE; j <= blokus::POLYTYPE_OCT; j++) {
+                        output.players.back().pieces[j] = this->players.getPieces(i, j);
+                    }
+                }
+                return output.save(path);
+            }
+            /** Replace the current game with one from a snapshot file
+             * 
+             * Only the board's owners are copied in; the autotile masks and board tiles are rebuilt on the next render
+             * @param path The path of the file
+             * @returns Whether the snapshot was loaded (the current game is untouched if not)
+             */
+            bool loadSnapshot(const std::string &path) {
+                blokus::snapshot input;
+                if (!input.load(path)) {
+                    return false;
+                }
 
-                this->window.clear();
-                this->window.renderBasicTexture(this->texture_background, {0, 0, size * 64, size * 64});
-                for (Uint8 i = 0; i < size; i++) {
-                    this->board.emplace_back();
-                    for (Uint8 j = 0; j < size; j++) {
-                        this->board[i].emplace_back(0);
-                        this->window.renderBasicTexture(this->texture_emptyCell, {j * 64, i * 64, 64, 64});
+                std::memcpy(this->pieceSets, input.pieceSets, 6);
+                this->turn = input.turn;
+
+                this->players.reset(input.players.size(), this->pieceSets[blokus::POLYTYPE_BASE], this->pieceSets[blokus::POLYTYPE_HEX], this->pieceSets[blokus::POLYTYPE_HEPT], this->pieceSets[blokus::POLYTYPE_OCT]);
+                for (Uint8 i = 0; i < input.players.size(); i++) {
+                    this->players.setName(i, input.players[i].name);
+                    this->players.setColor(i, {input.players[i].color[0], input.players[i].color[1], input.players[i].color[2], input.players[i].color[3]});
+                    for (blokus::polyType j = blokus::POLYTYPE_BASE; j <= blokus::POLYTYPE_OCT; j++) {
+                        this->players.setPieces(i, j, input.players[i].pieces[j]);
                     }
                 }
-                this->window.present();
-                this->texture_grid.setTexture(this->window.copyDummy());
-                this->window.targetWindow();
-                this->window.clear();
 
-                this->gridClickArea = bengine::clickMatrix(867, 27, 867 + 1026, 27 + 1026, this->board.size(), this->board.at(0).size());
-                this->piecesPreviewGrid.setCellSquareness(true);
+                // Owners are stored as player + 1; the masks are filled in by rebuildBoardMasks()
+                this->board.assign(input.size, std::vector<Uint8>(input.size, 0));
+                for (Uint8 i = 0; i < input.size; i++) {
+                    for (Uint8 j = 0; j < input.size; j++) {
+                        const Uint8 owner = input.owners[i * input.size + j];
+                        this->board[i][j] = owner == 0 || owner > this->players.size() ? 0 : (owner - 1) * 16 + 1;
+                    }
+                }
+                this->boardView.reset(input.size);
+                // The old board's tiles are gone, so any loaded images that only they held can leave the cache's path map too
+                this->window.getTextureCache().prune();
+                this->layoutHitAreas();
+                this->layoutHud();
+                this->piecesPreviewPage = 0;
+
+                this->boardDirty = true;
+                this->visualsChanged = true;
+                return true;
             }
+
             ~game() {
                 TTF_CloseFont(this->font_general);
                 TTF_CloseFont(this->font_pageInfo);
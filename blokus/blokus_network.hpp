@@ -0,0 +1,475 @@
+#ifndef BLOKUS_NETWORK_hpp
+#define BLOKUS_NETWORK_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define BLOKUS_NETWORK_X86
+#endif
+
+#include "blokus_state.hpp"
+
+namespace blokus {
+    /// @brief Vector kernels used by blokus::network; the AVX2 versions are picked at runtime when the CPU supports them and SSE is used otherwise (scalar on non-x86 machines)
+    namespace kernels {
+        /** output[i] += scale * column[i]
+         * @param output The vector to accumulate into
+         * @param column The vector to add
+         * @param scale The amount to scale column by
+         * @param length The length of the vectors
+         */
+        void addScaledScalar(float *output, const float *column, const float &scale, const std::size_t &length) {
+            for (std::size_t i = 0; i < length; i++) {
+                output[i] += scale * column[i];
+            }
+        }
+        /** Dot product of two vectors
+         * @param a The first vector
+         * @param b The second vector
+         * @param length The length of the vectors
+         * @returns The dot product
+         */
+        float dotScalar(const float *a, const float *b, const std::size_t &length) {
+            float output = 0;
+            for (std::size_t i = 0; i < length; i++) {
+                output += a[i] * b[i];
+            }
+            return output;
+        }
+
+        #if defined(BLOKUS_NETWORK_X86)
+        void addScaledSSE(float *output, const float *column, const float &scale, const std::size_t &length) {
+            const __m128 factor = _mm_set1_ps(scale);
+            std::size_t i = 0;
+            for (; i + 4 <= length; i += 4) {
+                _mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(factor, _mm_loadu_ps(column + i))));
+            }
+            blokus::kernels::addScaledScalar(output + i, column + i, scale, length - i);
+        }
+        float dotSSE(const float *a, const float *b, const std::size_t &length) {
+            __m128 sum = _mm_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 4 <= length; i += 4) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+            }
+            float lanes[4];
+            _mm_storeu_ps(lanes, sum);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + blokus::kernels::dotScalar(a + i, b + i, length - i);
+        }
+
+        __attribute__((target("avx2,fma"))) void addScaledAVX2(float *output, const float *column, const float &scale, const std::size_t &length) {
+            const __m256 factor = _mm256_set1_ps(scale);
+            std::size_t i = 0;
+            for (; i + 8 <= length; i += 8) {
+                _mm256_storeu_ps(output + i, _mm256_fmadd_ps(factor, _mm256_loadu_ps(column + i), _mm256_loadu_ps(output + i)));
+            }
+            blokus::kernels::addScaledScalar(output + i, column + i, scale, length - i);
+        }
+        __attribute__((target("avx2,fma"))) float dotAVX2(const float *a, const float *b, const std::size_t &length) {
+            // Two accumulators hide the latency of the fused multiply-add
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 16 <= length; i += 16) {
+                sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+                sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+            }
+            for (; i + 8 <= length; i += 8) {
+                sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+            }
+            const __m256 sum = _mm256_add_ps(sum0, sum1);
+            __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+            half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+            half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+            return _mm_cvtss_f32(half) + blokus::kernels::dotScalar(a + i, b + i, length - i);
+        }
+        #endif
+
+        /** Check whether the AVX2 kernels can be used; checked once
+         * @returns Whether the CPU supports AVX2 and FMA
+         */
+        bool hasAVX2() {
+            #if defined(BLOKUS_NETWORK_X86)
+            static const bool output = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+            return output;
+            #else
+            return false;
+            #endif
+        }
+
+        /** output[i] += scale * column[i] using the fastest available kernel
+         * @param output The vector to accumulate into
+         * @param column The vector to add
+         * @param scale The amount to scale column by
+         * @param length The length of the vectors
+         */
+        void addScaled(float *output, const float *column, const float &scale, const std::size_t &length) {
+            #if defined(BLOKUS_NETWORK_X86)
+            if (blokus::kernels::hasAVX2()) {
+                return blokus::kernels::addScaledAVX2(output, column, scale, length);
+            }
+            return blokus::kernels::addScaledSSE(output, column, scale, length);
+            #else
+            return blokus::kernels::addScaledScalar(output, column, scale, length);
+            #endif
+        }
+        /** Dot product of two vectors using the fastest available kernel
+         * @param a The first vector
+         * @param b The second vector
+         * @param length The length of the vectors
+         * @returns The dot product
+         */
+        float dot(const float *a, const float *b, const std::size_t &length) {
+            #if defined(BLOKUS_NETWORK_X86)
+            if (blokus::kernels::hasAVX2()) {
+                return blokus::kernels::dotAVX2(a, b, length);
+            }
+            return blokus::kernels::dotSSE(a, b, length);
+            #else
+            return blokus::kernels::dotScalar(a, b, length);
+            #endif
+        }
+    }
+
+    /// @brief The version of the network weight file format
+    const std::uint32_t networkVersion = 1;
+
+    /// @brief The header at the start of a network weight file; the weights follow as little-endian floats in the order they are listed within blokus::network
+    struct networkHeader {
+        /// @brief Always "BLKNET" followed by two null characters
+        char magic[8] = {'B', 'L', 'K', 'N', 'E', 'T', '\0', '\0'};
+        /// @brief The version of the file format (blokus::networkVersion)
+        std::uint32_t version = blokus::networkVersion;
+        /// @brief The side length of the board the network was trained for
+        std::uint16_t size = 20;
+        /// @brief The amount of players the network was trained for
+        std::uint16_t playerCount = 4;
+        /// @brief The amount of polyominoes (from global id 0) whose remaining counts are fed in for each player
+        std::uint16_t pieceFeatures = 21;
+        /// @brief The width of the first hidden layer
+        std::uint16_t hidden1 = 128;
+        /// @brief The width of the second hidden layer
+        std::uint16_t hidden2 = 32;
+        std::uint16_t reserved = 0;
+    };
+
+    static_assert(sizeof(blokus::networkHeader) == 24, "blokus::networkHeader must match the file layout");
+
+    /// @brief The widest hidden layer a network file may have; keeps a corrupt header from sizing the weights to gigabytes
+    const std::uint16_t networkMaxHidden = 1024;
+
+    /// @brief The output of blokus::network for one position
+    struct evaluation {
+        /// @brief The expected outcome for the player to move, from -1 (loss) to 1 (win)
+        float value = 0;
+        /// @brief A logit for each cell of the board (row-major) being covered by the player to move's next piece
+        std::vector<float> cellLogits = {};
+        /// @brief A logit for each polyomino (by global id, up to the network's piece features) being the player to move's next piece
+        std::vector<float> pieceLogits = {};
+    };
+
+    /** Small multi-layer perceptron that evaluates positions and gives move priors (for tree search)
+     *
+     * The inputs are an occupancy plane and an anchor plane for each player plus each player's remaining piece counts, all relative to the player to move.
+     * The inputs are sparse, so the first layer is computed by adding up the weight columns of the set inputs rather than as a dense product; the rest are dense products run through the SIMD kernels within blokus::kernels
+     */
+    class network {
+        private:
+            /// @brief The shape of the network
+            blokus::networkHeader header;
+
+            /// @brief First layer weights; one column of hidden1 floats per input
+            std::vector<float> weights1 = {};
+            /// @brief First layer biases
+            std::vector<float> biases1 = {};
+            /// @brief Second layer weights; one row of hidden1 floats per output
+            std::vector<float> weights2 = {};
+            /// @brief Second layer biases
+            std::vector<float> biases2 = {};
+            /// @brief Value head weights (hidden2 floats) followed by its bias
+            std::vector<float> valueWeights = {};
+            /// @brief Policy head weights; one row of hidden2 floats per cell then per piece feature
+            std::vector<float> policyWeights = {};
+            /// @brief Policy head biases
+            std::vector<float> policyBiases = {};
+
+            /** Get the amount of inputs to the network
+             * @returns The amount of inputs to the network
+             */
+            std::size_t inputCount() const {
+                return (std::size_t)this->header.playerCount * (2 * this->header.size * this->header.size + this->header.pieceFeatures);
+            }
+            /** Get the amount of policy outputs of the network
+             * @returns The amount of policy outputs of the network
+             */
+            std::size_t policyCount() const {
+                return (std::size_t)this->header.size * this->header.size + this->header.pieceFeatures;
+            }
+            /** Get the amount of floats in every weight list for the current header
+             * @returns The amount of floats that follow the header in a weight file
+             */
+            std::size_t weightCount() const {
+                const std::size_t hidden1 = this->header.hidden1, hidden2 = this->header.hidden2;
+                return this->inputCount() * hidden1 + hidden1 + hidden2 * hidden1 + hidden2 + hidden2 + 1 + this->policyCount() * hidden2 + this->policyCount();
+            }
+            /// @brief Size every weight list for the current header
+            void allocate() {
+                this->weights1.assign(this->inputCount() * this->header.hidden1, 0);
+                this->biases1.assign(this->header.hidden1, 0);
+                this->weights2.assign((std::size_t)this->header.hidden2 * this->header.hidden1, 0);
+                this->biases2.assign(this->header.hidden2, 0);
+                this->valueWeights.assign(this->header.hidden2 + 1, 0);
+                this->policyWeights.assign(this->policyCount() * this->header.hidden2, 0);
+                this->policyBiases.assign(this->policyCount(), 0);
+            }
+            /** Get the weight lists in file order
+             * @returns Pointers to every weight list in file order
+             */
+            std::vector<std::vector<float> *> layers() {
+                return {&this->weights1, &this->biases1, &this->weights2, &this->biases2, &this->valueWeights, &this->policyWeights, &this->policyBiases};
+            }
+
+            /** Run the first layer for one state
+             * @param s The state to evaluate
+             * @param output The first hidden layer (hidden1 floats; overwritten)
+             */
+            void firstLayer(const blokus::state &s, float *output) const {
+                const std::size_t width = this->header.hidden1;
+                const std::size_t plane = (std::size_t)this->header.size * this->header.size;
+                std::memcpy(output, this->biases1.data(), width * sizeof(float));
+
+                for (unsigned char r = 0; r < s.getPlayerCount(); r++) {
+                    const unsigned char player = (s.getTurn() + r) % s.getPlayerCount();
+                    const std::size_t occupancy = r * plane;
+                    const std::size_t anchor = (s.getPlayerCount() + r) * plane;
+                    s.getOccupied(player).forEach([&](const int &x, const int &y) {
+                        blokus::kernels::addScaled(output, &this->weights1[(occupancy + y * this->header.size + x) * width], 1, width);
+                    });
+                    s.anchors(player).forEach([&](const int &x, const int &y) {
+                        blokus::kernels::addScaled(output, &this->weights1[(anchor + y * this->header.size + x) * width], 1, width);
+                    });
+                    const std::size_t pieces = 2 * s.getPlayerCount() * plane + r * this->header.pieceFeatures;
+                    for (unsigned short i = 0; i < this->header.pieceFeatures; i++) {
+                        const unsigned char copies = s.getRemaining(player, i);
+                        if (copies > 0) {
+                            blokus::kernels::addScaled(output, &this->weights1[(pieces + i) * width], copies, width);
+                        }
+                    }
+                }
+                for (std::size_t i = 0; i < width; i++) {
+                    output[i] = output[i] > 0 ? output[i] : 0;
+                }
+            }
+
+        public:
+            network() {
+                this->allocate();
+            }
+            /** blokus::network constructor
+             * @param path The path of the weight file to load
+             */
+            network(const std::string &path) {
+                this->load(path);
+            }
+
+            /** Get the shape of the network
+             * @returns The header describing the network
+             */
+            const blokus::networkHeader &getHeader() const {
+                return this->header;
+            }
+            /** Check whether the network can evaluate a state
+             * @param s The state to check
+             * @returns Whether the state's board size and player count match the network
+             */
+            bool accepts(const blokus::state &s) const {
+                return s.getSize() == this->header.size && s.getPlayerCount() == this->header.playerCount;
+            }
+
+            /** Load weights from a flat binary file
+             * @param path The path of the weight file
+             * @returns Whether the weights were loaded (the network is left empty if not)
+             */
+            bool load(const std::string &path) {
+                this->header = blokus::networkHeader();
+                std::ifstream file(path, std::ios::binary);
+                blokus::networkHeader loaded;
+                if (!file.is_open() || !file.read((char *)&loaded, sizeof(blokus::networkHeader))) {
+                    std::cout << "ERROR: Could not read network \"" << path << "\"\n";
+                    this->allocate();
+                    return false;
+                }
+                if (std::memcmp(loaded.magic, blokus::networkHeader().magic, 8) != 0 || loaded.version != blokus::networkVersion) {
+                    std::cout << "ERROR: \"" << path << "\" is not a version " << blokus::networkVersion << " network\n";
+                    this->allocate();
+                    return false;
+                }
+
+                if (loaded.size < 20 || loaded.size > 100 || loaded.playerCount < 2 || loaded.playerCount > 4 || loaded.pieceFeatures > blokus::polyominoIdCount || loaded.hidden1 == 0 || loaded.hidden1 > blokus::networkMaxHidden || loaded.hidden2 == 0 || loaded.hidden2 > blokus::networkMaxHidden) {
+                    std::cout << "ERROR: Network \"" << path << "\" is corrupt\n";
+                    this->allocate();
+                    return false;
+                }
+
+                // Nothing is allocated until the file is known to hold exactly as many weights as its header describes
+                this->header = loaded;
+                const std::streamoff start = file.tellg();
+                file.seekg(0, std::ios::end);
+                const std::streamoff payload = file.tellg() - start;
+                file.seekg(start);
+                if (payload < 0 || (std::size_t)payload != this->weightCount() * sizeof(float)) {
+                    std::cout << "ERROR: Network \"" << path << "\" does not hold the " << this->weightCount() << " weights its header describes\n";
+                    this->header = blokus::networkHeader();
+                    this->allocate();
+                    return false;
+                }
+                this->allocate();
+                const std::vector<std::vector<float> *> layers = this->layers();
+                for (std::size_t i = 0; i < layers.size(); i++) {
+                    if (!file.read((char *)layers[i]->data(), layers[i]->size() * sizeof(float))) {
+                        std::cout << "ERROR: Network \"" << path << "\" is truncated\n";
+                        this->header = blokus::networkHeader();
+                        this->allocate();
+                        return false;
+                    }
+                }
+                return true;
+            }
+            /** Save weights to a flat binary file
+             * @param path The path of the weight file
+             * @returns Whether the file was written
+             */
+            bool save(const std::string &path) {
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) {
+                    std::cout << "ERROR: Could not write network \"" << path << "\"\n";
+                    return false;
+                }
+                file.write((const char *)&this->header, sizeof(blokus::networkHeader));
+                const std::vector<std::vector<float> *> layers = this->layers();
+                for (std::size_t i = 0; i < layers.size(); i++) {
+                    file.write((const char *)layers[i]->data(), layers[i]->size() * sizeof(float));
+                }
+                return file.good();
+            }
+            /** Reshape the network and fill it with small random weights (a starting point for training)
+             * @param header The shape of the network
+             * @param seed The seed for the random weights
+             */
+            void randomize(const blokus::networkHeader &header, std::uint64_t seed) {
+                this->header = header;
+                this->allocate();
+                const std::vector<std::vector<float> *> layers = this->layers();
+                for (std::size_t i = 0; i < layers.size(); i++) {
+                    for (std::size_t j = 0; j < layers[i]->size(); j++) {
+                        // xorshift64 mapped onto [-0.05, 0.05]
+                        seed ^= seed << 13;
+                        seed ^= seed >> 7;
+                        seed ^= seed << 17;
+                        (*layers[i])[j] = ((seed >> 40) / (float)(1 << 24) - 0.5f) * 0.1f;
+                    }
+                }
+            }
+
+            /** Evaluate many states at once; every dense layer walks its weights once for the whole batch
+             * @param states The states to evaluate (each must be accepted by the network)
+             * @param output Filled with one evaluation per state
+             * @returns Whether every state could be evaluated
+             */
+            bool evaluate(const std::vector<const blokus::state *> &states, std::vector<blokus::evaluation> &output) const {
+                output.resize(states.size());
+                for (std::size_t b = 0; b < states.size(); b++) {
+                    if (!this->accepts(*states[b])) {
+                        return false;
+                    }
+                }
+
+                const std::size_t width1 = this->header.hidden1;
+                const std::size_t width2 = this->header.hidden2;
+                std::vector<float> hidden1(states.size() * width1);
+                std::vector<float> hidden2(states.size() * width2);
+                for (std::size_t b = 0; b < states.size(); b++) {
+                    this->firstLayer(*states[b], &hidden1[b * width1]);
+                }
+
+                for (std::size_t i = 0; i < width2; i++) {
+                    const float *row = &this->weights2[i * width1];
+                    for (std::size_t b = 0; b < states.size(); b++) {
+                        const float sum = this->biases2[i] + blokus::kernels::dot(row, &hidden1[b * width1], width1);
+                        hidden2[b * width2 + i] = sum > 0 ? sum : 0;
+                    }
+                }
+
+                const std::size_t cells = (std::size_t)this->header.size * this->header.size;
+                for (std::size_t b = 0; b < states.size(); b++) {
+                    output[b].value = std::tanh(this->valueWeights[width2] + blokus::kernels::dot(this->valueWeights.data(), &hidden2[b * width2], width2));
+                    output[b].cellLogits.resize(cells);
+                    output[b].pieceLogits.resize(this->header.pieceFeatures);
+                }
+                for (std::size_t i = 0; i < this->policyCount(); i++) {
+                    const float *row = &this->policyWeights[i * width2];
+                    for (std::size_t b = 0; b < states.size(); b++) {
+                        const float logit = this->policyBiases[i] + blokus::kernels::dot(row, &hidden2[b * width2], width2);
+                        (i < cells ? output[b].cellLogits[i] : output[b].pieceLogits[i - cells]) = logit;
+                    }
+                }
+                return true;
+            }
+            /** Evaluate a single state
+             * @param s The state to evaluate
+             * @param output The evaluation of the state
+             * @returns Whether the state could be evaluated
+             */
+            bool evaluate(const blokus::state &s, blokus::evaluation &output) const {
+                std::vector<blokus::evaluation> outputs;
+                if (!this->evaluate({&s}, outputs)) {
+                    return false;
+                }
+                output = outputs[0];
+                return true;
+            }
+
+            /** Turn an evaluation into a probability for each of a list of moves
+             *
+             * A move's logit is its piece's logit plus the average logit of the cells it covers; the logits are then softmaxed over the list
+             * @param e The evaluation of the state the moves are from
+             * @param size The side length of the board
+             * @param moves The moves to get priors for
+             * @param output Filled with one probability per move
+             */
+            static void priors(const blokus::evaluation &e, const unsigned char &size, const std::vector<blokus::move> &moves, std::vector<float> &output) {
+                output.resize(moves.size());
+                float highest = -INFINITY;
+                for (std::size_t i = 0; i < moves.size(); i++) {
+                    float logit = 0;
+                    if (!moves[i].isPass()) {
+                        const blokus::orientation &o = blokus::orientations(moves[i].polyomino).at(moves[i].orientation);
+                        for (std::size_t c = 0; c < o.cellCount; c++) {
+                            logit += e.cellLogits.at((moves[i].y + o.cells[c].y) * size + moves[i].x + o.cells[c].x);
+                        }
+                        logit /= o.cellCount;
+                        logit += moves[i].polyomino < e.pieceLogits.size() ? e.pieceLogits[moves[i].polyomino] : 0;
+                    }
+                    output[i] = logit;
+                    highest = logit > highest ? logit : highest;
+                }
+                float total = 0;
+                for (std::size_t i = 0; i < moves.size(); i++) {
+                    output[i] = std::exp(output[i] - highest);
+                    total += output[i];
+                }
+                for (std::size_t i = 0; i < moves.size(); i++) {
+                    output[i] /= total;
+                }
+            }
+    };
+}
+
+#endif // BLOKUS_NETWORK_hpp
@@ -0,0 +1,216 @@
+#ifndef BLOKUS_ORIENTATIONS_hpp
+#define BLOKUS_ORIENTATIONS_hpp
+
+#include <vector>
+#include <stdexcept>
+
+#include "btils.hpp"
+
+#include "blokus_polyominoes.hpp"
+
+namespace blokus {
+    /// @brief The amount of polyominoes that can be referenced by a global polyomino id (base, hex, hept, and oct sets)
+    const unsigned short polyominoIdCount = 21 + 35 + 108 + 369;
+
+    /// @brief A read-only view of a polyomino's orientations; base pieces are viewed straight out of the compile-time blokus::basePieces
+    struct orientationList {
+        /// @brief The first orientation
+        const blokus::orientation *first = nullptr;
+        /// @brief The amount of orientations
+        unsigned char count = 0;
+
+        /** Get the amount of orientations
+         * @returns The amount of orientations
+         */
+        std::size_t size() const {
+            return this->count;
+        }
+        /** Get an orientation without checking the index
+         * @param index The index of the orientation
+         * @returns The orientation
+         */
+        const blokus::orientation &operator[](const std::size_t &index) const {
+            return this->first[index];
+        }
+        /** Get an orientation
+         * @param index The index of the orientation
+         * @returns The orientation (throws std::out_of_range for a bad index, like std::vector::at())
+         */
+        const blokus::orientation &at(const std::size_t &index) const {
+            if (index >= this->count) {
+                throw std::out_of_range("blokus::orientationList::at");
+            }
+            return this->first[index];
+        }
+    };
+
+    /** Get the polyomino set that a global polyomino id belongs to
+     * @param id The global id of the polyomino (same ids as blokus::piece)
+     * @returns The blokus::polyType of the set, or POLYTYPE_SENTINAL for an invalid id
+     */
+    blokus::polyType polyominoSet(const unsigned short &id) {
+        unsigned short start = 0;
+        for (blokus::polyType i = blokus::POLYTYPE_BASE; i <= blokus::POLYTYPE_OCT; i++) {
+            if (id < start + blokus::polyominoAmounts[i]) {
+                return i;
+            }
+            start += blokus::polyominoAmounts[i];
+        }
+        return blokus::POLYTYPE_SENTINAL;
+    }
+    /** Get the global id of the first polyomino within a set
+     * @param type The polyomino set
+     * @returns The global id of the first polyomino within the set
+     */
+    unsigned short polyominoSetStart(const blokus::polyType &type) {
+        unsigned short output = 0;
+        for (blokus::polyType i = blokus::POLYTYPE_BASE; i < type && i <= blokus::POLYTYPE_OCT; i++) {
+            output += blokus::polyominoAmounts[i];
+        }
+        return output;
+    }
+    /** Get the raw grid of a polyomino by its global id
+     * @param id The global id of the polyomino
+     * @returns The polyomino's grid as loaded within blokus::rawPolyominoData() (the monomino for an invalid id)
+     */
+    const std::vector<std::vector<bool>> &polyominoGrid(const unsigned short &id) {
+        const blokus::polyType type = blokus::polyominoSet(id);
+        if (type == blokus::POLYTYPE_SENTINAL || (std::size_t)(id - blokus::polyominoSetStart(type)) >= blokus::rawPolyominoData(type).size()) {
+            return blokus::rawPolyominoData(blokus::POLYTYPE_BASE).at(0);
+        }
+        return blokus::rawPolyominoData(type).at(id - blokus::polyominoSetStart(type));
+    }
+
+    /** Convert a polyomino grid into an orientation
+     * @param grid The polyomino grid to convert
+     * @returns The grid as an orientation, trimmed to its bounding box
+     */
+    blokus::orientation gridToOrientation(const std::vector<std::vector<bool>> &grid) {
+        blokus::orientation output;
+        unsigned char minX = UCHAR_MAX, minY = UCHAR_MAX, maxX = 0, maxY = 0;
+        for (unsigned char i = 0; i < grid.size(); i++) {
+            for (unsigned char j = 0; j < grid.at(i).size(); j++) {
+                if (!grid.at(i).at(j)) {
+                    continue;
+                }
+                minX = j < minX ? j : minX;
+                minY = i < minY ? i : minY;
+                maxX = j > maxX ? j : maxX;
+                maxY = i > maxY ? i : maxY;
+            }
+        }
+        if (minX == UCHAR_MAX) {
+            return output;
+        }
+        for (unsigned char i = minY; i <= maxY; i++) {
+            for (unsigned char j = minX; j <= maxX; j++) {
+                if (j < grid.at(i).size() && grid.at(i).at(j) && output.cellCount < 8) {
+                    output.cells[output.cellCount++] = {(unsigned char)(j - minX), (unsigned char)(i - minY)};
+                    output.rows[i - minY] |= 1 << (j - minX);
+                }
+            }
+        }
+        output.width = maxX - minX + 1;
+        output.height = maxY - minY + 1;
+        return output;
+    }
+
+    /** Generate every distinct orientation of a polyomino
+     *
+     * Orientations are produced in a fixed order (the four counter-clockwise rotations of the grid, then the four rotations of its horizontal mirror) with duplicates removed, so an orientation index is stable between runs
+     * @param grid The polyomino grid
+     * @returns A list of the distinct orientations of the polyomino
+     */
+    std::vector<blokus::orientation> generateOrientations(const std::vector<std::vector<bool>> &grid) {
+        std::vector<blokus::orientation> output;
+        if (grid.size() == 0 || grid.at(0).size() == 0 || !btils::isRectangular(grid)) {
+            return output;
+        }
+
+        std::vector<std::vector<bool>> current = grid;
+        for (unsigned char i = 0; i < 8; i++) {
+            if (i == 4) {
+                current = btils::flipMatrix<bool>(grid, false);
+            } else if (i > 0) {
+                current = btils::rotateMatrix<bool>(current, true);
+            }
+
+            const blokus::orientation candidate = blokus::gridToOrientation(current);
+            bool duplicate = false;
+            for (std::size_t j = 0; j < output.size() && !duplicate; j++) {
+                if (output.at(j).width != candidate.width || output.at(j).height != candidate.height) {
+                    continue;
+                }
+                duplicate = true;
+                for (unsigned char k = 0; k < candidate.cellCount; k++) {
+                    if (output.at(j).cells[k].x != candidate.cells[k].x || output.at(j).cells[k].y != candidate.cells[k].y) {
+                        duplicate = false;
+                        break;
+                    }
+                }
+            }
+            if (!duplicate) {
+                output.push_back(candidate);
+            }
+        }
+        return output;
+    }
+
+    /** Generate the orientations of every polyomino within a set
+     * @param type The polyomino set
+     * @returns A list (indexed by global polyomino id - the set's first id) of lists of orientations
+     */
+    std::vector<std::vector<blokus::orientation>> generateSetOrientations(const blokus::polyType &type) {
+        std::vector<std::vector<blokus::orientation>> output;
+        const unsigned short start = blokus::polyominoSetStart(type);
+        for (unsigned short i = 0; i < blokus::polyominoAmounts[type]; i++) {
+            output.push_back(blokus::generateOrientations(blokus::polyominoGrid(start + i)));
+        }
+        return output;
+    }
+
+    /** Get the orientations of a polyomino
+     *
+     * Base pieces are served straight from the compile-time blokus::basePieces; the orientations of each larger set are generated (and the set's file read) the first time any of its polyominoes is asked for
+     * @param id The global id of the polyomino
+     * @returns The polyomino's orientations (empty for an invalid id)
+     */
+    blokus::orientationList orientations(const unsigned short &id) {
+        const blokus::polyType type = blokus::polyominoSet(id);
+        const std::vector<std::vector<blokus::orientation>> *set = nullptr;
+        switch (type) {
+            case blokus::POLYTYPE_BASE:
+                return {blokus::basePieces.orientations[id], blokus::basePieces.orientationCounts[id]};
+            case blokus::POLYTYPE_HEX: {
+                static const std::vector<std::vector<blokus::orientation>> hex = blokus::generateSetOrientations(blokus::POLYTYPE_HEX);
+                set = &hex;
+                break;
+            }
+            case blokus::POLYTYPE_HEPT: {
+                static const std::vector<std::vector<blokus::orientation>> hept = blokus::generateSetOrientations(blokus::POLYTYPE_HEPT);
+                set = &hept;
+                break;
+            }
+            case blokus::POLYTYPE_OCT: {
+                static const std::vector<std::vector<blokus::orientation>> oct = blokus::generateSetOrientations(blokus::POLYTYPE_OCT);
+                set = &oct;
+                break;
+            }
+            default:
+                return {};
+        }
+        const std::vector<blokus::orientation> &found = set->at(id - blokus::polyominoSetStart(type));
+        return {found.data(), (unsigned char)found.size()};
+    }
+
+    /** Get the amount of tiles a polyomino takes up
+     * @param id The global id of the polyomino
+     * @returns The amount of tiles the polyomino takes up
+     */
+    unsigned char polyominoTileCount(const unsigned short &id) {
+        const blokus::orientationList found = blokus::orientations(id);
+        return found.size() == 0 ? 0 : found[0].cellCount;
+    }
+}
+
+#endif // BLOKUS_ORIENTATIONS_hpp
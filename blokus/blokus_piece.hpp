@@ -39,10 +39,10 @@ namespace blokus {
                 // The base set of polyominoes has a special way of determining the amount of tiles a given piece has, hence the seperation
                 if (id < blokus::polyominoAmounts[blokus::POLYTYPE_BASE]) {
                     this->id = id;
-                    this->grid = blokus::rawPolyominoData.at(blokus::POLYTYPE_BASE).at(id);
-                    for (unsigned char i = 0; i < blokus::rawPolyominoData.at(blokus::POLYTYPE_BASE).at(id).size(); i++) {
-                        for (unsigned char j = 0; j < blokus::rawPolyominoData.at(blokus::POLYTYPE_BASE).at(id).at(i).size(); j++) {
-                            if (blokus::rawPolyominoData.at(blokus::POLYTYPE_BASE).at(id).at(i).at(j)) {
+                    this->grid = blokus::rawPolyominoData(blokus::POLYTYPE_BASE).at(id);
+                    for (unsigned char i = 0; i < blokus::rawPolyominoData(blokus::POLYTYPE_BASE).at(id).size(); i++) {
+                        for (unsigned char j = 0; j < blokus::rawPolyominoData(blokus::POLYTYPE_BASE).at(id).at(i).size(); j++) {
+                            if (blokus::rawPolyominoData(blokus::POLYTYPE_BASE).at(id).at(i).at(j)) {
                                 this->tiles++;
                             }
                         }
@@ -55,8 +55,8 @@ namespace blokus {
                 // Any non-base piece's properties can be determined purely by its id so can be lumped together code-wise
                 for (blokus::polyominoType i = blokus::POLYTYPE_HEX; i <= blokus::POLYTYPE_OCT; i++) {
                     if (id < this->id + blokus::polyominoAmounts[i]) {
+                        this->grid = blokus::rawPolyominoData(i).at(id - this->id);
                         this->id = id;
-                        this->grid = blokus::rawPolyominoData.at(i).at(id - this->id);
                         this->tiles = i + 5;
                         return;
                     }
@@ -65,7 +65,7 @@ namespace blokus {
 
                 // Default case for a piece given a bad id (1x1 tile)
                 this->id = 0;
-                this->grid = blokus::rawPolyominoData.at(blokus::POLYTYPE_BASE).at(0);
+                this->grid = blokus::rawPolyominoData(blokus::POLYTYPE_BASE).at(0);
                 this->tiles = 1;
             }
 
@@ -104,6 +104,26 @@ namespace blokus {
             short getY() const {
                 return this->y;
             }
+            /** Get the grid of the piece in its current orientation
+             * @returns The grid of the piece
+             */
+            const std::vector<std::vector<bool>> &getGrid() const {
+                return this->grid;
+            }
+            /** Set the position of the piece
+             * @param x The new x-position of the piece in relation to the grid's top-left corner
+             * @param y The new y-position of the piece in relation to the grid's top-left corner
+             */
+            void setPosition(const short &x, const short &y) {
+                this->x = x;
+                this->y = y;
+            }
+            /** Set the grid of the piece (used to restore an orientation that was saved with getGrid())
+             * @param grid The new grid of the piece
+             */
+            void setGrid(const std::vector<std::vector<bool>> &grid) {
+                this->grid = grid;
+            }
 
             /** Rotate the piece by 90 degrees an amount of times
              * @param ccw Whether to rotate counter-clockwise (true) or clockwise (false)
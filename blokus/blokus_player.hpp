@@ -14,90 +14,163 @@
 #include "blokus_piece.hpp"
 
 namespace blokus {
-    /// @brief The minimum amount of sets of a given polyomino type allowed in a game of Blokus
-    const Uint8 polySetMins[6] = {1, 0, 0, 0, 0, 0};
-    /// @brief The maximum amount of sets of a given polyomino type allowed in a game of Blokus
-    const Uint8 polySetMaxes[6] = {12, 4, 2, 1, 0, 0};
-
-    /** Take a desired amount of polyomino sets to use and confine that value to the mins/maxes allowed for that type
-     * @param type The type of polyomino being analyzed
-     * @param value The input for the amount of the given polyomino sets to uses
-     * @returns The amount of polyomino sets for the given polyType as bounded
+    /** Every player in a game, stored as a struct of arrays
+     *
+     * The values read every frame/turn (remaining pieces and tiles per set) sit in small contiguous arrays indexed by player, so a loop over the players touches a handful of cache lines.
+     * Names, colors, and the piece lists themselves are only needed when something about a specific player changes or is drawn, so they are kept apart
      */
-    Uint8 processPolyominoSet(const blokus::polyType &type, const Uint8 &value) {
-        if (type > blokus::POLYTYPE_DEC) {
-            return 0;
-        }
-        return value > blokus::polySetMaxes[type] ? blokus::polySetMaxes[type] : (value < blokus::polySetMins[type] ? blokus::polySetMins[type] : value);
-    }
-
-    class player {
+    class playerTable {
         private:
-            std::u16string name = u"Red";
-            SDL_Color color = {255, 0, 0, 255};
+            /// @brief The amount of players in the table
+            Uint8 count = 0;
+
+            /// @brief The amount of pieces each player has left of each polyomino type; player-major (player * 4 + type)
+            std::vector<Uint16> remainingPieces = {};
+            /// @brief The amount of tiles each player has left in each polyomino type; player-major (player * 4 + type)
+            std::vector<Uint16> remainingTiles = {};
+
+            /// @brief The name of each player
+            std::vector<std::u16string> names = {};
+            /// @brief The color of each player
+            std::vector<SDL_Color> colors = {};
+            /// @brief The pieces each player has left, split by polyomino type ([player][type])
+            std::vector<std::vector<std::vector<blokus::piece>>> pieces = {};
 
-            std::vector<std::vector<blokus::piece>> pieces;
+            /** Recount the hot values of one player's polyomino type from its piece list
+             * @param player The player
+             * @param type The polyomino type (base, hex, hept, oct)
+             */
+            void recount(const Uint8 &player, const blokus::polyominoType &type) {
+                const std::vector<blokus::piece> &list = this->pieces[player][type];
+                Uint16 tiles = 0;
+                for (std::size_t i = 0; i < list.size(); i++) {
+                    tiles += list[i].getTiles();
+                }
+                this->remainingPieces[player * 4 + type] = list.size();
+                this->remainingTiles[player * 4 + type] = tiles;
+            }
 
         public:
-            player(const Uint8 &baseSets = polySetMins[blokus::POLYTYPE_BASE], const Uint8 &hexSets = polySetMins[blokus::POLYTYPE_HEX], const Uint8 &heptSets = polySetMins[blokus::POLYTYPE_HEPT], const Uint8 &octSets = polySetMins[blokus::POLYTYPE_OCT]) {
+            /** blokus::playerTable constructor
+             * @param playerCount The amount of players
+             * @param baseSets The amount of base sets each player gets
+             * @param hexSets The amount of hexomino sets each player gets
+             * @param heptSets The amount of heptomino sets each player gets
+             * @param octSets The amount of octomino sets each player gets
+             */
+            playerTable(const Uint8 &playerCount = 0, const Uint8 &baseSets = polySetMins[blokus::POLYTYPE_BASE], const Uint8 &hexSets = polySetMins[blokus::POLYTYPE_HEX], const Uint8 &heptSets = polySetMins[blokus::POLYTYPE_HEPT], const Uint8 &octSets = polySetMins[blokus::POLYTYPE_OCT]) {
+                this->reset(playerCount, baseSets, hexSets, heptSets, octSets);
+            }
+
+            /** Replace every player with a fresh one holding full piece sets
+             * @param playerCount The amount of players
+             * @param baseSets The amount of base sets each player gets
+             * @param hexSets The amount of hexomino sets each player gets
+             * @param heptSets The amount of heptomino sets each player gets
+             * @param octSets The amount of octomino sets each player gets
+             */
+            void reset(const Uint8 &playerCount, const Uint8 &baseSets, const Uint8 &hexSets, const Uint8 &heptSets, const Uint8 &octSets) {
                 const Uint8 setValues[4] = {baseSets, hexSets, heptSets, octSets};
 
-                Uint16 idStart = 0;
-                for (blokus::polyType i = blokus::POLYTYPE_BASE; i <= blokus::POLYTYPE_OCT; i++) {
-                    this->pieces.emplace_back();
-                    for (Uint8 j = 0; j < setValues[i]; j++) {
-                        for (Uint8 k = 0; k < blokus::polyominoAmounts[i]; k++) {
-                            this->pieces[i].emplace_back(blokus::piece(idStart + k));
+                this->count = playerCount;
+                this->remainingPieces.assign(playerCount * 4, 0);
+                this->remainingTiles.assign(playerCount * 4, 0);
+                this->names.assign(playerCount, u"");
+                this->colors.assign(playerCount, {255, 0, 0, 255});
+                this->pieces.assign(playerCount, std::vector<std::vector<blokus::piece>>(4));
+
+                for (Uint8 p = 0; p < playerCount; p++) {
+                    Uint16 idStart = 0;
+                    for (blokus::polyType i = blokus::POLYTYPE_BASE; i <= blokus::POLYTYPE_OCT; i++) {
+                        for (Uint8 j = 0; j < setValues[i]; j++) {
+                            for (Uint16 k = 0; k < blokus::polyominoAmounts[i]; k++) {
+                                this->pieces[p][i].emplace_back(idStart + k);
+                            }
                         }
+                        idStart += blokus::polyominoAmounts[i];
+                        this->recount(p, i);
                     }
-                    idStart += blokus::polyominoAmounts[i];
                 }
             }
 
-            void printPieces(const blokus::polyominoType &type) const {
-                if (type < blokus::POLYTYPE_BASE || type > blokus::POLYTYPE_OCT) {
-                    return;
-                }
-                for (Uint16 i = 0; i < this->pieces.at(type).size(); i++) {
-                    this->pieces.at(type).at(i).print();
-                }
+            /** Get the amount of players in the table
+             * @returns The amount of players in the table
+             */
+            Uint8 size() const {
+                return this->count;
             }
 
-            Uint16 getRemainingPieces(const blokus::polyominoType &type) const {
-                if (type >= blokus::POLYTYPE_BASE && type <= blokus::POLYTYPE_OCT) {
-                    return (Uint16)this->pieces.at(type).size();
+            /** Get the amount of pieces a player has left
+             * @param player The player
+             * @param type The polyomino type (base, hex, hept, oct), or POLYTYPE_SENTINAL for every type
+             * @returns The amount of pieces left
+             */
+            Uint16 getRemainingPieces(const Uint8 &player, const blokus::polyominoType &type) const {
+                if (type <= blokus::POLYTYPE_OCT) {
+                    return this->remainingPieces.at(player * 4 + type);
                 }
-                return this->getRemainingPieces(blokus::POLYTYPE_BASE) + this->getRemainingPieces(blokus::POLYTYPE_HEX) + this->getRemainingPieces(blokus::POLYTYPE_HEPT) + this->getRemainingPieces(blokus::POLYTYPE_OCT);
+                const Uint16 *counts = this->remainingPieces.data() + player * 4;
+                return counts[0] + counts[1] + counts[2] + counts[3];
             }
-
-            Uint16 getRemainingTiles(const blokus::polyominoType &type) const {
-                if (type == blokus::POLYTYPE_BASE) {
-                    Uint16 output = 0;
-                    for (Uint8 i = 0; i < this->pieces.at(blokus::POLYTYPE_BASE).size(); i++) {
-                        output += this->pieces.at(blokus::POLYTYPE_BASE).at(i).getTiles();
-                    }
-                    return output;
-                } else if (type >= blokus::POLYTYPE_HEX && type <= blokus::POLYTYPE_OCT) {
-                    return (Uint16)this->pieces.at(type).size() * blokus::polyominoTiles[type];
+            /** Get the amount of tiles a player has left
+             * @param player The player
+             * @param type The polyomino type (base, hex, hept, oct), or POLYTYPE_SENTINAL for every type
+             * @returns The amount of tiles left
+             */
+            Uint16 getRemainingTiles(const Uint8 &player, const blokus::polyominoType &type) const {
+                if (type <= blokus::POLYTYPE_OCT) {
+                    return this->remainingTiles.at(player * 4 + type);
                 }
-                return this->getRemainingTiles(blokus::POLYTYPE_BASE) + this->getRemainingTiles(blokus::POLYTYPE_HEX) + this->getRemainingTiles(blokus::POLYTYPE_HEPT) + this->getRemainingTiles(blokus::POLYTYPE_OCT);
+                const Uint16 *counts = this->remainingTiles.data() + player * 4;
+                return counts[0] + counts[1] + counts[2] + counts[3];
             }
-
-            std::u16string getName() const {
-                return this->name;
+            /** Get the pieces a player has left of a polyomino type
+             * @param player The player
+             * @param type The polyomino type (base, hex, hept, oct)
+             * @returns The pieces left
+             */
+            const std::vector<blokus::piece> &getPieces(const Uint8 &player, const blokus::polyominoType &type) const {
+                return this->pieces.at(player).at(type);
+            }
+            /** Replace the pieces a player has left of a polyomino type
+             * @param player The player
+             * @param type The polyomino type (base, hex, hept, oct)
+             * @param pieces The new pieces
+             */
+            void setPieces(const Uint8 &player, const blokus::polyominoType &type, const std::vector<blokus::piece> &pieces) {
+                this->pieces.at(player).at(type) = pieces;
+                this->recount(player, type);
+            }
+            /** Get the name of a player
+             * @param player The player
+             * @returns The name of the player
+             */
+            const std::u16string &getName(const Uint8 &player) const {
+                return this->names.at(player);
             }
-            std::u16string setName(const std::u16string &name) {
-                return btils::set<std::u16string>(this->name, name);
+            /** Set the name of a player
+             * @param player The player
+             * @param name The new name of the player
+             * @returns The old name of the player
+             */
+            std::u16string setName(const Uint8 &player, const std::u16string &name) {
+                return btils::set<std::u16string>(this->names.at(player), name);
             }
-            SDL_Color getColor() const {
-                return this->color;
+            /** Get the color of a player
+             * @param player The player
+             * @returns The color of the player
+             */
+            SDL_Color getColor(const Uint8 &player) const {
+                return this->colors.at(player);
             }
-            SDL_Color setColor(const SDL_Color &color) {
-                const SDL_Color output = this->color;
-                this->color.r = color.r;
-                this->color.g = color.g;
-                this->color.b = color.b;
-                this->color.a = color.a;
+            /** Set the color of a player
+             * @param player The player
+             * @param color The new color of the player
+             * @returns The old color of the player
+             */
+            SDL_Color setColor(const Uint8 &player, const SDL_Color &color) {
+                const SDL_Color output = this->colors.at(player);
+                this->colors[player] = color;
                 return output;
             }
     };
@@ -7,6 +7,8 @@
 #include <iostream>
 #include <climits>
 
+#include "blokus_basePieces.hpp"
+
 /** Formatting for polyomino storage files:
  * d (dims of each polyomino; usually the amount of cells in each)
  * c (amount of polyominoes in the file)
@@ -49,6 +51,23 @@ namespace blokus {
         POLYTYPE_SENTINAL = ULLONG_MAX    // A sentinal value for polyomino types
     } polyominoTypes;
 
+    /// @brief The minimum amount of sets of a given polyomino type allowed in a game of Blokus
+    const unsigned char polySetMins[6] = {1, 0, 0, 0, 0, 0};
+    /// @brief The maximum amount of sets of a given polyomino type allowed in a game of Blokus
+    const unsigned char polySetMaxes[6] = {12, 4, 2, 1, 0, 0};
+
+    /** Take a desired amount of polyomino sets to use and confine that value to the mins/maxes allowed for that type
+     * @param type The type of polyomino being analyzed
+     * @param value The input for the amount of the given polyomino sets to uses
+     * @returns The amount of polyomino sets for the given polyType as bounded
+     */
+    unsigned char processPolyominoSet(const blokus::polyType &type, const unsigned char &value) {
+        if (type > blokus::POLYTYPE_DEC) {
+            return 0;
+        }
+        return value > blokus::polySetMaxes[type] ? blokus::polySetMaxes[type] : (value < blokus::polySetMins[type] ? blokus::polySetMins[type] : value);
+    }
+
     /** Load a text file containing polyomino information into a 3-dimensional std::vector
      * @param filepath The path to the file to read from
      * @returns A 3-dimensional std::vector containing the information for a list of polyominoes
@@ -135,13 +154,34 @@ namespace blokus {
         return output;
     }
 
-    /// @brief A list of lists of grids that represent the cell data of each polyomino
-    const std::vector<std::vector<std::vector<std::vector<bool>>>> rawPolyominoData = {
-        blokus::readPolyominoFile("dev/polyominoes/base.txt"),
-        blokus::readPolyominoFile("dev/polyominoes/hexominoes.txt"),
-        blokus::readPolyominoFile("dev/polyominoes/heptominoes.txt"),
-        blokus::readPolyominoFile("dev/polyominoes/octominoes.txt")
-    };
+    /** Get the grids of every polyomino within a set
+     *
+     * The base set is compiled in (blokus::baseGrids) rather than read from dev/polyominoes/base.txt; every other set is read from its file the first time it is asked for, so a game with only the base set never touches the disk
+     * @param type The polyomino set (base, hex, hept, oct)
+     * @returns A list of grids that represent the cell data of each polyomino within the set (empty for any other set)
+     */
+    const std::vector<std::vector<std::vector<bool>>> &rawPolyominoData(const blokus::polyType &type) {
+        static const std::vector<std::vector<std::vector<bool>>> base = blokus::basePolyominoGrids();
+        static const std::vector<std::vector<std::vector<bool>>> none = {};
+        switch (type) {
+            case blokus::POLYTYPE_BASE:
+                return base;
+            case blokus::POLYTYPE_HEX: {
+                static const std::vector<std::vector<std::vector<bool>>> hex = blokus::readPolyominoFile("dev/polyominoes/hexominoes.txt");
+                return hex;
+            }
+            case blokus::POLYTYPE_HEPT: {
+                static const std::vector<std::vector<std::vector<bool>>> hept = blokus::readPolyominoFile("dev/polyominoes/heptominoes.txt");
+                return hept;
+            }
+            case blokus::POLYTYPE_OCT: {
+                static const std::vector<std::vector<std::vector<bool>>> oct = blokus::readPolyominoFile("dev/polyominoes/octominoes.txt");
+                return oct;
+            }
+            default:
+                return none;
+        }
+    }
 
     /** Print out a single polyomino
      * @param grid A 2D std::vector of booleans representing a polyomino
@@ -163,13 +203,13 @@ namespace blokus {
             blokus::printPolyomino(list.at(polyomino));
         }
     }
-    /** Print out a single polyomino from the list of polyominoes loaded within blokus::rawPolyominoData
+    /** Print out a single polyomino from the list of polyominoes loaded within blokus::rawPolyominoData()
      * @param pieceSet Which of the piece sets to use (base, hex, hept, oct)
      * @param polyomino Which of the polyominoes from the piece set to print
      */
     void printPolyomino(const std::size_t &pieceSet, const std::size_t &polyomino) {
-        if (pieceSet < blokus::rawPolyominoData.size() && polyomino < blokus::rawPolyominoData.at(pieceSet).size()) {
-            blokus::printPolyomino(blokus::rawPolyominoData.at(pieceSet).at(polyomino));
+        if (polyomino < blokus::rawPolyominoData(pieceSet).size()) {
+            blokus::printPolyomino(blokus::rawPolyominoData(pieceSet).at(polyomino));
         }
     }
 }
@@ -0,0 +1,344 @@
+#ifndef BLOKUS_RECORD_hpp
+#define BLOKUS_RECORD_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "blokus_file.hpp"
+#include "blokus_state.hpp"
+
+namespace blokus {
+    /// @brief The version of the game record format
+    const std::uint32_t recordVersion = 1;
+    /// @brief The bytes every game record starts with
+    const char recordMagic[8] = {'B', 'L', 'K', 'G', 'A', 'M', 'E', '\0'};
+
+    /** Append an unsigned integer as a LEB128 varint (7 bits per byte, low bits first)
+     * @param output The list to append to
+     * @param value The value to append
+     */
+    void writeVarint(std::vector<std::uint8_t> &output, std::uint64_t value) {
+        while (value >= 0x80) {
+            output.push_back((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        output.push_back(value);
+    }
+    /** Read a LEB128 varint
+     * @param input The position to read from (advanced past the varint)
+     * @param end The end of the readable bytes
+     * @param value Set to the value read
+     * @returns Whether a whole varint was read
+     */
+    bool readVarint(const std::uint8_t *&input, const std::uint8_t *end, std::uint64_t &value) {
+        value = 0;
+        for (unsigned char shift = 0; input < end && shift < 64; shift += 7) {
+            const std::uint8_t byte = *input++;
+            value |= (std::uint64_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** A whole game stored as its setup plus the moves played
+     *
+     * On disk: the magic bytes, then varints for the version, board size, player count, the four piece set counts, the seed, and the move count, then one varint per move.
+     * A move packs into a single number (0 for a pass, otherwise 1 + ((polyomino * 8 + orientation) * size + y) * size + x), so a Classic move takes 3 bytes and even a 100x100 octomino move only 4
+     */
+    class gameRecord {
+        private:
+            /// @brief The side length of the board
+            unsigned char size = 20;
+            /// @brief The amount of players
+            unsigned char playerCount = 4;
+            /// @brief The amount of base, hexomino, heptomino, and octomino sets each player starts with
+            unsigned char sets[4] = {1, 0, 0, 0};
+            /// @brief The seed the game was played with (for anything random, such as computer players)
+            std::uint64_t seed = 0;
+            /// @brief The moves played, in order
+            std::vector<blokus::move> moves = {};
+
+        public:
+            /** blokus::gameRecord constructor
+             * @param boardSize The side length of the board
+             * @param playerCount The amount of players
+             * @param baseSets The amount of base sets each player starts with
+             * @param hexSets The amount of hexomino sets each player starts with
+             * @param heptSets The amount of heptomino sets each player starts with
+             * @param octSets The amount of octomino sets each player starts with
+             * @param seed The seed the game was played with
+             */
+            gameRecord(const unsigned char &boardSize = 20, const unsigned char &playerCount = 4, const unsigned char &baseSets = 1, const unsigned char &hexSets = 0, const unsigned char &heptSets = 0, const unsigned char &octSets = 0, const std::uint64_t &seed = 0) : size(boardSize), playerCount(playerCount), sets{baseSets, hexSets, heptSets, octSets}, seed(seed) {}
+            /** blokus::gameRecord constructor
+             * @param s The state to record the setup and every move of
+             * @param seed The seed the game was played with
+             */
+            gameRecord(const blokus::state &s, const std::uint64_t &seed = 0) : size(s.getSize()), playerCount(s.getPlayerCount()), sets{s.getSets(blokus::POLYTYPE_BASE), s.getSets(blokus::POLYTYPE_HEX), s.getSets(blokus::POLYTYPE_HEPT), s.getSets(blokus::POLYTYPE_OCT)}, seed(seed) {
+                for (std::size_t i = 0; i < s.getPly(); i++) {
+                    this->moves.push_back(s.getMove(i));
+                }
+            }
+
+            /** Get the side length of the board
+             * @returns The side length of the board
+             */
+            unsigned char getSize() const {
+                return this->size;
+            }
+            /** Get the amount of players
+             * @returns The amount of players
+             */
+            unsigned char getPlayerCount() const {
+                return this->playerCount;
+            }
+            /** Get the amount of copies of a polyomino set each player starts with
+             * @param type The polyomino set (POLYTYPE_BASE to POLYTYPE_OCT)
+             * @returns The amount of copies of the set
+             */
+            unsigned char getSets(const blokus::polyType &type) const {
+                return type <= blokus::POLYTYPE_OCT ? this->sets[type] : 0;
+            }
+            /** Get the seed the game was played with
+             * @returns The seed the game was played with
+             */
+            std::uint64_t getSeed() const {
+                return this->seed;
+            }
+            /** Get the moves played
+             * @returns The moves played, in order
+             */
+            const std::vector<blokus::move> &getMoves() const {
+                return this->moves;
+            }
+
+            /** Add a move to the end of the record
+             * @param m The move played
+             */
+            void push(const blokus::move &m) {
+                this->moves.push_back(m);
+            }
+            /** Create the state the game started from
+             * @returns The starting state of the game
+             */
+            blokus::state start() const {
+                return blokus::state(this->size, this->playerCount, this->sets[blokus::POLYTYPE_BASE], this->sets[blokus::POLYTYPE_HEX], this->sets[blokus::POLYTYPE_HEPT], this->sets[blokus::POLYTYPE_OCT]);
+            }
+
+            /** Pack a move into a single number
+             * @param m The move to pack
+             * @returns The packed move
+             */
+            std::uint64_t packMove(const blokus::move &m) const {
+                if (m.isPass()) {
+                    return 0;
+                }
+                return 1 + (((std::uint64_t)m.polyomino * 8 + m.orientation) * this->size + m.y) * this->size + m.x;
+            }
+            /** Unpack a number made by packMove()
+             * @param value The packed move
+             * @returns The move
+             */
+            blokus::move unpackMove(std::uint64_t value) const {
+                if (value == 0) {
+                    return blokus::move::pass();
+                }
+                value--;
+                blokus::move output;
+                output.x = value % this->size;
+                value /= this->size;
+                output.y = value % this->size;
+                value /= this->size;
+                output.orientation = value % 8;
+                output.polyomino = value / 8;
+                return output;
+            }
+
+            /** Append the record in its binary form to a list of bytes
+             * @param output The list to append to
+             */
+            void encode(std::vector<std::uint8_t> &output) const {
+                output.insert(output.end(), blokus::recordMagic, blokus::recordMagic + 8);
+                blokus::writeVarint(output, blokus::recordVersion);
+                blokus::writeVarint(output, this->size);
+                blokus::writeVarint(output, this->playerCount);
+                for (unsigned char i = 0; i < 4; i++) {
+                    blokus::writeVarint(output, this->sets[i]);
+                }
+                blokus::writeVarint(output, this->seed);
+                blokus::writeVarint(output, this->moves.size());
+                for (std::size_t i = 0; i < this->moves.size(); i++) {
+                    blokus::writeVarint(output, this->packMove(this->moves[i]));
+                }
+            }
+            /** Read a record from its binary form
+             * @param input The position to read from (advanced past the record, so records can be stored back to back)
+             * @param end The end of the readable bytes
+             * @returns Whether a whole record was read
+             */
+            bool decode(const std::uint8_t *&input, const std::uint8_t *end) {
+                if (end - input < 8 || std::memcmp(input, blokus::recordMagic, 8) != 0) {
+                    return false;
+                }
+                input += 8;
+                std::uint64_t values[9];
+                for (unsigned char i = 0; i < 9; i++) {
+                    if (!blokus::readVarint(input, end, values[i])) {
+                        return false;
+                    }
+                }
+                if (values[0] != blokus::recordVersion || values[1] < 20 || values[1] > blokus::maxBoardSize || values[2] < 2 || values[2] > blokus::maxPlayers) {
+                    return false;
+                }
+                this->size = values[1];
+                this->playerCount = values[2];
+                for (unsigned char i = 0; i < 4; i++) {
+                    this->sets[i] = values[3 + i];
+                }
+                this->seed = values[7];
+                this->moves.clear();
+                // Every move takes at least a byte, which bounds the reservation for corrupt counts
+                this->moves.reserve(values[8] < (std::uint64_t)(end - input) ? values[8] : end - input);
+                for (std::uint64_t i = 0; i < values[8]; i++) {
+                    std::uint64_t packed;
+                    if (!blokus::readVarint(input, end, packed)) {
+                        return false;
+                    }
+                    this->moves.push_back(this->unpackMove(packed));
+                }
+                return true;
+            }
+
+            /** Save the record to a file
+             * @param path The path of the file
+             * @returns Whether the file was written
+             */
+            bool save(const std::string &path) const {
+                std::vector<std::uint8_t> bytes;
+                this->encode(bytes);
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) {
+                    std::cout << "ERROR: Could not write game record \"" << path << "\"\n";
+                    return false;
+                }
+                file.write((const char *)bytes.data(), bytes.size());
+                return file.good();
+            }
+            /** Load the record from a file
+             * @param path The path of the file
+             * @returns Whether the record was loaded
+             */
+            bool load(const std::string &path) {
+                blokus::mappedFile file(path);
+                if (!file.isOpen()) {
+                    return false;
+                }
+                const std::uint8_t *input = (const std::uint8_t *)file.data();
+                if (!this->decode(input, input + file.size())) {
+                    std::cout << "ERROR: \"" << path << "\" is not a version " << blokus::recordVersion << " game record\n";
+                    return false;
+                }
+                return true;
+            }
+    };
+
+    /** Plays back a game record with fast seeking
+     *
+     * The record is played through once when loaded, keeping a copy of the state every keyframeInterval moves.
+     * Seeking then starts from the nearest keyframe at or before the target (or from the current position when that is closer, stepping backwards with undo) so no seek applies more than about keyframeInterval moves
+     */
+    class replay {
+        private:
+            /// @brief The moves being played back (only the legal prefix of the record)
+            std::vector<blokus::move> moves = {};
+            /// @brief The amount of moves between keyframes
+            std::size_t keyframeInterval = 64;
+            /// @brief The state after every keyframeInterval-th move (keyframe i is after move i * keyframeInterval)
+            std::vector<blokus::state> keyframes = {};
+            /// @brief The state at the current position
+            blokus::state current;
+
+        public:
+            /** blokus::replay constructor
+             * @param record The record to play back
+             * @param keyframeInterval The amount of moves between keyframes
+             */
+            replay(const blokus::gameRecord &record, const std::size_t &keyframeInterval = 64) : keyframeInterval(keyframeInterval < 1 ? 1 : keyframeInterval), current(record.start()) {
+                this->keyframes.push_back(this->current);
+                const std::vector<blokus::move> &recorded = record.getMoves();
+                for (std::size_t i = 0; i < recorded.size(); i++) {
+                    if (this->current.isOver() || !this->current.isLegal(this->current.getTurn(), recorded[i])) {
+                        std::cout << "ERROR: Game record has an illegal move at ply " << i << "; playback stops there\n";
+                        break;
+                    }
+                    this->current.play(recorded[i]);
+                    this->moves.push_back(recorded[i]);
+                    if (this->moves.size() % this->keyframeInterval == 0) {
+                        this->keyframes.push_back(this->current);
+                    }
+                }
+            }
+
+            /** Get the amount of moves that can be played back
+             * @returns The amount of moves that can be played back
+             */
+            std::size_t size() const {
+                return this->moves.size();
+            }
+            /** Get the current position
+             * @returns The amount of moves applied to reach the current state
+             */
+            std::size_t getPly() const {
+                return this->current.getPly();
+            }
+            /** Get the state at the current position
+             * @returns The state at the current position
+             */
+            const blokus::state &getState() const {
+                return this->current;
+            }
+
+            /** Move to the state after a given amount of moves
+             * @param ply The amount of moves to have applied (clamped to size())
+             * @returns The state after that many moves
+             */
+            const blokus::state &seek(std::size_t ply) {
+                ply = ply > this->moves.size() ? this->moves.size() : ply;
+                const std::size_t at = this->current.getPly();
+                const std::size_t keyframe = ply / this->keyframeInterval;
+
+                if (ply < at && at - ply <= ply - keyframe * this->keyframeInterval) {
+                    while (this->current.getPly() > ply) {
+                        this->current.undo();
+                    }
+                    return this->current;
+                }
+                if (ply < at || ply - at > ply - keyframe * this->keyframeInterval) {
+                    this->current = this->keyframes[keyframe];
+                }
+                while (this->current.getPly() < ply) {
+                    this->current.play(this->moves[this->current.getPly()]);
+                }
+                return this->current;
+            }
+            /** Step forwards one move
+             * @returns The state after the step
+             */
+            const blokus::state &next() {
+                return this->seek(this->current.getPly() + 1);
+            }
+            /** Step backwards one move
+             * @returns The state after the step
+             */
+            const blokus::state &previous() {
+                return this->seek(this->current.getPly() == 0 ? 0 : this->current.getPly() - 1);
+            }
+    };
+}
+
+#endif // BLOKUS_RECORD_hpp
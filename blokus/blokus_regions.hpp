@@ -0,0 +1,336 @@
+#ifndef BLOKUS_REGIONS_hpp
+#define BLOKUS_REGIONS_hpp
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "blokus_bitboard.hpp"
+#include "blokus_state.hpp"
+
+namespace blokus {
+    /** Decomposition of the board into the regions each player can still reach
+     *
+     * A player's reach is every cell they could ever cover from this point onwards: an 8-connected flood fill from their anchors through the cells they may currently cover.
+     * Any future piece is edge-connected and its anchor is corner-adjacent to an earlier tile, so the reach is a safe over-approximation; it only ever shrinks as pieces are placed.
+     * Each player's reach is split into connected components; a component no other player can reach is a closed pocket that can be evaluated on its own
+     */
+    class regionMap {
+        private:
+            /// @brief The side length of the board
+            unsigned char size = 20;
+            /// @brief The amount of players in the game
+            unsigned char playerCount = 4;
+            /// @brief The connected components of each player's reach; only the first componentCounts[i] are in use, the rest are kept so that later updates can reuse their memory
+            std::vector<blokus::bitboard> components[blokus::maxPlayers] = {};
+            /// @brief The amount of components in use for each player
+            std::size_t componentCounts[blokus::maxPlayers] = {0, 0, 0, 0};
+
+            /// @brief The components an update is flood-filling again (scratch for update())
+            std::vector<blokus::bitboard> touched = {};
+            /// @brief The cells of the move being applied (scratch for update())
+            blokus::bitboard placed;
+            /// @brief The cells a player may currently cover (scratch for rebuild()/update())
+            blokus::bitboard allowed;
+            /// @brief The cells a flood may pass through (scratch for update())
+            blokus::bitboard within;
+            /// @brief The anchors a flood has yet to reach (scratch for rebuild()/update())
+            blokus::bitboard seeds;
+
+            /** Change the side length of the board, dropping every component and resizing the scratch boards
+             * @param size The new side length of the board
+             */
+            void resize(const unsigned char &size) {
+                this->size = size;
+                for (unsigned char i = 0; i < blokus::maxPlayers; i++) {
+                    this->components[i].clear();
+                    this->componentCounts[i] = 0;
+                }
+                this->touched.clear();
+                this->placed = blokus::bitboard(size);
+                this->allowed = blokus::bitboard(size);
+                this->within = blokus::bitboard(size);
+                this->seeds = blokus::bitboard(size);
+            }
+            /** Add a component to a player, reusing a board kept from earlier if there is one
+             * @param player The player
+             * @returns The new component (its contents are left over from earlier use)
+             */
+            blokus::bitboard &addComponent(const unsigned char &player) {
+                if (this->componentCounts[player] == this->components[player].size()) {
+                    this->components[player].emplace_back(this->size);
+                }
+                return this->components[player][this->componentCounts[player]++];
+            }
+            /** Split the cells reachable from a set of seeds into connected components, adding them to a player
+             * @param player The player to add the components to
+             * @param seeds The cells to flood from (must be within allowed; emptied by the flood)
+             * @param allowed The cells the flood may pass through
+             */
+            void flood(const unsigned char &player, blokus::bitboard &seeds, const blokus::bitboard &allowed) {
+                int x, y;
+                while (seeds.findFirst(x, y)) {
+                    blokus::bitboard &current = this->addComponent(player);
+                    current.clear();
+                    current.set(x, y);
+                    while (current.expand(allowed, true)) {}
+                    seeds.remove(current);
+                }
+            }
+
+        public:
+            /** blokus::regionMap constructor (no components until rebuild() or assign() is called)
+             * @param size The side length of the board
+             */
+            regionMap(const unsigned char &size = 20) {
+                this->resize(size);
+            }
+            /** blokus::regionMap constructor
+             * @param s The state to decompose
+             */
+            regionMap(const blokus::state &s) {
+                this->rebuild(s);
+            }
+
+            /** Recompute every region from scratch
+             * @param s The state to decompose
+             */
+            void rebuild(const blokus::state &s) {
+                if (this->placed.getSize() != s.getSize()) {
+                    this->resize(s.getSize());
+                }
+                this->playerCount = s.getPlayerCount();
+                for (unsigned char i = 0; i < blokus::maxPlayers; i++) {
+                    this->componentCounts[i] = 0;
+                }
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    if (!s.hasPassed(i)) {
+                        this->allowed = s.forbidden(i);
+                        this->allowed.invert();
+                        this->seeds = s.anchors(i);
+                        this->seeds &= this->allowed;
+                        this->flood(i, this->seeds, this->allowed);
+                    }
+                }
+            }
+            /** Copy the regions of another map into this one; once this map has held as many components as the source, no memory is allocated
+             * @param source The map to copy
+             */
+            void assign(const blokus::regionMap &source) {
+                if (this->placed.getSize() != source.size) {
+                    this->resize(source.size);
+                }
+                this->playerCount = source.playerCount;
+                for (unsigned char i = 0; i < blokus::maxPlayers; i++) {
+                    this->componentCounts[i] = 0;
+                    for (std::size_t j = 0; j < source.componentCounts[i]; j++) {
+                        this->addComponent(i) = source.components[i][j];
+                    }
+                }
+            }
+
+            /** Update the regions in place after a move; only the components the move touched are flood-filled again
+             * @param s The state after the move was played
+             * @param m The move that was played (must have been legal)
+             * @param player The player that played the move
+             */
+            void update(const blokus::state &s, const blokus::move &m, const unsigned char &player) {
+                if (m.isPass()) {
+                    this->componentCounts[player] = 0;
+                    return;
+                }
+
+                this->placed.clear();
+                const blokus::orientation &o = blokus::orientations(m.polyomino).at(m.orientation);
+                for (std::size_t i = 0; i < o.cellCount; i++) {
+                    this->placed.set(m.x + o.cells[i].x, m.y + o.cells[i].y);
+                }
+
+                // The mover also loses the cells sharing an edge with the new piece, but those are 8-connected to the piece within the mover's old reach, so they lie in the same component as it
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    if (s.hasPassed(i)) {
+                        this->componentCounts[i] = 0;
+                        continue;
+                    }
+                    // Swap the touched components out and close the gaps they leave behind
+                    std::vector<blokus::bitboard> &list = this->components[i];
+                    std::size_t kept = 0, touchedCount = 0;
+                    for (std::size_t j = 0; j < this->componentCounts[i]; j++) {
+                        if (list[j].intersects(this->placed)) {
+                            if (touchedCount == this->touched.size()) {
+                                this->touched.emplace_back(this->size);
+                            }
+                            std::swap(this->touched[touchedCount++], list[j]);
+                        } else {
+                            if (kept != j) {
+                                std::swap(list[kept], list[j]);
+                            }
+                            kept++;
+                        }
+                    }
+                    this->componentCounts[i] = kept;
+                    if (touchedCount == 0) {
+                        continue;
+                    }
+
+                    // Reach only shrinks, so each new component lies within one of the touched ones
+                    this->allowed = s.forbidden(i);
+                    this->allowed.invert();
+                    for (std::size_t j = 0; j < touchedCount; j++) {
+                        this->within = this->allowed;
+                        this->within &= this->touched[j];
+                        this->seeds = s.anchors(i);
+                        this->seeds &= this->within;
+                        this->flood(i, this->seeds, this->within);
+                    }
+                }
+            }
+
+            /** Get the side length of the board
+             * @returns The side length of the board
+             */
+            unsigned char getSize() const {
+                return this->size;
+            }
+            /** Get the amount of connected components in a player's reach
+             * @param player The player
+             * @returns The amount of connected components in the player's reach
+             */
+            std::size_t getComponentCount(const unsigned char &player) const {
+                return this->componentCounts[player];
+            }
+            /** Get one of the connected components of a player's reach
+             * @param player The player
+             * @param index The index of the component (less than getComponentCount(player))
+             * @returns The cells of the component
+             */
+            const blokus::bitboard &getComponent(const unsigned char &player, const std::size_t &index) const {
+                return this->components[player].at(index);
+            }
+            /** Get every cell a player could ever cover from this point onwards
+             * @param player The player
+             * @returns The player's reach
+             */
+            blokus::bitboard reach(const unsigned char &player) const {
+                blokus::bitboard output(this->size);
+                for (std::size_t i = 0; i < this->componentCounts[player]; i++) {
+                    output |= this->components[player][i];
+                }
+                return output;
+            }
+            /** Get the players that can reach any cell of one of a player's components
+             * @param player The player owning the component
+             * @param index The index of the component (less than getComponentCount(player))
+             * @returns A bitmask of the players that can reach the component (always includes the owner)
+             */
+            unsigned char contestants(const unsigned char &player, const std::size_t &index) const {
+                unsigned char output = 1 << player;
+                const blokus::bitboard &component = this->getComponent(player, index);
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    if (i == player) {
+                        continue;
+                    }
+                    for (std::size_t j = 0; j < this->componentCounts[i]; j++) {
+                        if (this->components[i][j].intersects(component)) {
+                            output |= 1 << i;
+                            break;
+                        }
+                    }
+                }
+                return output;
+            }
+            /** Check whether one of a player's components is a closed pocket (no other player can reach it)
+             * @param player The player owning the component
+             * @param index The index of the component (less than getComponentCount(player))
+             * @returns Whether the component is closed
+             */
+            bool isClosed(const unsigned char &player, const std::size_t &index) const {
+                return this->contestants(player, index) == (1 << player);
+            }
+            /** Get the closed pockets of a player
+             * @param player The player
+             * @returns Every component of the player's reach that no other player can reach
+             */
+            std::vector<blokus::bitboard> pockets(const unsigned char &player) const {
+                std::vector<blokus::bitboard> output;
+                for (std::size_t i = 0; i < this->componentCounts[player]; i++) {
+                    if (this->isClosed(player, i)) {
+                        output.push_back(this->components[player][i]);
+                    }
+                }
+                return output;
+            }
+            /** Get a key for a region that is independent of where the rest of the game stands; useful for caching per-pocket evaluations
+             * @param region The cells of the region
+             * @param player The player the region is being evaluated for
+             * @returns A key built from the player's Zobrist cell keys over the region
+             */
+            static std::uint64_t regionKey(const blokus::bitboard &region, const unsigned char &player) {
+                std::uint64_t output = 0;
+                region.forEach([&](const int &x, const int &y) {
+                    output ^= blokus::zobrist::cell(player, x, y);
+                });
+                return output;
+            }
+
+            /** Check whether two players' reaches share any cell (compared component by component, so no reach has to be built)
+             * @param a The first player
+             * @param b The second player
+             * @returns Whether any component of one player intersects any component of the other
+             */
+            bool overlaps(const unsigned char &a, const unsigned char &b) const {
+                for (std::size_t i = 0; i < this->componentCounts[a]; i++) {
+                    for (std::size_t j = 0; j < this->componentCounts[b]; j++) {
+                        if (this->components[a][i].intersects(this->components[b][j])) {
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+            /** Split a set of players into groups whose reaches cannot overlap; groups can be searched independently of each other
+             * @param mask A bitmask of the players to split
+             * @param groups The bitmask of each group found (at most blokus::maxPlayers)
+             * @returns The amount of groups found
+             */
+            unsigned char interactionGroups(const unsigned char &mask, unsigned char groups[blokus::maxPlayers]) const {
+                unsigned char parent[blokus::maxPlayers] = {0, 1, 2, 3};
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    for (unsigned char j = i + 1; j < this->playerCount; j++) {
+                        if (((mask >> i) & 1) && ((mask >> j) & 1) && this->overlaps(i, j)) {
+                            unsigned char a = i, b = j;
+                            while (parent[a] != a) {a = parent[a];}
+                            while (parent[b] != b) {b = parent[b];}
+                            parent[b] = a;
+                        }
+                    }
+                }
+
+                // Give every root its own group, then add each player to the group of its root
+                unsigned char count = 0;
+                unsigned char groupOf[blokus::maxPlayers] = {0, 0, 0, 0};
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    if (((mask >> i) & 1) == 0) {
+                        continue;
+                    }
+                    unsigned char root = i;
+                    while (parent[root] != root) {root = parent[root];}
+                    if (root == i) {
+                        groupOf[i] = count;
+                        groups[count++] = 0;
+                    }
+                }
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    if (((mask >> i) & 1) == 0) {
+                        continue;
+                    }
+                    unsigned char root = i;
+                    while (parent[root] != root) {root = parent[root];}
+                    groups[groupOf[root]] |= 1 << i;
+                }
+                return count;
+            }
+    };
+}
+
+#endif // BLOKUS_REGIONS_hpp
@@ -0,0 +1,557 @@
+#ifndef BLOKUS_SAMPLES_hpp
+#define BLOKUS_SAMPLES_hpp
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "blokus_file.hpp"
+#include "blokus_state.hpp"
+
+namespace blokus {
+    /// @brief The version of the training sample shard format
+    const std::uint32_t sampleVersion = 1;
+
+    /// @brief The header at the start of a training sample shard
+    struct sampleHeader {
+        /// @brief Always "BLKSMPL" followed by a null character
+        char magic[8] = {'B', 'L', 'K', 'S', 'M', 'P', 'L', '\0'};
+        /// @brief The version of the file format (blokus::sampleVersion)
+        std::uint32_t version = blokus::sampleVersion;
+        /// @brief The size of one uncompressed record in bytes
+        std::uint32_t recordSize = 0;
+        /// @brief The side length of the board the samples come from
+        std::uint16_t size = 20;
+        /// @brief The amount of players in the games the samples come from
+        std::uint16_t playerCount = 4;
+        /// @brief The amount of polyominoes (from global id 0) whose remaining counts are stored for each player
+        std::uint16_t pieceFeatures = 21;
+        std::uint16_t reserved = 0;
+        /// @brief The most records a chunk holds (only the last chunk may hold fewer)
+        std::uint32_t recordsPerChunk = 1024;
+        /// @brief The amount of chunks in the shard
+        std::uint32_t chunkCount = 0;
+        /// @brief The amount of records in the shard
+        std::uint64_t recordCount = 0;
+        /// @brief Where the chunk index starts within the file
+        std::uint64_t indexOffset = 0;
+    };
+
+    /// @brief The position and size of one compressed chunk within a shard
+    struct sampleChunk {
+        /// @brief Where the chunk starts within the file
+        std::uint64_t offset = 0;
+        /// @brief The size of the compressed chunk in bytes
+        std::uint32_t compressedSize = 0;
+        /// @brief The amount of records in the chunk
+        std::uint32_t records = 0;
+    };
+
+    static_assert(sizeof(blokus::sampleHeader) == 48, "blokus::sampleHeader must match the file layout");
+    static_assert(sizeof(blokus::sampleChunk) == 16, "blokus::sampleChunk must match the file layout");
+
+    /** Fixed-width layout of one (position, policy, outcome) training record
+     *
+     * Everything is stored relative to the player to move (relative player r is player (turn + r) % playerCount), the same way blokus::network reads its inputs:
+     * an occupancy plane then an anchor plane for every relative player (bit-packed, row-major), every relative player's remaining piece counts (one byte each), the move played, the final outcome for the mover (-1, 0, or 1) and their final margin
+     */
+    class sampleLayout {
+        private:
+            /// @brief The side length of the board
+            unsigned short size = 20;
+            /// @brief The amount of players
+            unsigned short playerCount = 4;
+            /// @brief The amount of polyominoes whose remaining counts are stored
+            unsigned short pieceFeatures = 21;
+
+        public:
+            /** blokus::sampleLayout constructor
+             * @param size The side length of the board
+             * @param playerCount The amount of players
+             * @param pieceFeatures The amount of polyominoes (from global id 0) whose remaining counts are stored
+             */
+            sampleLayout(const unsigned short &size = 20, const unsigned short &playerCount = 4, const unsigned short &pieceFeatures = 21) : size(size), playerCount(playerCount), pieceFeatures(pieceFeatures) {}
+
+            /** Get the side length of the board
+             * @returns The side length of the board
+             */
+            unsigned short getSize() const {
+                return this->size;
+            }
+            /** Get the amount of players
+             * @returns The amount of players
+             */
+            unsigned short getPlayerCount() const {
+                return this->playerCount;
+            }
+            /** Get the amount of polyominoes whose remaining counts are stored
+             * @returns The amount of polyominoes whose remaining counts are stored
+             */
+            unsigned short getPieceFeatures() const {
+                return this->pieceFeatures;
+            }
+
+            /** Get the amount of bytes a bit-packed plane takes up
+             * @returns The amount of bytes a plane takes up
+             */
+            std::size_t planeBytes() const {
+                return ((std::size_t)this->size * this->size + 7) / 8;
+            }
+            /** Get the offset of the piece counts within a record
+             * @returns The offset of the piece counts
+             */
+            std::size_t piecesOffset() const {
+                return 2 * this->playerCount * this->planeBytes();
+            }
+            /** Get the offset of the move and outcome within a record
+             * @returns The offset of the move and outcome
+             */
+            std::size_t resultOffset() const {
+                return this->piecesOffset() + (std::size_t)this->playerCount * this->pieceFeatures;
+            }
+            /** Get the size of a record
+             * @returns The size of a record in bytes
+             */
+            std::size_t recordSize() const {
+                // polyomino (2), orientation, x, y, outcome, margin (2)
+                return this->resultOffset() + 8;
+            }
+
+            /** Encode a position into a record
+             * @param s The position (the move has not been played yet)
+             * @param m The move played from the position
+             * @param outcome The final outcome for the player to move (-1 loss, 0 tie, 1 win)
+             * @param margin The final margin of the player to move (own tiles minus the best opponent's)
+             * @param output Where to write the record (recordSize() bytes)
+             */
+            void encode(const blokus::state &s, const blokus::move &m, const signed char &outcome, const short &margin, std::uint8_t *output) const {
+                std::memset(output, 0, this->recordSize());
+                for (unsigned char r = 0; r < this->playerCount; r++) {
+                    const unsigned char player = (s.getTurn() + r) % this->playerCount;
+                    std::uint8_t *occupancy = output + r * this->planeBytes();
+                    std::uint8_t *anchors = output + (this->playerCount + r) * this->planeBytes();
+                    s.getOccupied(player).forEach([&](const int &x, const int &y) {
+                        occupancy[(y * this->size + x) / 8] |= 1 << ((y * this->size + x) % 8);
+                    });
+                    s.anchors(player).forEach([&](const int &x, const int &y) {
+                        anchors[(y * this->size + x) / 8] |= 1 << ((y * this->size + x) % 8);
+                    });
+                    for (unsigned short i = 0; i < this->pieceFeatures; i++) {
+                        output[this->piecesOffset() + r * this->pieceFeatures + i] = s.getRemaining(player, i);
+                    }
+                }
+                std::uint8_t *result = output + this->resultOffset();
+                std::memcpy(result, &m.polyomino, 2);
+                result[2] = m.orientation;
+                result[3] = m.x;
+                result[4] = m.y;
+                result[5] = (std::uint8_t)outcome;
+                std::memcpy(result + 6, &margin, 2);
+            }
+
+            /** Check a cell of one of a record's planes
+             * @param record The record
+             * @param plane The plane (relative player r's occupancy is r, their anchors are playerCount + r)
+             * @param x x-position of the cell
+             * @param y y-position of the cell
+             * @returns Whether the cell is set
+             */
+            bool cell(const std::uint8_t *record, const unsigned char &plane, const int &x, const int &y) const {
+                const std::size_t bit = (std::size_t)y * this->size + x;
+                return (record[plane * this->planeBytes() + bit / 8] >> (bit % 8)) & 1;
+            }
+            /** Get a relative player's remaining copies of a polyomino from a record
+             * @param record The record
+             * @param relativePlayer The relative player
+             * @param polyomino The global id of the polyomino (less than pieceFeatures)
+             * @returns The amount of copies left
+             */
+            unsigned char remaining(const std::uint8_t *record, const unsigned char &relativePlayer, const unsigned short &polyomino) const {
+                return record[this->piecesOffset() + relativePlayer * this->pieceFeatures + polyomino];
+            }
+            /** Get the move stored within a record
+             * @param record The record
+             * @returns The move played from the position
+             */
+            blokus::move played(const std::uint8_t *record) const {
+                const std::uint8_t *result = record + this->resultOffset();
+                blokus::move output;
+                std::memcpy(&output.polyomino, result, 2);
+                output.orientation = result[2];
+                output.x = result[3];
+                output.y = result[4];
+                return output;
+            }
+            /** Get the outcome stored within a record
+             * @param record The record
+             * @returns The final outcome for the player to move (-1 loss, 0 tie, 1 win)
+             */
+            signed char outcome(const std::uint8_t *record) const {
+                return (signed char)record[this->resultOffset() + 5];
+            }
+            /** Get the margin stored within a record
+             * @param record The record
+             * @returns The final margin of the player to move
+             */
+            short margin(const std::uint8_t *record) const {
+                short output;
+                std::memcpy(&output, record + this->resultOffset() + 6, 2);
+                return output;
+            }
+    };
+
+    /** Compress a chunk of records by collapsing runs of zero bytes (bit-packed planes are mostly empty)
+     *
+     * A zero byte is followed by the length of its run (1-255); every other byte is stored as is
+     * @param input The bytes to compress
+     * @param length The amount of bytes to compress
+     * @param output The list to append the compressed bytes to
+     */
+    void packZeros(const std::uint8_t *input, const std::size_t &length, std::vector<std::uint8_t> &output) {
+        for (std::size_t i = 0; i < length;) {
+            if (input[i] != 0) {
+                output.push_back(input[i++]);
+                continue;
+            }
+            std::size_t run = 1;
+            while (i + run < length && run < 255 && input[i + run] == 0) {
+                run++;
+            }
+            output.push_back(0);
+            output.push_back(run);
+            i += run;
+        }
+    }
+    /** Decompress bytes written by blokus::packZeros()
+     * @param input The compressed bytes
+     * @param length The amount of compressed bytes
+     * @param output The list to write the decompressed bytes to (overwritten)
+     * @returns Whether the input was well-formed
+     */
+    bool unpackZeros(const std::uint8_t *input, const std::size_t &length, std::vector<std::uint8_t> &output) {
+        output.clear();
+        for (std::size_t i = 0; i < length; i++) {
+            if (input[i] != 0) {
+                output.push_back(input[i]);
+                continue;
+            }
+            if (++i >= length) {
+                return false;
+            }
+            output.insert(output.end(), input[i], 0);
+        }
+        return true;
+    }
+
+    /** Streams training records into chunked, compressed shard files
+     *
+     * Records are gathered into chunks on the calling thread; full chunks are handed to a background thread that compresses them and writes them out, so the caller never waits on the disk (unless it gets far enough ahead to fill the queue).
+     * A shard is closed and a new one started every chunksPerShard chunks; shards are named <prefix>-<index>.bin
+     */
+    class sampleWriter {
+        private:
+            /// @brief The most chunks that may wait to be written before add() blocks
+            static const std::size_t maxQueued = 64;
+
+            /// @brief The layout of the records being written
+            blokus::sampleLayout layout;
+            /// @brief The path prefix of the shards
+            std::string prefix;
+            /// @brief The most records a chunk holds
+            std::uint32_t recordsPerChunk = 1024;
+            /// @brief The most chunks a shard holds
+            std::uint32_t chunksPerShard = 256;
+            /// @brief The header written at the start of every shard
+            blokus::sampleHeader header;
+
+            /// @brief The chunk being filled by the caller
+            std::vector<std::uint8_t> current = {};
+            /// @brief The chunks waiting for the background thread
+            std::deque<std::vector<std::uint8_t>> queue = {};
+            std::mutex lock;
+            /// @brief Signalled when a chunk is queued or the writer is closing
+            std::condition_variable queued;
+            /// @brief Signalled when a chunk leaves the queue
+            std::condition_variable drained;
+            /// @brief Whether the writer is closing
+            bool closing = false;
+            /// @brief The background thread
+            std::thread worker;
+
+            /// @brief The amount of shards started (used by the background thread)
+            std::size_t shards = 0;
+            /// @brief The shard being written (used by the background thread)
+            std::ofstream shard;
+            /// @brief The chunks within the current shard (used by the background thread)
+            std::vector<blokus::sampleChunk> index = {};
+            /// @brief The amount of records within the current shard (used by the background thread)
+            std::uint64_t shardRecords = 0;
+
+            /// @brief Write the chunk index and final header of the current shard and close it
+            void finishShard() {
+                blokus::sampleHeader finished = this->header;
+                finished.chunkCount = this->index.size();
+                finished.recordCount = this->shardRecords;
+                finished.indexOffset = this->shard.tellp();
+                this->shard.write((const char *)this->index.data(), this->index.size() * sizeof(blokus::sampleChunk));
+                this->shard.seekp(0);
+                this->shard.write((const char *)&finished, sizeof(blokus::sampleHeader));
+                this->shard.close();
+                this->index.clear();
+                this->shardRecords = 0;
+            }
+            /** Compress a chunk and append it to the current shard (starting a new shard if needed)
+             * @param chunk The uncompressed records
+             */
+            void writeChunk(const std::vector<std::uint8_t> &chunk) {
+                if (!this->shard.is_open()) {
+                    const std::string path = this->prefix + "-" + std::to_string(this->shards++) + ".bin";
+                    this->shard.open(path, std::ios::binary | std::ios::trunc);
+                    if (!this->shard.is_open()) {
+                        std::cout << "ERROR: Could not write sample shard \"" << path << "\"\n";
+                        return;
+                    }
+                    this->shard.write((const char *)&this->header, sizeof(blokus::sampleHeader));
+                }
+
+                std::vector<std::uint8_t> compressed;
+                blokus::packZeros(chunk.data(), chunk.size(), compressed);
+                blokus::sampleChunk entry;
+                entry.offset = this->shard.tellp();
+                entry.compressedSize = compressed.size();
+                entry.records = chunk.size() / this->layout.recordSize();
+                this->shard.write((const char *)compressed.data(), compressed.size());
+                this->index.push_back(entry);
+                this->shardRecords += entry.records;
+
+                if (this->index.size() >= this->chunksPerShard) {
+                    this->finishShard();
+                }
+            }
+            /// @brief The loop run by the background thread
+            void run() {
+                std::unique_lock<std::mutex> guard(this->lock);
+                while (true) {
+                    this->queued.wait(guard, [this]() {
+                        return this->closing || this->queue.size() > 0;
+                    });
+                    if (this->queue.size() == 0) {
+                        break;
+                    }
+                    const std::vector<std::uint8_t> chunk = std::move(this->queue.front());
+                    this->queue.pop_front();
+                    this->drained.notify_all();
+
+                    guard.unlock();
+                    this->writeChunk(chunk);
+                    guard.lock();
+                }
+                if (this->shard.is_open()) {
+                    this->finishShard();
+                }
+            }
+            /// @brief Hand the current chunk to the background thread
+            void submit() {
+                if (this->current.size() == 0) {
+                    return;
+                }
+                std::unique_lock<std::mutex> guard(this->lock);
+                this->drained.wait(guard, [this]() {
+                    return this->queue.size() < blokus::sampleWriter::maxQueued;
+                });
+                this->queue.push_back(std::move(this->current));
+                this->current.clear();
+                this->queued.notify_one();
+            }
+
+        public:
+            /** blokus::sampleWriter constructor
+             * @param prefix The path prefix of the shards (e.g. "dev/samples/classic")
+             * @param layout The layout of the records
+             * @param recordsPerChunk The most records a chunk holds
+             * @param chunksPerShard The most chunks a shard holds
+             */
+            sampleWriter(const std::string &prefix, const blokus::sampleLayout &layout, const std::uint32_t &recordsPerChunk = 1024, const std::uint32_t &chunksPerShard = 256) : layout(layout), prefix(prefix), recordsPerChunk(recordsPerChunk < 1 ? 1 : recordsPerChunk), chunksPerShard(chunksPerShard < 1 ? 1 : chunksPerShard) {
+                this->header.recordSize = layout.recordSize();
+                this->header.size = layout.getSize();
+                this->header.playerCount = layout.getPlayerCount();
+                this->header.pieceFeatures = layout.getPieceFeatures();
+                this->header.recordsPerChunk = this->recordsPerChunk;
+                this->worker = std::thread(&blokus::sampleWriter::run, this);
+            }
+            ~sampleWriter() {
+                this->close();
+            }
+            sampleWriter(const blokus::sampleWriter &) = delete;
+            blokus::sampleWriter &operator=(const blokus::sampleWriter &) = delete;
+
+            /** Add a record
+             * @param s The position (the move has not been played yet)
+             * @param m The move played from the position
+             * @param outcome The final outcome for the player to move (-1 loss, 0 tie, 1 win)
+             * @param margin The final margin of the player to move
+             */
+            void add(const blokus::state &s, const blokus::move &m, const signed char &outcome, const short &margin) {
+                if (this->current.capacity() == 0) {
+                    this->current.reserve((std::size_t)this->recordsPerChunk * this->layout.recordSize());
+                }
+                this->current.resize(this->current.size() + this->layout.recordSize());
+                this->layout.encode(s, m, outcome, margin, this->current.data() + this->current.size() - this->layout.recordSize());
+                if (this->current.size() >= (std::size_t)this->recordsPerChunk * this->layout.recordSize()) {
+                    this->submit();
+                }
+            }
+            /// @brief Write out everything added so far and close the last shard
+            void close() {
+                if (!this->worker.joinable()) {
+                    return;
+                }
+                this->submit();
+                {
+                    std::lock_guard<std::mutex> guard(this->lock);
+                    this->closing = true;
+                }
+                this->queued.notify_one();
+                this->worker.join();
+            }
+    };
+
+    /** Random-access reader for a training sample shard
+     *
+     * The shard is opened through blokus::mappedFile; a chunk is only decompressed when one of its records is asked for, and the last chunk decompressed is kept around for sequential reads
+     */
+    class sampleReader {
+        private:
+            /// @brief The open shard
+            blokus::mappedFile file;
+            /// @brief The header of the open shard
+            blokus::sampleHeader header;
+            /// @brief The layout of the records within the shard
+            blokus::sampleLayout layout;
+            /// @brief The chunk index of the open shard
+            std::vector<blokus::sampleChunk> index = {};
+            /// @brief The index of the first record of each chunk
+            std::vector<std::uint64_t> firstRecords = {};
+            /// @brief The last chunk decompressed
+            std::vector<std::uint8_t> cached = {};
+            /// @brief The index of the last chunk decompressed
+            std::size_t cachedChunk = SIZE_MAX;
+
+        public:
+            sampleReader() {}
+            /** blokus::sampleReader constructor
+             * @param path The path of the shard to open
+             */
+            sampleReader(const std::string &path) {
+                this->open(path);
+            }
+
+            /** Open a shard (closing the current one)
+             * @param path The path of the shard to open
+             * @returns Whether the shard was opened
+             */
+            bool open(const std::string &path) {
+                this->index.clear();
+                this->firstRecords.clear();
+                this->cachedChunk = SIZE_MAX;
+                this->header = blokus::sampleHeader();
+                if (!this->file.open(path)) {
+                    return false;
+                }
+
+                if (this->file.size() < sizeof(blokus::sampleHeader)) {
+                    std::cout << "ERROR: \"" << path << "\" is not a sample shard\n";
+                    this->file.close();
+                    return false;
+                }
+                std::memcpy(&this->header, this->file.data(), sizeof(blokus::sampleHeader));
+                if (std::memcmp(this->header.magic, blokus::sampleHeader().magic, 8) != 0 || this->header.version != blokus::sampleVersion) {
+                    std::cout << "ERROR: \"" << path << "\" is not a version " << blokus::sampleVersion << " sample shard\n";
+                    this->file.close();
+                    return false;
+                }
+                if (this->header.indexOffset > this->file.size() || (std::uint64_t)this->header.chunkCount * sizeof(blokus::sampleChunk) > this->file.size() - this->header.indexOffset) {
+                    std::cout << "ERROR: Sample shard \"" << path << "\" is truncated (was it closed?)\n";
+                    this->file.close();
+                    return false;
+                }
+                // The layout's accessors trust its dimensions and get() strides by recordSize, so both have to describe the same records
+                this->layout = blokus::sampleLayout(this->header.size, this->header.playerCount, this->header.pieceFeatures);
+                if (this->header.size < 20 || this->header.size > blokus::maxBoardSize || this->header.playerCount < 2 || this->header.playerCount > blokus::maxPlayers || this->header.pieceFeatures > blokus::polyominoIdCount || this->header.recordSize != this->layout.recordSize()) {
+                    std::cout << "ERROR: Sample shard \"" << path << "\" has an invalid record layout\n";
+                    this->layout = blokus::sampleLayout();
+                    this->header = blokus::sampleHeader();
+                    this->file.close();
+                    return false;
+                }
+                this->index.resize(this->header.chunkCount);
+                std::memcpy(this->index.data(), this->file.data() + this->header.indexOffset, this->index.size() * sizeof(blokus::sampleChunk));
+                // get() finds a record's chunk by dividing by recordsPerChunk, so every chunk but the last has to be full and the index has to agree with the header
+                bool valid = this->header.recordsPerChunk != 0;
+                std::uint64_t total = 0;
+                for (std::size_t i = 0; valid && i < this->index.size(); i++) {
+                    const blokus::sampleChunk &entry = this->index[i];
+                    valid = entry.records <= this->header.recordsPerChunk && (i + 1 == this->index.size() || entry.records == this->header.recordsPerChunk) && entry.offset <= this->file.size() && entry.compressedSize <= this->file.size() - entry.offset;
+                    this->firstRecords.push_back(total);
+                    total += entry.records;
+                }
+                if (!valid || total != this->header.recordCount) {
+                    std::cout << "ERROR: Sample shard \"" << path << "\" is corrupt\n";
+                    this->index.clear();
+                    this->firstRecords.clear();
+                    this->header = blokus::sampleHeader();
+                    this->file.close();
+                    return false;
+                }
+                return true;
+            }
+
+            /** Get the header of the open shard
+             * @returns The header of the open shard
+             */
+            const blokus::sampleHeader &getHeader() const {
+                return this->header;
+            }
+            /** Get the layout of the records within the open shard
+             * @returns The layout of the records
+             */
+            const blokus::sampleLayout &getLayout() const {
+                return this->layout;
+            }
+            /** Get the amount of records within the open shard
+             * @returns The amount of records
+             */
+            std::uint64_t size() const {
+                return this->header.recordCount;
+            }
+
+            /** Get a record
+             * @param record The index of the record
+             * @returns A pointer to the record (valid until the next call), or nullptr if the index is out of range or the chunk is corrupt
+             */
+            const std::uint8_t *get(const std::uint64_t &record) {
+                if (record >= this->header.recordCount) {
+                    return nullptr;
+                }
+                const std::size_t chunk = record / this->header.recordsPerChunk;
+                if (chunk != this->cachedChunk) {
+                    const blokus::sampleChunk &entry = this->index.at(chunk);
+                    if (entry.offset + entry.compressedSize > this->file.size() || !blokus::unpackZeros((const std::uint8_t *)this->file.data() + entry.offset, entry.compressedSize, this->cached) || this->cached.size() != (std::size_t)entry.records * this->header.recordSize) {
+                        this->cachedChunk = SIZE_MAX;
+                        return nullptr;
+                    }
+                    this->cachedChunk = chunk;
+                }
+                return this->cached.data() + (record - this->firstRecords[chunk]) * this->header.recordSize;
+            }
+    };
+}
+
+#endif // BLOKUS_SAMPLES_hpp
@@ -0,0 +1,265 @@
+#ifndef BLOKUS_SNAPSHOT_hpp
+#define BLOKUS_SNAPSHOT_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "blokus_polyominoes.hpp"
+#include "blokus_piece.hpp"
+#include "blokus_file.hpp"
+
+namespace blokus {
+    /// @brief The version of the snapshot file format
+    const std::uint32_t snapshotVersion = 1;
+
+    /// @brief The header at the start of a snapshot file; followed by one owner byte per cell (row-major, 0 = empty, otherwise player + 1) and then each player's section
+    struct snapshotHeader {
+        /// @brief Always "BLKSAVE" followed by a null character
+        char magic[8] = {'B', 'L', 'K', 'S', 'A', 'V', 'E', '\0'};
+        /// @brief The version of the file format (blokus::snapshotVersion)
+        std::uint32_t version = blokus::snapshotVersion;
+        /// @brief The side length of the board
+        std::uint8_t size = 20;
+        /// @brief The amount of players
+        std::uint8_t playerCount = 4;
+        /// @brief The player whose turn it is
+        std::uint8_t turn = 0;
+        std::uint8_t reserved = 0;
+        /// @brief The amount of sets of each polyomino type in play
+        std::uint8_t pieceSets[6] = {1, 0, 0, 0, 0, 0};
+        std::uint8_t reserved2[2] = {0, 0};
+    };
+
+    /// @brief The start of a player's section; followed by nameLength UTF-16 code units and then every remaining piece (base pieces first, then hexominoes, etc.)
+    struct snapshotPlayerHeader {
+        /// @brief The player's color as red, green, blue, and alpha
+        std::uint8_t color[4] = {255, 0, 0, 255};
+        /// @brief The amount of UTF-16 code units in the player's name
+        std::uint16_t nameLength = 0;
+        /// @brief The amount of remaining pieces of each polyomino type (base, hex, hept, oct)
+        std::uint16_t pieceCounts[4] = {0, 0, 0, 0};
+        std::uint16_t reserved = 0;
+    };
+
+    /// @brief A remaining piece including its current position and orientation
+    struct snapshotPiece {
+        /// @brief The global id of the polyomino
+        std::uint16_t id = 0;
+        /// @brief The piece's x-position
+        std::int16_t x = 0;
+        /// @brief The piece's y-position
+        std::int16_t y = 0;
+        /// @brief The amount of rows in the piece's grid
+        std::uint8_t rows = 0;
+        /// @brief The amount of columns in the piece's grid
+        std::uint8_t cols = 0;
+        /// @brief The piece's grid as a row-major bitmask (no polyomino in play is larger than 8x8)
+        std::uint64_t cells = 0;
+    };
+
+    static_assert(sizeof(blokus::snapshotHeader) == 24, "blokus::snapshotHeader must match the file layout");
+    static_assert(sizeof(blokus::snapshotPlayerHeader) == 16, "blokus::snapshotPlayerHeader must match the file layout");
+    static_assert(sizeof(blokus::snapshotPiece) == 16, "blokus::snapshotPiece must match the file layout");
+
+    /// @brief Everything about a player that a snapshot keeps
+    struct snapshotPlayer {
+        /// @brief The player's name
+        std::u16string name = u"";
+        /// @brief The player's color as red, green, blue, and alpha
+        std::uint8_t color[4] = {255, 0, 0, 255};
+        /// @brief The player's remaining pieces for each polyomino type (base, hex, hept, oct)
+        std::vector<blokus::piece> pieces[4] = {};
+    };
+
+    /** The full state of an in-progress game
+     *
+     * Only the state itself is stored (who owns each cell, the players, and whose turn it is); anything that can be derived from it, such as autotile masks and the board's texture, is left for the game to rebuild.
+     * Loading is a single read of the file (memory-mapped) followed by copying each section out of it, so resuming a game costs the same no matter how many moves have been played
+     */
+    struct snapshot {
+        /// @brief The side length of the board
+        unsigned char size = 20;
+        /// @brief The player whose turn it is
+        unsigned char turn = 0;
+        /// @brief The amount of sets of each polyomino type in play
+        unsigned char pieceSets[6] = {1, 0, 0, 0, 0, 0};
+        /// @brief The owner of each cell (row-major); 0 for an empty cell, otherwise player + 1
+        std::vector<unsigned char> owners = {};
+        /// @brief The players in turn order
+        std::vector<blokus::snapshotPlayer> players = {};
+
+        /** Save the snapshot to a file
+         * @param path The path of the file
+         * @returns Whether the file was written
+         */
+        bool save(const std::string &path) const {
+            if (this->owners.size() != (std::size_t)this->size * this->size || this->players.size() < 2 || this->players.size() > 4 || this->turn >= this->players.size()) {
+                std::cout << "ERROR: Could not save an inconsistent snapshot\n";
+                return false;
+            }
+
+            blokus::snapshotHeader header;
+            header.size = this->size;
+            header.playerCount = this->players.size();
+            header.turn = this->turn;
+            std::memcpy(header.pieceSets, this->pieceSets, 6);
+
+            std::vector<char> bytes(sizeof(blokus::snapshotHeader) + this->owners.size());
+            std::memcpy(bytes.data(), &header, sizeof(blokus::snapshotHeader));
+            std::memcpy(bytes.data() + sizeof(blokus::snapshotHeader), this->owners.data(), this->owners.size());
+
+            for (std::size_t p = 0; p < this->players.size(); p++) {
+                const blokus::snapshotPlayer &player = this->players[p];
+                blokus::snapshotPlayerHeader playerHeader;
+                std::memcpy(playerHeader.color, player.color, 4);
+                playerHeader.nameLength = player.name.size();
+                for (unsigned char t = 0; t < 4; t++) {
+                    playerHeader.pieceCounts[t] = player.pieces[t].size();
+                }
+
+                std::size_t offset = bytes.size();
+                bytes.resize(offset + sizeof(blokus::snapshotPlayerHeader) + player.name.size() * sizeof(char16_t));
+                std::memcpy(bytes.data() + offset, &playerHeader, sizeof(blokus::snapshotPlayerHeader));
+                std::memcpy(bytes.data() + offset + sizeof(blokus::snapshotPlayerHeader), player.name.data(), player.name.size() * sizeof(char16_t));
+
+                for (unsigned char t = 0; t < 4; t++) {
+                    for (std::size_t i = 0; i < player.pieces[t].size(); i++) {
+                        const blokus::piece &source = player.pieces[t][i];
+                        const std::vector<std::vector<bool>> &grid = source.getGrid();
+
+                        blokus::snapshotPiece packed;
+                        packed.id = source.getId();
+                        packed.x = source.getX();
+                        packed.y = source.getY();
+                        packed.rows = grid.size();
+                        packed.cols = grid.size() > 0 ? grid[0].size() : 0;
+                        if ((unsigned int)packed.rows * packed.cols > 64) {
+                            std::cout << "ERROR: Could not save piece " << packed.id << " as its grid is larger than 64 cells\n";
+                            return false;
+                        }
+                        for (unsigned char r = 0; r < packed.rows; r++) {
+                            for (unsigned char c = 0; c < packed.cols; c++) {
+                                packed.cells |= (std::uint64_t)grid[r][c] << (r * packed.cols + c);
+                            }
+                        }
+
+                        offset = bytes.size();
+                        bytes.resize(offset + sizeof(blokus::snapshotPiece));
+                        std::memcpy(bytes.data() + offset, &packed, sizeof(blokus::snapshotPiece));
+                    }
+                }
+            }
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cout << "ERROR: Could not write snapshot \"" << path << "\"\n";
+                return false;
+            }
+            file.write(bytes.data(), bytes.size());
+            return file.good();
+        }
+
+        /** Load a snapshot from a file (the snapshot is left untouched if the file is not a valid snapshot)
+         * @param path The path of the file
+         * @returns Whether the snapshot was loaded
+         */
+        bool load(const std::string &path) {
+            blokus::mappedFile file(path);
+            if (!file.isOpen()) {
+                return false;
+            }
+            const char *input = file.data();
+            const char *end = input + file.size();
+
+            blokus::snapshotHeader header;
+            if (file.size() < sizeof(blokus::snapshotHeader)) {
+                std::cout << "ERROR: \"" << path << "\" is not a snapshot\n";
+                return false;
+            }
+            std::memcpy(&header, input, sizeof(blokus::snapshotHeader));
+            input += sizeof(blokus::snapshotHeader);
+            if (std::memcmp(header.magic, blokus::snapshotHeader().magic, 8) != 0 || header.version != blokus::snapshotVersion) {
+                std::cout << "ERROR: \"" << path << "\" is not a version " << blokus::snapshotVersion << " snapshot\n";
+                return false;
+            }
+            if (header.size < 20 || header.size > 100 || header.playerCount < 2 || header.playerCount > 4 || header.turn >= header.playerCount || (std::size_t)(end - input) < (std::size_t)header.size * header.size) {
+                std::cout << "ERROR: Snapshot \"" << path << "\" is corrupt\n";
+                return false;
+            }
+
+            blokus::snapshot output;
+            output.size = header.size;
+            output.turn = header.turn;
+            // Sets outside of what a game allows would make the game build tens of thousands of pieces
+            for (blokus::polyType t = blokus::POLYTYPE_BASE; t <= blokus::POLYTYPE_DEC; t++) {
+                output.pieceSets[t] = blokus::processPolyominoSet(t, header.pieceSets[t]);
+            }
+            output.owners.assign(input, input + (std::size_t)header.size * header.size);
+            input += output.owners.size();
+
+            output.players.resize(header.playerCount);
+            for (unsigned char p = 0; p < header.playerCount; p++) {
+                blokus::snapshotPlayer &player = output.players[p];
+                blokus::snapshotPlayerHeader playerHeader;
+                if ((std::size_t)(end - input) < sizeof(blokus::snapshotPlayerHeader)) {
+                    std::cout << "ERROR: Snapshot \"" << path << "\" is truncated\n";
+                    return false;
+                }
+                std::memcpy(&playerHeader, input, sizeof(blokus::snapshotPlayerHeader));
+                input += sizeof(blokus::snapshotPlayerHeader);
+
+                std::memcpy(player.color, playerHeader.color, 4);
+                if ((std::size_t)(end - input) < playerHeader.nameLength * sizeof(char16_t)) {
+                    std::cout << "ERROR: Snapshot \"" << path << "\" is truncated\n";
+                    return false;
+                }
+                player.name.resize(playerHeader.nameLength);
+                std::memcpy(&player.name[0], input, playerHeader.nameLength * sizeof(char16_t));
+                input += playerHeader.nameLength * sizeof(char16_t);
+
+                std::uint16_t idStart = 0;
+                for (unsigned char t = 0; t < 4; t++) {
+                    if ((std::size_t)(end - input) < playerHeader.pieceCounts[t] * sizeof(blokus::snapshotPiece)) {
+                        std::cout << "ERROR: Snapshot \"" << path << "\" is truncated\n";
+                        return false;
+                    }
+                    if (playerHeader.pieceCounts[t] > (std::size_t)output.pieceSets[t] * blokus::polyominoAmounts[t]) {
+                        std::cout << "ERROR: Snapshot \"" << path << "\" is corrupt\n";
+                        return false;
+                    }
+                    player.pieces[t].reserve(playerHeader.pieceCounts[t]);
+                    for (std::uint16_t i = 0; i < playerHeader.pieceCounts[t]; i++) {
+                        blokus::snapshotPiece packed;
+                        std::memcpy(&packed, input, sizeof(blokus::snapshotPiece));
+                        input += sizeof(blokus::snapshotPiece);
+                        // An id outside of its type's range would silently become a monomino
+                        if ((unsigned int)packed.rows * packed.cols > 64 || packed.id < idStart || packed.id >= idStart + blokus::polyominoAmounts[t]) {
+                            std::cout << "ERROR: Snapshot \"" << path << "\" is corrupt\n";
+                            return false;
+                        }
+
+                        std::vector<std::vector<bool>> grid(packed.rows, std::vector<bool>(packed.cols, false));
+                        for (unsigned char r = 0; r < packed.rows; r++) {
+                            for (unsigned char c = 0; c < packed.cols; c++) {
+                                grid[r][c] = (packed.cells >> (r * packed.cols + c)) & 1;
+                            }
+                        }
+                        player.pieces[t].emplace_back(packed.id);
+                        player.pieces[t].back().setPosition(packed.x, packed.y);
+                        player.pieces[t].back().setGrid(grid);
+                    }
+                    idStart += blokus::polyominoAmounts[t];
+                }
+            }
+
+            *this = std::move(output);
+            return true;
+        }
+    };
+}
+
+#endif // BLOKUS_SNAPSHOT_hpp
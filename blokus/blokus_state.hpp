@@ -0,0 +1,599 @@
+#ifndef BLOKUS_STATE_hpp
+#define BLOKUS_STATE_hpp
+
+#include <vector>
+#include <cstdint>
+#include <climits>
+
+#include "blokus_polyominoes.hpp"
+#include "blokus_orientations.hpp"
+#include "blokus_bitboard.hpp"
+
+namespace blokus {
+    /// @brief The largest side length a board can have
+    const unsigned char maxBoardSize = 100;
+    /// @brief The largest amount of players a game can have
+    const unsigned char maxPlayers = 4;
+    /// @brief The largest amount of copies of a single polyomino a player can hold (the most sets of any type allowed)
+    const unsigned char maxPolyominoCopies = 12;
+
+    /// @brief A single placement of a polyomino on the board (or a pass)
+    struct move {
+        /// @brief The global id of the polyomino being placed (USHRT_MAX for a pass)
+        unsigned short polyomino = USHRT_MAX;
+        /// @brief The index of the orientation within blokus::orientations() for the polyomino
+        unsigned char orientation = 0;
+        /// @brief x-position of the orientation's top-left corner on the board
+        unsigned char x = 0;
+        /// @brief y-position of the orientation's top-left corner on the board
+        unsigned char y = 0;
+
+        /** Create a move that represents a pass
+         * @returns A pass move
+         */
+        static blokus::move pass() {
+            return blokus::move();
+        }
+        /** Check whether the move is a pass
+         * @returns Whether the move is a pass
+         */
+        bool isPass() const {
+            return this->polyomino == USHRT_MAX;
+        }
+        bool operator==(const blokus::move &rhs) const {
+            return this->polyomino == rhs.polyomino && this->orientation == rhs.orientation && this->x == rhs.x && this->y == rhs.y;
+        }
+        bool operator!=(const blokus::move &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    /// @brief Random keys used to incrementally hash a blokus::state; generated from a fixed seed so hashes are stable between runs (and can be stored in files)
+    class zobrist {
+        private:
+            /// @brief Keys for each player occupying each cell of the largest possible board
+            std::vector<std::uint64_t> cells;
+            /// @brief Keys for each player holding each amount of copies of each polyomino
+            std::vector<std::uint64_t> pieces;
+            /// @brief Keys for each player being the one to move
+            std::uint64_t turns[blokus::maxPlayers];
+            /// @brief Keys for each player having passed for the rest of the game
+            std::uint64_t passes[blokus::maxPlayers];
+
+            /** Step a splitmix64 generator
+             * @param seed The generator's state (will be advanced)
+             * @returns The next random value
+             */
+            static std::uint64_t next(std::uint64_t &seed) {
+                std::uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            }
+
+            zobrist() {
+                std::uint64_t seed = 0x426C6F6B7573ULL;
+                this->cells.resize((std::size_t)blokus::maxPlayers * blokus::maxBoardSize * blokus::maxBoardSize);
+                for (std::size_t i = 0; i < this->cells.size(); i++) {
+                    this->cells[i] = blokus::zobrist::next(seed);
+                }
+                this->pieces.resize((std::size_t)blokus::maxPlayers * blokus::polyominoIdCount * (blokus::maxPolyominoCopies + 1));
+                for (std::size_t i = 0; i < this->pieces.size(); i++) {
+                    this->pieces[i] = blokus::zobrist::next(seed);
+                }
+                for (unsigned char i = 0; i < blokus::maxPlayers; i++) {
+                    this->turns[i] = blokus::zobrist::next(seed);
+                    this->passes[i] = blokus::zobrist::next(seed);
+                }
+            }
+
+            static const blokus::zobrist &keys() {
+                static const blokus::zobrist instance;
+                return instance;
+            }
+
+        public:
+            /** Get the key for a player occupying a cell
+             * @param player The player occupying the cell
+             * @param x x-position of the cell
+             * @param y y-position of the cell
+             * @returns The key for the player occupying the cell
+             */
+            static std::uint64_t cell(const unsigned char &player, const unsigned char &x, const unsigned char &y) {
+                return blokus::zobrist::keys().cells[((std::size_t)player * blokus::maxBoardSize + y) * blokus::maxBoardSize + x];
+            }
+            /** Get the key for a player holding an amount of copies of a polyomino
+             * @param player The player holding the polyomino
+             * @param polyomino The global id of the polyomino
+             * @param copies The amount of copies held
+             * @returns The key for the player holding the copies
+             */
+            static std::uint64_t piece(const unsigned char &player, const unsigned short &polyomino, const unsigned char &copies) {
+                return blokus::zobrist::keys().pieces[((std::size_t)player * blokus::polyominoIdCount + polyomino) * (blokus::maxPolyominoCopies + 1) + copies];
+            }
+            /** Get the key for a player being the one to move
+             * @param player The player to move
+             * @returns The key for the player to move
+             */
+            static std::uint64_t turn(const unsigned char &player) {
+                return blokus::zobrist::keys().turns[player];
+            }
+            /** Get the key for a player having passed
+             * @param player The player that passed
+             * @returns The key for the player having passed
+             */
+            static std::uint64_t pass(const unsigned char &player) {
+                return blokus::zobrist::keys().passes[player];
+            }
+    };
+
+    /** Get the start corner of a player; players move clockwise from the top-left corner, with two-player games using opposite corners
+     * @param player The player to get the start corner of
+     * @param playerCount The amount of players in the game
+     * @param size The side length of the board
+     * @returns The start corner as an orientationCell (x, y)
+     */
+    blokus::orientationCell startCorner(const unsigned char &player, const unsigned char &playerCount, const unsigned char &size) {
+        const unsigned char corner = playerCount == 2 ? player * 2 : player;
+        switch (corner % 4) {
+            default:
+            case 0:
+                return {0, 0};
+            case 1:
+                return {(unsigned char)(size - 1), 0};
+            case 2:
+                return {(unsigned char)(size - 1), (unsigned char)(size - 1)};
+            case 3:
+                return {0, (unsigned char)(size - 1)};
+        }
+    }
+
+    /// @brief The full rules-level state of a game of Blokus without any rendering; supports incremental hashing, move generation, and play/undo
+    class state {
+        private:
+            /// @brief A record of what is needed to undo a move
+            struct historyEntry {
+                blokus::move played;
+                unsigned char turn;
+                unsigned char passed;
+            };
+            /// @brief A move list that only counts what is appended to it
+            struct moveCounter {
+                std::size_t count = 0;
+                void push_back(const blokus::move &) {
+                    this->count++;
+                }
+            };
+
+            /// @brief The side length of the board
+            unsigned char size = 20;
+            /// @brief The amount of players in the game
+            unsigned char playerCount = 4;
+            /// @brief The player to move
+            unsigned char turn = 0;
+            /// @brief A bitmask of the players that have passed (a player with no moves can never move again)
+            unsigned char passed = 0;
+            /// @brief The amount of base, hexomino, heptomino, and octomino sets each player started with
+            unsigned char sets[4] = {1, 0, 0, 0};
+
+            /// @brief The cells occupied by each player
+            std::vector<blokus::bitboard> occupied = {};
+            /// @brief The cells occupied by any player
+            blokus::bitboard all;
+            /// @brief The amount of copies of each polyomino that each player has left; player-major (player * blokus::polyominoIdCount + global id) so each player's inventory is one contiguous block
+            std::vector<unsigned char> inventory = {};
+            /// @brief The amount of pieces each player has left
+            std::vector<unsigned short> remainingPieces = {};
+            /// @brief The amount of tiles each player has placed
+            std::vector<unsigned short> placedTiles = {};
+            /// @brief Each player's anchor cells as of the last call to anchors(); only valid for players whose bit is set in anchorsValid
+            mutable std::vector<blokus::bitboard> anchorCache = {};
+            /// @brief A bitmask of the players whose entry in anchorCache is up to date
+            mutable unsigned char anchorsValid = 0;
+            /// @brief Each player's forbidden cells as of the last call to forbidden(); only valid for players whose bit is set in forbiddenValid
+            mutable std::vector<blokus::bitboard> forbiddenCache = {};
+            /// @brief A bitmask of the players whose entry in forbiddenCache is up to date
+            mutable unsigned char forbiddenValid = 0;
+            /// @brief The Zobrist hash of the state
+            std::uint64_t hash = 0;
+            /// @brief A hash of what each player has left, built from player 0's piece keys so it does not change when players are relabelled
+            std::vector<std::uint64_t> inventoryHashes = {};
+            /// @brief The moves that have been played so far (used for undoing)
+            std::vector<historyEntry> history = {};
+
+            /// @brief Advance the turn to the next player that has not passed
+            void advanceTurn() {
+                const unsigned char previous = this->turn;
+                if (this->isOver()) {
+                    return;
+                }
+                do {
+                    this->turn = (this->turn + 1) % this->playerCount;
+                } while ((this->passed >> this->turn) & 1);
+                this->hash ^= blokus::zobrist::turn(previous) ^ blokus::zobrist::turn(this->turn);
+            }
+
+        public:
+            /** blokus::state constructor
+             * @param boardSize The side length of the board; confined to [20, 100]
+             * @param playerCount The amount of players; confined to [2, 4]
+             * @param baseSets The amount of base sets each player gets
+             * @param hexSets The amount of hexomino sets each player gets
+             * @param heptSets The amount of heptomino sets each player gets
+             * @param octSets The amount of octomino sets each player gets
+             */
+            state(const unsigned char &boardSize = 20, const unsigned char &playerCount = 4, const unsigned char &baseSets = 1, const unsigned char &hexSets = 0, const unsigned char &heptSets = 0, const unsigned char &octSets = 0) {
+                this->size = boardSize < 20 ? 20 : (boardSize > blokus::maxBoardSize ? blokus::maxBoardSize : boardSize);
+                this->playerCount = playerCount < 2 ? 2 : (playerCount > blokus::maxPlayers ? blokus::maxPlayers : playerCount);
+                this->all = blokus::bitboard(this->size);
+
+                this->sets[blokus::POLYTYPE_BASE] = blokus::processPolyominoSet(blokus::POLYTYPE_BASE, baseSets);
+                this->sets[blokus::POLYTYPE_HEX] = blokus::processPolyominoSet(blokus::POLYTYPE_HEX, hexSets);
+                this->sets[blokus::POLYTYPE_HEPT] = blokus::processPolyominoSet(blokus::POLYTYPE_HEPT, heptSets);
+                this->sets[blokus::POLYTYPE_OCT] = blokus::processPolyominoSet(blokus::POLYTYPE_OCT, octSets);
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    this->occupied.emplace_back(this->size);
+                    this->remainingPieces.emplace_back(0);
+                    this->placedTiles.emplace_back(0);
+                    this->anchorCache.emplace_back(this->size);
+                    this->forbiddenCache.emplace_back(this->size);
+                    this->inventoryHashes.emplace_back(0);
+                    for (unsigned short j = 0; j < blokus::polyominoIdCount; j++) {
+                        this->inventory.push_back(this->sets[blokus::polyominoSet(j)]);
+                        this->remainingPieces[i] += this->inventory.back();
+                        this->hash ^= blokus::zobrist::piece(i, j, this->inventory.back());
+                        this->inventoryHashes[i] ^= blokus::zobrist::piece(0, j, this->inventory.back());
+                    }
+                }
+                this->hash ^= blokus::zobrist::turn(this->turn);
+            }
+
+            /** Get the side length of the board
+             * @returns The side length of the board
+             */
+            unsigned char getSize() const {
+                return this->size;
+            }
+            /** Get the amount of players in the game
+             * @returns The amount of players in the game
+             */
+            unsigned char getPlayerCount() const {
+                return this->playerCount;
+            }
+            /** Get the player to move
+             * @returns The player to move
+             */
+            unsigned char getTurn() const {
+                return this->turn;
+            }
+            /** Get the amount of copies of a polyomino set each player started with
+             * @param type The polyomino set (POLYTYPE_BASE to POLYTYPE_OCT)
+             * @returns The amount of copies of the set each player started with
+             */
+            unsigned char getSets(const blokus::polyType &type) const {
+                return type <= blokus::POLYTYPE_OCT ? this->sets[type] : 0;
+            }
+            /** Get the Zobrist hash of the state
+             * @returns The Zobrist hash of the state
+             */
+            std::uint64_t getHash() const {
+                return this->hash;
+            }
+            /** Get a hash of the pieces a player has left that does not depend on which player it is (used for symmetry-canonical keys)
+             * @param player The player
+             * @returns The hash of the player's remaining pieces
+             */
+            std::uint64_t getInventoryHash(const unsigned char &player) const {
+                return this->inventoryHashes.at(player);
+            }
+            /** Get the bitmask of players that have passed
+             * @returns A bitmask where bit i is set if player i has passed
+             */
+            unsigned char getPassed() const {
+                return this->passed;
+            }
+            /** Check whether a player has passed
+             * @param player The player to check
+             * @returns Whether the player has passed
+             */
+            bool hasPassed(const unsigned char &player) const {
+                return (this->passed >> player) & 1;
+            }
+            /** Check whether the game is over (every player has passed)
+             * @returns Whether the game is over
+             */
+            bool isOver() const {
+                return this->passed == (1 << this->playerCount) - 1;
+            }
+            /** Get the amount of moves played so far (including passes)
+             * @returns The amount of moves played so far
+             */
+            std::size_t getPly() const {
+                return this->history.size();
+            }
+            /** Get a move that has already been played
+             * @param ply The index of the move (less than getPly())
+             * @returns The move played at that ply
+             */
+            const blokus::move &getMove(const std::size_t &ply) const {
+                return this->history.at(ply).played;
+            }
+            /** Get the cells occupied by a player
+             * @param player The player
+             * @returns The cells occupied by the player
+             */
+            const blokus::bitboard &getOccupied(const unsigned char &player) const {
+                return this->occupied.at(player);
+            }
+            /** Get the cells occupied by any player
+             * @returns The cells occupied by any player
+             */
+            const blokus::bitboard &getOccupied() const {
+                return this->all;
+            }
+            /** Get the amount of copies of a polyomino a player has left
+             * @param player The player
+             * @param polyomino The global id of the polyomino
+             * @returns The amount of copies left
+             */
+            unsigned char getRemaining(const unsigned char &player, const unsigned short &polyomino) const {
+                return this->inventory.at((std::size_t)player * blokus::polyominoIdCount + polyomino);
+            }
+            /** Get a player's whole inventory
+             * @param player The player
+             * @returns blokus::polyominoIdCount counts of the copies left of each polyomino (by global id)
+             */
+            const unsigned char *getInventory(const unsigned char &player) const {
+                return this->inventory.data() + (std::size_t)player * blokus::polyominoIdCount;
+            }
+            /** Get the amount of pieces a player has left
+             * @param player The player
+             * @returns The amount of pieces left
+             */
+            unsigned short getRemainingPieces(const unsigned char &player) const {
+                return this->remainingPieces.at(player);
+            }
+            /** Get the amount of tiles a player has placed
+             * @param player The player
+             * @returns The amount of tiles placed
+             */
+            unsigned short getPlacedTiles(const unsigned char &player) const {
+                return this->placedTiles.at(player);
+            }
+            /** Get the player occupying a cell
+             * @param x x-position of the cell
+             * @param y y-position of the cell
+             * @returns The player occupying the cell, or UCHAR_MAX if empty
+             */
+            unsigned char ownerAt(const unsigned char &x, const unsigned char &y) const {
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    if (this->occupied[i].test(x, y)) {
+                        return i;
+                    }
+                }
+                return UCHAR_MAX;
+            }
+
+            /** Get the cells that a player cannot cover (occupied cells and cells sharing an edge with the player's own tiles)
+             *
+             * The result is cached until the next placement is played or undone, so a state must not be shared between threads
+             * @param player The player
+             * @returns The cells the player cannot cover
+             */
+            const blokus::bitboard &forbidden(const unsigned char &player) const {
+                blokus::bitboard &output = this->forbiddenCache.at(player);
+                if ((this->forbiddenValid >> player) & 1) {
+                    return output;
+                }
+                this->forbiddenValid |= 1 << player;
+
+                output = this->occupied[player];
+                output.expand();
+                output |= this->all;
+                return output;
+            }
+            /** Get the cells that a player's next piece may be anchored on (empty, corner-adjacent to their tiles, and not edge-adjacent to them)
+             * 
+             * The result is cached until the next placement is played or undone, so a state must not be shared between threads
+             * @param player The player
+             * @returns The player's anchor cells
+             */
+            const blokus::bitboard &anchors(const unsigned char &player) const {
+                blokus::bitboard &output = this->anchorCache.at(player);
+                if ((this->anchorsValid >> player) & 1) {
+                    return output;
+                }
+                this->anchorsValid |= 1 << player;
+
+                if (this->placedTiles[player] == 0) {
+                    output.clear();
+                    const blokus::orientationCell corner = blokus::startCorner(player, this->playerCount, this->size);
+                    if (!this->all.test(corner.x, corner.y)) {
+                        output.set(corner.x, corner.y);
+                    }
+                    return output;
+                }
+                // The edge neighbors picked up along with the corner ones are forbidden anyway
+                output = this->occupied[player];
+                output.expand(true);
+                output.remove(this->forbidden(player));
+                return output;
+            }
+
+            /** Check whether a move is legal for a player
+             * @param player The player making the move
+             * @param m The move to check
+             * @returns Whether the move is legal
+             */
+            bool isLegal(const unsigned char &player, const blokus::move &m) const {
+                if (m.isPass()) {
+                    return true;
+                }
+                if (m.polyomino >= blokus::polyominoIdCount || this->getRemaining(player, m.polyomino) == 0 || m.orientation >= blokus::orientations(m.polyomino).size()) {
+                    return false;
+                }
+                const blokus::orientation &o = blokus::orientations(m.polyomino).at(m.orientation);
+                if (m.x + o.width > this->size || m.y + o.height > this->size) {
+                    return false;
+                }
+                const blokus::bitboard &blocked = this->forbidden(player);
+                const blokus::bitboard &anchored = this->anchors(player);
+                bool touchesAnchor = false;
+                for (std::size_t i = 0; i < o.cellCount; i++) {
+                    if (blocked.test(m.x + o.cells[i].x, m.y + o.cells[i].y)) {
+                        return false;
+                    }
+                    touchesAnchor |= anchored.test(m.x + o.cells[i].x, m.y + o.cells[i].y);
+                }
+                return touchesAnchor;
+            }
+
+            /** Generate the legal moves of a player (passes are not included)
+             *
+             * Placements are found by laying each cell of each orientation over each anchor; a placement covering several anchors is only kept for the first of them (row-major) so that no move is listed twice
+             * @param player The player to generate moves for
+             * @param output The list to append the moves to (anything with push_back(), such as std::vector or btils::arenaList)
+             * @param limit Stop once this many moves have been appended
+             * @returns The amount of moves appended
+             */
+            template <typename List> std::size_t legalMoves(const unsigned char &player, List &output, const std::size_t &limit = SIZE_MAX) const {
+                std::size_t found = 0;
+                if (this->hasPassed(player)) {
+                    return found;
+                }
+                const blokus::bitboard &blocked = this->forbidden(player);
+                const blokus::bitboard &anchored = this->anchors(player);
+
+                unsigned short available[blokus::polyominoIdCount];
+                blokus::orientationList lists[blokus::polyominoIdCount];
+                unsigned short availableCount = 0;
+                const unsigned char *held = this->getInventory(player);
+                for (unsigned short i = 0; i < blokus::polyominoIdCount; i++) {
+                    if (held[i] > 0) {
+                        lists[availableCount] = blokus::orientations(i);
+                        available[availableCount++] = i;
+                    }
+                }
+
+                anchored.forEach([&](const int &ax, const int &ay) {
+                    if (found >= limit) {
+                        return;
+                    }
+                    for (unsigned short p = 0; p < availableCount && found < limit; p++) {
+                        for (unsigned char o = 0; o < lists[p].size() && found < limit; o++) {
+                            const blokus::orientation &current = lists[p][o];
+                            for (std::size_t c = 0; c < current.cellCount && found < limit; c++) {
+                                const int x = ax - current.cells[c].x;
+                                const int y = ay - current.cells[c].y;
+                                if (x < 0 || y < 0 || x + current.width > this->size || y + current.height > this->size) {
+                                    continue;
+                                }
+                                // Test a whole row of the orientation at a time; only anchors before this one (row-major) rule a placement out
+                                bool ok = true;
+                                for (unsigned char r = 0; r < current.height && ok; r++) {
+                                    const int cy = y + r;
+                                    std::uint64_t covered = blocked.rowBits(x, cy);
+                                    if (cy < ay) {
+                                        covered |= anchored.rowBits(x, cy);
+                                    } else if (cy == ay) {
+                                        covered |= anchored.rowBits(x, cy) & (((std::uint64_t)1 << (ax - x)) - 1);
+                                    }
+                                    ok = (covered & current.rows[r]) == 0;
+                                }
+                                if (ok) {
+                                    output.push_back({available[p], o, (unsigned char)x, (unsigned char)y});
+                                    found++;
+                                }
+                            }
+                        }
+                    }
+                });
+                return found;
+            }
+            /** Generate the legal moves of the player to move (passes are not included)
+             * @param output The list to append the moves to (anything with push_back(), such as std::vector or btils::arenaList)
+             * @returns The amount of moves appended
+             */
+            template <typename List> std::size_t legalMoves(List &output) const {
+                return this->legalMoves(this->turn, output);
+            }
+            /** Count the legal moves of a player, stopping early at a limit
+             * @param player The player to count moves for
+             * @param limit The most moves to count
+             * @returns The amount of legal moves (at most limit)
+             */
+            std::size_t countLegalMoves(const unsigned char &player, const std::size_t &limit = SIZE_MAX) const {
+                moveCounter moves;
+                return this->legalMoves(player, moves, limit);
+            }
+
+            /** Play a move for the player to move (the move is assumed to be legal)
+             * @param m The move to play; a pass marks the player as out of moves for the rest of the game
+             */
+            void play(const blokus::move &m) {
+                this->history.push_back({m, this->turn, this->passed});
+                if (m.isPass()) {
+                    this->passed |= 1 << this->turn;
+                    this->hash ^= blokus::zobrist::pass(this->turn);
+                    this->advanceTurn();
+                    return;
+                }
+
+                const blokus::orientation &o = blokus::orientations(m.polyomino).at(m.orientation);
+                for (std::size_t i = 0; i < o.cellCount; i++) {
+                    this->occupied[this->turn].set(m.x + o.cells[i].x, m.y + o.cells[i].y);
+                    this->all.set(m.x + o.cells[i].x, m.y + o.cells[i].y);
+                    this->hash ^= blokus::zobrist::cell(this->turn, m.x + o.cells[i].x, m.y + o.cells[i].y);
+                }
+                unsigned char &copies = this->inventory[(std::size_t)this->turn * blokus::polyominoIdCount + m.polyomino];
+                this->hash ^= blokus::zobrist::piece(this->turn, m.polyomino, copies) ^ blokus::zobrist::piece(this->turn, m.polyomino, copies - 1);
+                this->inventoryHashes[this->turn] ^= blokus::zobrist::piece(0, m.polyomino, copies) ^ blokus::zobrist::piece(0, m.polyomino, copies - 1);
+                copies--;
+                this->remainingPieces[this->turn]--;
+                this->placedTiles[this->turn] += o.cellCount;
+                this->anchorsValid = 0;
+                this->forbiddenValid = 0;
+                this->advanceTurn();
+            }
+            /** Undo the last move played
+             * @returns The move that was undone (a pass if there was nothing to undo)
+             */
+            blokus::move undo() {
+                if (this->history.size() == 0) {
+                    return blokus::move::pass();
+                }
+                const historyEntry last = this->history.back();
+                this->history.pop_back();
+
+                this->hash ^= blokus::zobrist::turn(this->turn) ^ blokus::zobrist::turn(last.turn);
+                this->turn = last.turn;
+                for (unsigned char i = 0; i < this->playerCount; i++) {
+                    if (((this->passed ^ last.passed) >> i) & 1) {
+                        this->hash ^= blokus::zobrist::pass(i);
+                    }
+                }
+                this->passed = last.passed;
+                if (last.played.isPass()) {
+                    return last.played;
+                }
+
+                const blokus::orientation &o = blokus::orientations(last.played.polyomino).at(last.played.orientation);
+                for (std::size_t i = 0; i < o.cellCount; i++) {
+                    this->occupied[this->turn].reset(last.played.x + o.cells[i].x, last.played.y + o.cells[i].y);
+                    this->all.reset(last.played.x + o.cells[i].x, last.played.y + o.cells[i].y);
+                    this->hash ^= blokus::zobrist::cell(this->turn, last.played.x + o.cells[i].x, last.played.y + o.cells[i].y);
+                }
+                unsigned char &copies = this->inventory[(std::size_t)this->turn * blokus::polyominoIdCount + last.played.polyomino];
+                this->hash ^= blokus::zobrist::piece(this->turn, last.played.polyomino, copies) ^ blokus::zobrist::piece(this->turn, last.played.polyomino, copies + 1);
+                this->inventoryHashes[this->turn] ^= blokus::zobrist::piece(0, last.played.polyomino, copies) ^ blokus::zobrist::piece(0, last.played.polyomino, copies + 1);
+                copies++;
+                this->remainingPieces[this->turn]++;
+                this->placedTiles[this->turn] -= o.cellCount;
+                this->anchorsValid = 0;
+                this->forbiddenValid = 0;
+                return last.played;
+            }
+    };
+}
+
+#endif // BLOKUS_STATE_hpp
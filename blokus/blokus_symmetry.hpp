@@ -0,0 +1,297 @@
+#ifndef BLOKUS_SYMMETRY_hpp
+#define BLOKUS_SYMMETRY_hpp
+
+#include <vector>
+#include <cstdint>
+#include <climits>
+
+#include "blokus_orientations.hpp"
+#include "blokus_bitboard.hpp"
+#include "blokus_state.hpp"
+
+namespace blokus {
+    /// @brief The 8 symmetries of a square board
+    typedef enum {
+        TRANSFORM_IDENTITY = 0,      // No change
+        TRANSFORM_ROTATE_90 = 1,     // Rotate 90 degrees clockwise
+        TRANSFORM_ROTATE_180 = 2,    // Rotate 180 degrees
+        TRANSFORM_ROTATE_270 = 3,    // Rotate 270 degrees clockwise
+        TRANSFORM_MIRROR_X = 4,      // Mirror left-right
+        TRANSFORM_TRANSPOSE = 5,     // Mirror across the main (top-left to bottom-right) diagonal
+        TRANSFORM_MIRROR_Y = 6,      // Mirror top-bottom
+        TRANSFORM_ANTITRANSPOSE = 7  // Mirror across the anti (top-right to bottom-left) diagonal
+    } boardTransforms;
+
+    /// @brief The amount of symmetries of a square board
+    const unsigned char transformCount = 8;
+    /// @brief The inverse of each transform (applying a transform then its inverse changes nothing)
+    const unsigned char inverseTransforms[8] = {0, 3, 2, 1, 4, 5, 6, 7};
+
+    /** Apply a board symmetry to a cell
+     * @param x x-position of the cell
+     * @param y y-position of the cell
+     * @param transform The symmetry to apply (from blokus::boardTransforms)
+     * @param size The side length of the board
+     * @returns The position of the cell after the symmetry
+     */
+    blokus::orientationCell transformCell(const int &x, const int &y, const unsigned char &transform, const int &size) {
+        const int last = size - 1;
+        switch (transform) {
+            default:
+            case blokus::TRANSFORM_IDENTITY:
+                return {(unsigned char)x, (unsigned char)y};
+            case blokus::TRANSFORM_ROTATE_90:
+                return {(unsigned char)(last - y), (unsigned char)x};
+            case blokus::TRANSFORM_ROTATE_180:
+                return {(unsigned char)(last - x), (unsigned char)(last - y)};
+            case blokus::TRANSFORM_ROTATE_270:
+                return {(unsigned char)y, (unsigned char)(last - x)};
+            case blokus::TRANSFORM_MIRROR_X:
+                return {(unsigned char)(last - x), (unsigned char)y};
+            case blokus::TRANSFORM_TRANSPOSE:
+                return {(unsigned char)y, (unsigned char)x};
+            case blokus::TRANSFORM_MIRROR_Y:
+                return {(unsigned char)x, (unsigned char)(last - y)};
+            case blokus::TRANSFORM_ANTITRANSPOSE:
+                return {(unsigned char)(last - y), (unsigned char)(last - x)};
+        }
+    }
+
+    /** Find how a board symmetry relabels the players of a game
+     *
+     * A symmetry only maps a game onto an equivalent one if it sends every player's start corner onto another player's start corner and keeps the turn order intact (so reflections only work for two players and nothing but the identity works for three)
+     * @param transform The symmetry (from blokus::boardTransforms)
+     * @param playerCount The amount of players in the game
+     * @param permutation Filled with the new label of each player
+     * @returns Whether the symmetry is valid for the amount of players
+     */
+    bool playerPermutation(const unsigned char &transform, const unsigned char &playerCount, unsigned char permutation[blokus::maxPlayers]) {
+        // A 3x3 board is enough to see where each corner ends up
+        for (unsigned char i = 0; i < playerCount; i++) {
+            const blokus::orientationCell corner = blokus::startCorner(i, playerCount, 3);
+            const blokus::orientationCell moved = blokus::transformCell(corner.x, corner.y, transform, 3);
+            permutation[i] = UCHAR_MAX;
+            for (unsigned char j = 0; j < playerCount; j++) {
+                const blokus::orientationCell target = blokus::startCorner(j, playerCount, 3);
+                if (target.x == moved.x && target.y == moved.y) {
+                    permutation[i] = j;
+                }
+            }
+            if (permutation[i] == UCHAR_MAX) {
+                return false;
+            }
+        }
+        for (unsigned char i = 0; i < playerCount; i++) {
+            if (permutation[(i + 1) % playerCount] != (permutation[i] + 1) % playerCount) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Work out which orientation each orientation of a range of polyominoes becomes under each board symmetry
+     * @param start The global id of the first polyomino
+     * @param end One past the global id of the last polyomino
+     * @returns A list (indexed by global polyomino id - start, then orientation, then transform) of orientation indices
+     */
+    std::vector<std::vector<std::vector<unsigned char>>> buildOrientationImages(const unsigned short &start, const unsigned short &end) {
+        std::vector<std::vector<std::vector<unsigned char>>> output(end - start);
+        for (unsigned short p = start; p < end; p++) {
+            const blokus::orientationList orientations = blokus::orientations(p);
+            for (std::size_t o = 0; o < orientations.size(); o++) {
+                output[p - start].emplace_back(blokus::transformCount, 0);
+                for (unsigned char t = 0; t < blokus::transformCount; t++) {
+                    // Draw the transformed orientation onto a grid and let gridToOrientation trim it
+                    const blokus::orientation &current = orientations[o];
+                    const unsigned char span = current.width > current.height ? current.width : current.height;
+                    std::vector<std::vector<bool>> grid(span, std::vector<bool>(span, false));
+                    for (unsigned char c = 0; c < current.cellCount; c++) {
+                        const blokus::orientationCell moved = blokus::transformCell(current.cells[c].x, current.cells[c].y, t, span);
+                        grid[moved.y][moved.x] = true;
+                    }
+                    const blokus::orientation image = blokus::gridToOrientation(grid);
+                    for (std::size_t k = 0; k < orientations.size(); k++) {
+                        if (orientations[k].width != image.width || orientations[k].height != image.height) {
+                            continue;
+                        }
+                        bool same = true;
+                        for (unsigned char c = 0; c < image.cellCount && same; c++) {
+                            same = orientations[k].cells[c].x == image.cells[c].x && orientations[k].cells[c].y == image.cells[c].y;
+                        }
+                        if (same) {
+                            output[p - start][o][t] = k;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        return output;
+    }
+    /** Get which orientation each orientation of a polyomino becomes under each board symmetry; built on first use (the base set separately, so that a base-only game never generates the larger sets)
+     * @param id The global id of the polyomino
+     * @returns A list (indexed by orientation, then transform) of orientation indices
+     */
+    const std::vector<std::vector<unsigned char>> &orientationImages(const unsigned short &id) {
+        static const std::vector<std::vector<unsigned char>> none = {};
+        if (id < blokus::polyominoAmounts[blokus::POLYTYPE_BASE]) {
+            static const std::vector<std::vector<std::vector<unsigned char>>> base = blokus::buildOrientationImages(0, blokus::polyominoAmounts[blokus::POLYTYPE_BASE]);
+            return base[id];
+        }
+        if (id >= blokus::polyominoIdCount) {
+            return none;
+        }
+        static const std::vector<std::vector<std::vector<unsigned char>>> larger = blokus::buildOrientationImages(blokus::polyominoAmounts[blokus::POLYTYPE_BASE], blokus::polyominoIdCount);
+        return larger[id - blokus::polyominoAmounts[blokus::POLYTYPE_BASE]];
+    }
+
+    /** Apply a board symmetry to a move
+     * @param m The move to transform
+     * @param transform The symmetry (from blokus::boardTransforms)
+     * @param size The side length of the board
+     * @returns The move as it would be played on the transformed board
+     */
+    blokus::move transformMove(const blokus::move &m, const unsigned char &transform, const unsigned char &size) {
+        if (m.isPass()) {
+            return m;
+        }
+        const blokus::orientation &o = blokus::orientations(m.polyomino).at(m.orientation);
+        // The new top-left corner is the image of whichever corner of the bounding box lands top-left
+        const blokus::orientationCell a = blokus::transformCell(m.x, m.y, transform, size);
+        const blokus::orientationCell b = blokus::transformCell(m.x + o.width - 1, m.y + o.height - 1, transform, size);
+        return {m.polyomino, blokus::orientationImages(m.polyomino).at(m.orientation).at(transform), a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y};
+    }
+
+    /** Hash a state as it would look after a board symmetry and the matching player relabelling
+     * @param s The state to hash
+     * @param transform The symmetry (must be valid for the state's player count)
+     * @returns The hash of the transformed state (equal to getHash() of that state)
+     */
+    std::uint64_t transformedHash(const blokus::state &s, const unsigned char &transform) {
+        unsigned char permutation[blokus::maxPlayers];
+        blokus::playerPermutation(transform, s.getPlayerCount(), permutation);
+
+        std::uint64_t output = blokus::zobrist::turn(permutation[s.getTurn()]);
+        for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+            s.getOccupied(i).forEach([&](const int &x, const int &y) {
+                const blokus::orientationCell moved = blokus::transformCell(x, y, transform, s.getSize());
+                output ^= blokus::zobrist::cell(permutation[i], moved.x, moved.y);
+            });
+            for (unsigned short j = 0; j < blokus::polyominoIdCount; j++) {
+                output ^= blokus::zobrist::piece(permutation[i], j, s.getRemaining(i, j));
+            }
+            if (s.hasPassed(i)) {
+                output ^= blokus::zobrist::pass(permutation[i]);
+            }
+        }
+        return output;
+    }
+
+    /// @brief A state mapped onto the representative of its symmetry class (see blokus::canonicalize())
+    struct canonicalPosition {
+        /// @brief A key shared by every state that is equivalent under board symmetry and player relabelling
+        std::uint64_t key = 0;
+        /// @brief The symmetry that maps the state onto the representative
+        unsigned char transform = blokus::TRANSFORM_IDENTITY;
+        /// @brief The label each player of the state has within the representative
+        unsigned char permutation[blokus::maxPlayers] = {0, 1, 2, 3};
+        /// @brief The cells occupied by each player of the representative (indexed by the new labels)
+        std::vector<blokus::bitboard> occupied = {};
+    };
+    /// @brief Working space for blokus::canonicalize(); a caller that keeps one around can canonicalize repeatedly without allocating
+    struct canonicalBuffer {
+        /// @brief The image currently being built
+        blokus::canonicalPosition candidate;
+        /// @brief Each player's occupancy transposed, shared by the odd transforms
+        std::vector<blokus::bitboard> transposed = {};
+    };
+
+    /** Fold a value into a running key
+     * @param key The running key
+     * @param value The value to fold in
+     * @returns The new key
+     */
+    std::uint64_t mixKey(std::uint64_t key, const std::uint64_t &value) {
+        key = (key ^ value) * 0x9E3779B97F4A7C15ULL;
+        return key ^ (key >> 29);
+    }
+
+    /** Map a state onto the representative of its symmetry class
+     *
+     * Each valid symmetry is applied to the occupancy bitboards with whole-word operations (see blokus::bitboard::transform()) and the players are relabelled to match.
+     * The image with the smallest key is the representative; its key is built from the transformed words and each player's blokus::state::getInventoryHash(), so it is stable between runs and can be stored in files
+     * @param s The state to map
+     * @param output Set to the representative, its key, and the transform/relabelling that produced it
+     * @param buffer Working space; reusing it (and output) between calls on boards of the same size and player count avoids every allocation
+     */
+    void canonicalize(const blokus::state &s, blokus::canonicalPosition &output, blokus::canonicalBuffer &buffer) {
+        blokus::canonicalPosition &candidate = buffer.candidate;
+        std::vector<blokus::bitboard> &transposed = buffer.transposed;
+        if (candidate.occupied.size() != s.getPlayerCount() || candidate.occupied[0].getSize() != s.getSize()) {
+            candidate.occupied.assign(s.getPlayerCount(), blokus::bitboard(s.getSize()));
+            transposed.assign(s.getPlayerCount(), blokus::bitboard(s.getSize()));
+        }
+        // The even transform left to apply after transposing, for each odd transform
+        const unsigned char afterTranspose[8] = {0, 4, 0, 6, 0, 0, 0, 2};
+        bool isTransposed = false;
+        bool found = false;
+
+        for (unsigned char t = 0; t < blokus::transformCount; t++) {
+            if (!blokus::playerPermutation(t, s.getPlayerCount(), candidate.permutation)) {
+                continue;
+            }
+            if (t % 2 == 1 && !isTransposed) {
+                for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                    transposed[i] = s.getOccupied(i);
+                    transposed[i].transpose();
+                }
+                isTransposed = true;
+            }
+            unsigned char inverse[blokus::maxPlayers];
+            for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                blokus::bitboard &board = candidate.occupied[candidate.permutation[i]];
+                board = t % 2 == 1 ? transposed[i] : s.getOccupied(i);
+                board.transform(t % 2 == 1 ? afterTranspose[t] : t);
+                inverse[candidate.permutation[i]] = i;
+            }
+
+            candidate.key = blokus::mixKey(s.getSize(), candidate.permutation[s.getTurn()]);
+            for (unsigned char i = 0; i < s.getPlayerCount(); i++) {
+                const std::vector<std::uint64_t> &words = candidate.occupied[i].getWords();
+                for (std::size_t w = 0; w < words.size(); w++) {
+                    candidate.key = blokus::mixKey(candidate.key, words[w]);
+                }
+                candidate.key = blokus::mixKey(candidate.key, s.getInventoryHash(inverse[i]) ^ s.hasPassed(inverse[i]));
+            }
+            candidate.transform = t;
+
+            if (!found || candidate.key < output.key) {
+                output = candidate;
+                found = true;
+            }
+        }
+    }
+    /** Map a state onto the representative of its symmetry class (see the overload taking a blokus::canonicalBuffer)
+     * @param s The state to map
+     * @returns The representative, its key, and the transform/relabelling that produced it
+     */
+    blokus::canonicalPosition canonicalize(const blokus::state &s) {
+        blokus::canonicalPosition output;
+        blokus::canonicalBuffer buffer;
+        blokus::canonicalize(s, output, buffer);
+        return output;
+    }
+
+    /** Get a key shared by every state equivalent to this one under board symmetry
+     * @param s The state to get the key of
+     * @param transform Set to the symmetry that maps the state onto its canonical form
+     * @returns The key of the state's representative (see blokus::canonicalize())
+     */
+    std::uint64_t canonicalHash(const blokus::state &s, unsigned char &transform) {
+        const blokus::canonicalPosition position = blokus::canonicalize(s);
+        transform = position.transform;
+        return position.key;
+    }
+}
+
+#endif // BLOKUS_SYMMETRY_hpp
@@ -0,0 +1,305 @@
+#ifndef BLOKUS_THUMBNAILS_hpp
+#define BLOKUS_THUMBNAILS_hpp
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <utility>
+
+#include "bengine.hpp"
+
+#include "blokus_piece.hpp"
+#include "blokus_orientations.hpp"
+
+namespace blokus {
+    /** Pre-rendered previews of players' remaining pieces for the piece preview grid
+     *
+     * Every distinct polyomino, orientation, and color is rendered once into a slot of an atlas (a few large sheets holding a grid of slots each) the first time a page shows it, so duplicate pieces and pieces seen on earlier pages cost nothing to show again.
+     * A page is recorded into the window's command list as its cell frames plus one quad per thumbnail; every thumbnail on a sheet shares its texture, so the thumbnails of a page merge into a single batched draw
+     */
+    class pieceAtlas {
+        private:
+            /// @brief The side length of each sheet (px)
+            int sheetSize = 1024;
+            /// @brief The side length of each slot (px); every thumbnail is rendered at this size
+            int slotSize = 0;
+            /// @brief The sheets of the atlas, each holding a grid of slots
+            std::vector<bengine::moddedTexture> sheets = {};
+            /// @brief The slot of every thumbnail rendered so far, keyed by blokus::pieceAtlas::thumbnailKey()
+            std::unordered_map<std::uint64_t, std::uint32_t> slots = {};
+            /// @brief The amount of slots handed out
+            std::uint32_t slotCount = 0;
+            /// @brief The most sheets kept at once; the atlas starts over once a page would need more
+            std::size_t maxSheets = 8;
+
+            /// @brief The slot of each thumbnail on the page prepared last, in cell order
+            std::vector<std::uint32_t> pageSlots = {};
+            /// @brief The color of the page prepared last
+            SDL_Color pageColor = {0, 0, 0, 0};
+
+            /** Get the amount of slots along each side of a sheet
+             * @returns The amount of slots along each side of a sheet
+             */
+            int slotsAcross() const {
+                return this->sheetSize / this->slotSize > 0 ? this->sheetSize / this->slotSize : 1;
+            }
+            /** Get where a slot is within its sheet
+             * @param slot The slot
+             * @returns The slot's portion of its sheet (px)
+             */
+            SDL_Rect slotRect(const std::uint32_t &slot) const {
+                const int across = this->slotsAcross();
+                const int index = slot % (across * across);
+                return {index % across * this->slotSize, index / across * this->slotSize, this->slotSize, this->slotSize};
+            }
+
+            /** Find which of its polyomino's orientations a piece is in
+             * @param source The piece
+             * @returns The index of the orientation within blokus::orientations() (0 if the grid matches none of them)
+             */
+            static unsigned char orientationOf(const blokus::piece &source) {
+                const std::vector<std::vector<bool>> &grid = source.getGrid();
+                int minX = 8, minY = 8, maxX = -1, maxY = -1;
+                for (std::size_t i = 0; i < grid.size(); i++) {
+                    for (std::size_t j = 0; j < grid[i].size(); j++) {
+                        if (grid[i][j]) {
+                            minX = (int)j < minX ? (int)j : minX;
+                            minY = (int)i < minY ? (int)i : minY;
+                            maxX = (int)j > maxX ? (int)j : maxX;
+                            maxY = (int)i > maxY ? (int)i : maxY;
+                        }
+                    }
+                }
+                if (maxX < minX || maxX - minX >= 8 || maxY - minY >= 8) {
+                    return 0;
+                }
+                unsigned char rows[8] = {};
+                for (int i = minY; i <= maxY; i++) {
+                    for (int j = minX; j <= maxX && j < (int)grid[i].size(); j++) {
+                        rows[i - minY] |= grid[i][j] << (j - minX);
+                    }
+                }
+
+                const blokus::orientationList list = blokus::orientations(source.getId());
+                for (unsigned char k = 0; k < list.size(); k++) {
+                    const blokus::orientation &o = list[k];
+                    if (o.width != maxX - minX + 1 || o.height != maxY - minY + 1) {
+                        continue;
+                    }
+                    bool same = true;
+                    for (unsigned char r = 0; r < o.height && same; r++) {
+                        same = o.rows[r] == rows[r];
+                    }
+                    if (same) {
+                        return k;
+                    }
+                }
+                return 0;
+            }
+            /** Get the key of a thumbnail within the atlas
+             * @param id The id of the polyomino
+             * @param orientation The index of the orientation within blokus::orientations()
+             * @param color The color of the thumbnail
+             * @returns The key of the thumbnail
+             */
+            static std::uint64_t thumbnailKey(const unsigned short &id, const unsigned char &orientation, const SDL_Color &color) {
+                return (std::uint64_t)id << 40 | (std::uint64_t)orientation << 32 | (std::uint64_t)color.r << 24 | (std::uint64_t)color.g << 16 | (std::uint64_t)color.b << 8 | color.a;
+            }
+
+            /** Render one thumbnail into a slot of the sheet being built
+             * @param window The window whose dummy texture is being drawn to
+             * @param o The orientation of the piece to draw
+             * @param slot The slot to draw it in (px)
+             * @param color The color of the piece
+             * @param baseTiles The tileset for the pieces' fill (frames are set while drawing)
+             * @param edgeTiles The tileset for the pieces' edges (frames are set while drawing)
+             */
+            static void renderThumbnail(bengine::window &window, const blokus::orientation &o, const SDL_Rect &slot, const SDL_Color &color, bengine::moddedTexture &baseTiles, bengine::basicTexture &edgeTiles) {
+                const std::size_t rows = o.height;
+                const std::size_t cols = o.width;
+                if (rows == 0 || cols == 0) {
+                    return;
+                }
+
+                // Autotile the piece on its own so its edges are drawn the same way as on the board
+                std::vector<char> masks(rows * cols, -1);
+                std::vector<bengine::tileChange> changes;
+                for (std::size_t i = 0; i < o.cellCount; i++) {
+                    changes.push_back({o.cells[i].x, o.cells[i].y, true});
+                }
+                bengine::autotiler::fourBit(masks.data(), cols, cols, rows, changes.data(), changes.size(), false);
+
+                // Every piece is drawn at the scale of a 5x5 piece (or its own size if bigger) so sizes compare at a glance
+                const int span = (int)(rows > cols ? rows : cols) > 5 ? (int)(rows > cols ? rows : cols) : 5;
+                const int tile = (slot.w < slot.h ? slot.w : slot.h) * 4 / 5 / span;
+                const int x = slot.x + (slot.w - tile * (int)cols) / 2;
+                const int y = slot.y + (slot.h - tile * (int)rows) / 2;
+
+                baseTiles.setColorMod(color);
+                for (std::size_t i = 0; i < rows; i++) {
+                    for (std::size_t j = 0; j < cols; j++) {
+                        const char mask = masks[i * cols + j];
+                        if (mask < 0) {
+                            continue;
+                        }
+                        baseTiles.setFrame({mask % 4 * 64, mask / 4 * 64, 64, 64});
+                        edgeTiles.setFrame({mask % 4 * 64, mask / 4 * 64, 64, 64});
+                        window.renderModdedTexture(baseTiles, {x + (int)j * tile, y + (int)i * tile, tile, tile});
+                        window.renderBasicTexture(edgeTiles, {x + (int)j * tile, y + (int)i * tile, tile, tile});
+                    }
+                }
+            }
+            /** Render new thumbnails into a sheet, keeping whatever the sheet already holds (must happen before anything else is drawn in the frame, as the window's dummy texture is used)
+             * @param window The window to render with
+             * @param sheet The index of the sheet (one past the last sheet starts a new one)
+             * @param fresh The orientation and slot of each new thumbnail on the sheet
+             * @param color The color of the new thumbnails
+             * @param baseTiles The tileset for the pieces' fill
+             * @param edgeTiles The tileset for the pieces' edges
+             */
+            void renderSheet(bengine::window &window, const std::size_t &sheet, const std::vector<std::pair<const blokus::orientation *, std::uint32_t>> &fresh, const SDL_Color &color, bengine::moddedTexture &baseTiles, bengine::basicTexture &edgeTiles) {
+                window.targetDummy();
+                window.initDummy(this->sheetSize, this->sheetSize);
+                window.clear({0, 0, 0, 0});
+                if (sheet < this->sheets.size()) {
+                    // Copy the old sheet over as is, transparent slots included
+                    bengine::moddedTexture old = this->sheets[sheet];
+                    old.setBlendMode(SDL_BLENDMODE_NONE);
+                    window.renderModdedTexture(old, {0, 0, this->sheetSize, this->sheetSize});
+                }
+                for (std::size_t i = 0; i < fresh.size(); i++) {
+                    blokus::pieceAtlas::renderThumbnail(window, *fresh[i].first, this->slotRect(fresh[i].second), color, baseTiles, edgeTiles);
+                }
+                window.present();
+
+                bengine::moddedTexture output(window.copyDummy(), {0, 0, this->sheetSize, this->sheetSize});
+                output.setBlendMode(SDL_BLENDMODE_BLEND);
+                if (sheet < this->sheets.size()) {
+                    this->sheets[sheet] = output;
+                } else {
+                    this->sheets.push_back(output);
+                }
+                window.targetWindow();
+            }
+
+        public:
+            /** Get a page of thumbnails ready to be recorded, rendering any thumbnail the atlas does not have yet (call before anything else is drawn in the frame)
+             * @param window The window to render with (its dummy texture is used while rendering)
+             * @param layout The grid that the page is laid out in; each thumbnail fills a square as large as the grid's cells allow
+             * @param pieces The pieces on the page, in cell order (row-major); at most one per cell
+             * @param color The color of the player the pieces belong to
+             * @param baseTiles The tileset for the pieces' fill
+             * @param edgeTiles The tileset for the pieces' edges
+             * @returns Whether the page looks any different from the one prepared last (a different thumbnail, color, or sheet), in which case it has to be recorded again
+             */
+            bool preparePage(bengine::window &window, const bengine::paddedGrid &layout, const std::vector<const blokus::piece *> &pieces, const SDL_Color &color, bengine::moddedTexture &baseTiles, bengine::basicTexture &edgeTiles) {
+                const int size = (int)(layout.getCellWidth() < layout.getCellHeight() ? layout.getCellWidth() : layout.getCellHeight());
+                if (size != this->slotSize) {
+                    this->clear();
+                    this->slotSize = size > 0 ? size : 1;
+                }
+                const std::size_t count = pieces.size() < (std::size_t)layout.getRows() * layout.getCols() ? pieces.size() : (std::size_t)layout.getRows() * layout.getCols();
+                const std::uint32_t perSheet = this->slotsAcross() * this->slotsAcross();
+
+                // Work out which thumbnails are missing, starting the atlas over if they would not fit
+                std::vector<std::uint64_t> keys(count);
+                std::vector<unsigned char> orientations(count);
+                std::size_t missing = 0;
+                for (std::size_t i = 0; i < count; i++) {
+                    orientations[i] = blokus::pieceAtlas::orientationOf(*pieces[i]);
+                    keys[i] = blokus::pieceAtlas::thumbnailKey(pieces[i]->getId(), orientations[i], color);
+                    missing += this->slots.count(keys[i]) == 0;
+                }
+                if (this->slotCount + missing > perSheet * this->maxSheets) {
+                    this->clear();
+                }
+
+                // Hand out slots to the missing thumbnails, then render each sheet that gained any
+                std::vector<std::uint32_t> page(count);
+                std::vector<std::pair<const blokus::orientation *, std::uint32_t>> fresh;
+                for (std::size_t i = 0; i < count; i++) {
+                    std::unordered_map<std::uint64_t, std::uint32_t>::iterator found = this->slots.find(keys[i]);
+                    if (found == this->slots.end()) {
+                        found = this->slots.emplace(keys[i], this->slotCount++).first;
+                        fresh.push_back({&blokus::orientations(pieces[i]->getId()).at(orientations[i]), found->second});
+                    }
+                    page[i] = found->second;
+                }
+                for (std::size_t start = 0; start < fresh.size();) {
+                    const std::size_t sheet = fresh[start].second / perSheet;
+                    std::size_t end = start;
+                    while (end < fresh.size() && fresh[end].second / perSheet == sheet) {
+                        end++;
+                    }
+                    this->renderSheet(window, sheet, std::vector<std::pair<const blokus::orientation *, std::uint32_t>>(fresh.begin() + start, fresh.begin() + end), color, baseTiles, edgeTiles);
+                    start = end;
+                }
+
+                const bool changed = fresh.size() > 0 || page != this->pageSlots || color.r != this->pageColor.r || color.g != this->pageColor.g || color.b != this->pageColor.b || color.a != this->pageColor.a;
+                this->pageSlots.swap(page);
+                this->pageColor = color;
+                return changed;
+            }
+            /** Record the page prepared last into the window's command list: each cell's frame, then each thumbnail centered in its cell
+             * @param window The window to record with
+             * @param layout The grid that the page is laid out in (the same one given to preparePage())
+             * @param x The x-position of the grid's zone (px)
+             * @param y The y-position of the grid's zone (px)
+             * @param frame The texture drawn behind each thumbnail (tinted with the page's color)
+             */
+            void recordPage(bengine::window &window, const bengine::paddedGrid &layout, const int &x, const int &y, bengine::moddedTexture &frame) const {
+                const int cellW = layout.getCellWidth(), cellH = layout.getCellHeight();
+                frame.setColorMod(this->pageColor);
+                for (std::size_t i = 0; i < this->pageSlots.size(); i++) {
+                    window.recordModdedTexture(frame, {x + (int)layout.getCellX(i % layout.getCols()), y + (int)layout.getCellY(i / layout.getCols()), cellW, cellH});
+                }
+
+                const std::uint32_t perSheet = this->slotsAcross() * this->slotsAcross();
+                for (std::size_t i = 0; i < this->pageSlots.size(); i++) {
+                    bengine::moddedTexture thumbnail = this->sheets.at(this->pageSlots[i] / perSheet);
+                    thumbnail.setFrame(this->slotRect(this->pageSlots[i]));
+                    const int cx = x + (int)layout.getCellX(i % layout.getCols()) + (cellW - this->slotSize) / 2;
+                    const int cy = y + (int)layout.getCellY(i / layout.getCols()) + (cellH - this->slotSize) / 2;
+                    window.recordModdedTexture(thumbnail, {cx, cy, this->slotSize, this->slotSize});
+                }
+            }
+
+            /// @brief Drop every thumbnail (e.g. when the tilesets change)
+            void clear() {
+                this->sheets.clear();
+                this->slots.clear();
+                this->slotCount = 0;
+                this->pageSlots.clear();
+            }
+            /** Get the amount of thumbnails in the atlas
+             * @returns The amount of thumbnails rendered since the atlas last started over
+             */
+            std::size_t getThumbnailCount() const {
+                return this->slotCount;
+            }
+            /** Get the amount of sheets in the atlas
+             * @returns The amount of sheets in the atlas
+             */
+            std::size_t getSheetCount() const {
+                return this->sheets.size();
+            }
+            /** Get the most sheets kept at once
+             * @returns The most sheets kept at once
+             */
+            std::size_t getMaxSheets() const {
+                return this->maxSheets;
+            }
+            /** Set the most sheets kept at once (each sheet is a texture of sheetSize x sheetSize px)
+             * @param maxSheets The new most sheets kept at once
+             * @returns The old most sheets kept at once
+             */
+            std::size_t setMaxSheets(const std::size_t &maxSheets) {
+                const std::size_t output = this->maxSheets;
+                this->maxSheets = maxSheets == 0 ? 1 : maxSheets;
+                return output;
+            }
+    };
+}
+
+#endif // BLOKUS_THUMBNAILS_hpp
@@ -4,7 +4,9 @@
 #include "btils_angle.hpp"
 #include "btils_main.hpp"
 #include "btils_matrix.hpp"
+#include "btils_memory.hpp"
 #include "btils_search.hpp"
 #include "btils_string.hpp"
+#include "btils_threads.hpp"
 
 #endif // BTILS_hpp
@@ -2,6 +2,8 @@
 #define BTILS_MATRIX_hpp
 
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 
 namespace btils {
     /** Checks whether a 2D std::vector is rectangular or not
@@ -26,7 +28,7 @@ namespace btils {
      * @returns The inputted matrix, but rotated 90 degrees
      */
     template <typename Type> std::vector<std::vector<Type>> rotateMatrix(const std::vector<std::vector<Type>> &matrix, const bool &ccw = true, const bool &checkInput = false) {
-        if (checkInput && btils::isRectangular(matrix)) {return matrix;}
+        if (checkInput && !btils::isRectangular(matrix)) {return matrix;}
         std::vector<std::vector<Type>> output;
 
         if (ccw) {
@@ -56,7 +58,7 @@ namespace btils {
      * @returns The inputted matrix, but flipped
      */
     template <typename Type> std::vector<std::vector<Type>> flipMatrix(const std::vector<std::vector<Type>> &matrix, const bool &vertical = true, const bool &checkInput = false) {
-        if (checkInput && btils::isRectangular(matrix)) {return matrix;}
+        if (checkInput && !btils::isRectangular(matrix)) {return matrix;}
         std::vector<std::vector<Type>> output;
 
         if (vertical) {
@@ -77,6 +79,397 @@ namespace btils {
         }
         return output;
     }
+    /** A matrix with a fixed capacity that lives entirely on the stack (or in constant data), for small grids that are transformed often
+     *
+     * The matrix holds up to Rows x Cols cells but uses only the top-left getRows() x getCols() of them, so trimming never changes its type.
+     * Every operation is constexpr, so whole tables of transformed matrices can be built at compile time
+     * @tparam Type Any default-constructible datatype/class; the default value counts as empty when trimming
+     * @tparam Rows The most rows the matrix can hold
+     * @tparam Cols The most columns the matrix can hold
+     */
+    template <typename Type, std::size_t Rows, std::size_t Cols> class fixedMatrix {
+        private:
+            /// @brief The cells of the matrix (row-major); cells outside of the used area are always the default value
+            Type cells[Rows][Cols] = {};
+            /// @brief The amount of rows in use
+            std::size_t rows = Rows;
+            /// @brief The amount of columns in use
+            std::size_t cols = Cols;
+
+        public:
+            /** btils::fixedMatrix constructor
+             * @param rows The amount of rows in use (at most Rows)
+             * @param cols The amount of columns in use (at most Cols)
+             */
+            constexpr fixedMatrix(const std::size_t &rows = Rows, const std::size_t &cols = Cols) : rows(rows < Rows ? rows : Rows), cols(cols < Cols ? cols : Cols) {}
+            /** btils::fixedMatrix constructor
+             * @param matrix A rectangular 2D std::vector to copy (clipped to the matrix's capacity)
+             */
+            fixedMatrix(const std::vector<std::vector<Type>> &matrix) : fixedMatrix(matrix.size(), matrix.size() > 0 ? matrix.at(0).size() : 0) {
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::size_t j = 0; j < this->cols; j++) {
+                        this->cells[i][j] = matrix.at(i).at(j);
+                    }
+                }
+            }
+
+            /** Get the amount of rows in use
+             * @returns The amount of rows in use
+             */
+            constexpr std::size_t getRows() const {
+                return this->rows;
+            }
+            /** Get the amount of columns in use
+             * @returns The amount of columns in use
+             */
+            constexpr std::size_t getCols() const {
+                return this->cols;
+            }
+            /** Get a cell (no bounds checking)
+             * @param row The row of the cell
+             * @param col The column of the cell
+             * @returns The value of the cell
+             */
+            constexpr const Type &get(const std::size_t &row, const std::size_t &col) const {
+                return this->cells[row][col];
+            }
+            /** Set a cell (no bounds checking)
+             * @param row The row of the cell
+             * @param col The column of the cell
+             * @param value The new value of the cell
+             */
+            constexpr void set(const std::size_t &row, const std::size_t &col, const Type &value) {
+                this->cells[row][col] = value;
+            }
+
+            /** Get the matrix with its rows and columns swapped
+             * @returns The transposed matrix
+             */
+            constexpr btils::fixedMatrix<Type, Cols, Rows> transposed() const {
+                btils::fixedMatrix<Type, Cols, Rows> output(this->cols, this->rows);
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::size_t j = 0; j < this->cols; j++) {
+                        output.set(j, i, this->cells[i][j]);
+                    }
+                }
+                return output;
+            }
+            /** Get the matrix flipped (matches btils::flipMatrix())
+             * @param vertical Whether to flip vertically (true) or horizontally (false)
+             * @returns The flipped matrix
+             */
+            constexpr btils::fixedMatrix<Type, Rows, Cols> flipped(const bool &vertical = true) const {
+                btils::fixedMatrix<Type, Rows, Cols> output(this->rows, this->cols);
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::size_t j = 0; j < this->cols; j++) {
+                        output.set(i, j, vertical ? this->cells[this->rows - 1 - i][j] : this->cells[i][this->cols - 1 - j]);
+                    }
+                }
+                return output;
+            }
+            /** Get the matrix rotated 90 degrees (matches btils::rotateMatrix())
+             * @param ccw Whether to rotate counter-clockwise or not
+             * @returns The rotated matrix
+             */
+            constexpr btils::fixedMatrix<Type, Cols, Rows> rotated(const bool &ccw = true) const {
+                return this->transposed().flipped(ccw);
+            }
+            /** Get the matrix with every empty (default-valued) outer row and column removed
+             * @returns The trimmed matrix; the remaining cells are moved to the top-left
+             */
+            constexpr btils::fixedMatrix<Type, Rows, Cols> trimmed() const {
+                std::size_t top = this->rows, bottom = 0, left = this->cols, right = 0;
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::size_t j = 0; j < this->cols; j++) {
+                        if (!(this->cells[i][j] == Type())) {
+                            top = i < top ? i : top;
+                            bottom = i + 1 > bottom ? i + 1 : bottom;
+                            left = j < left ? j : left;
+                            right = j + 1 > right ? j + 1 : right;
+                        }
+                    }
+                }
+                if (top >= bottom) {
+                    return btils::fixedMatrix<Type, Rows, Cols>(0, 0);
+                }
+
+                btils::fixedMatrix<Type, Rows, Cols> output(bottom - top, right - left);
+                for (std::size_t i = top; i < bottom; i++) {
+                    for (std::size_t j = left; j < right; j++) {
+                        output.set(i - top, j - left, this->cells[i][j]);
+                    }
+                }
+                return output;
+            }
+
+            /** Copy the used area into a 2D std::vector
+             * @returns The matrix as a 2D std::vector
+             */
+            std::vector<std::vector<Type>> toVector() const {
+                std::vector<std::vector<Type>> output(this->rows, std::vector<Type>(this->cols));
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::size_t j = 0; j < this->cols; j++) {
+                        output[i][j] = this->cells[i][j];
+                    }
+                }
+                return output;
+            }
+
+            constexpr bool operator==(const btils::fixedMatrix<Type, Rows, Cols> &other) const {
+                if (this->rows != other.rows || this->cols != other.cols) {
+                    return false;
+                }
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::size_t j = 0; j < this->cols; j++) {
+                        if (!(this->cells[i][j] == other.cells[i][j])) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+            constexpr bool operator!=(const btils::fixedMatrix<Type, Rows, Cols> &other) const {
+                return !(*this == other);
+            }
+    };
+
+    /** A matrix of bits with a fixed capacity, packed one 64-bit word per row
+     *
+     * Works like btils::fixedMatrix<bool, Rows, Cols> (which is specialised to use it), but transforms whole rows at a time with bit twiddling.
+     * Bit j of row i is the cell at (i, j)
+     * @tparam Rows The most rows the matrix can hold
+     * @tparam Cols The most columns the matrix can hold (at most 64)
+     */
+    template <std::size_t Rows, std::size_t Cols> class bitMatrix {
+        static_assert(Cols <= 64, "btils::bitMatrix rows are single 64-bit words");
+
+        private:
+            /// @brief The rows of the matrix; bits outside of the used area are always clear
+            std::uint64_t bits[Rows] = {};
+            /// @brief The amount of rows in use
+            std::size_t rows = Rows;
+            /// @brief The amount of columns in use
+            std::size_t cols = Cols;
+
+            /** Reverse the order of the bits in a word
+             * @param value The word to reverse
+             * @returns The reversed word
+             */
+            static constexpr std::uint64_t reverse(std::uint64_t value) {
+                value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+                value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+                value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+                value = ((value >> 8) & 0x00FF00FF00FF00FFULL) | ((value & 0x00FF00FF00FF00FFULL) << 8);
+                value = ((value >> 16) & 0x0000FFFF0000FFFFULL) | ((value & 0x0000FFFF0000FFFFULL) << 16);
+                return (value >> 32) | (value << 32);
+            }
+
+        public:
+            /** btils::bitMatrix constructor
+             * @param rows The amount of rows in use (at most Rows)
+             * @param cols The amount of columns in use (at most Cols)
+             */
+            constexpr bitMatrix(const std::size_t &rows = Rows, const std::size_t &cols = Cols) : rows(rows < Rows ? rows : Rows), cols(cols < Cols ? cols : Cols) {}
+            /** btils::bitMatrix constructor
+             * @param matrix A rectangular 2D std::vector to copy (clipped to the matrix's capacity)
+             */
+            bitMatrix(const std::vector<std::vector<bool>> &matrix) : bitMatrix(matrix.size(), matrix.size() > 0 ? matrix.at(0).size() : 0) {
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::size_t j = 0; j < this->cols; j++) {
+                        this->bits[i] |= (std::uint64_t)matrix.at(i).at(j) << j;
+                    }
+                }
+            }
+
+            /** Get the amount of rows in use
+             * @returns The amount of rows in use
+             */
+            constexpr std::size_t getRows() const {
+                return this->rows;
+            }
+            /** Get the amount of columns in use
+             * @returns The amount of columns in use
+             */
+            constexpr std::size_t getCols() const {
+                return this->cols;
+            }
+            /** Get a cell (no bounds checking)
+             * @param row The row of the cell
+             * @param col The column of the cell
+             * @returns The value of the cell
+             */
+            constexpr bool get(const std::size_t &row, const std::size_t &col) const {
+                return (this->bits[row] >> col) & 1;
+            }
+            /** Set a cell (no bounds checking)
+             * @param row The row of the cell
+             * @param col The column of the cell
+             * @param value The new value of the cell
+             */
+            constexpr void set(const std::size_t &row, const std::size_t &col, const bool &value) {
+                this->bits[row] = (this->bits[row] & ~((std::uint64_t)1 << col)) | ((std::uint64_t)value << col);
+            }
+            /** Get a whole row (no bounds checking)
+             * @param row The row
+             * @returns The row's bits; bit j is column j
+             */
+            constexpr std::uint64_t getRow(const std::size_t &row) const {
+                return this->bits[row];
+            }
+            /** Set a whole row (no bounds checking)
+             * @param row The row
+             * @param value The row's bits; bits past getCols() are dropped
+             */
+            constexpr void setRow(const std::size_t &row, const std::uint64_t &value) {
+                this->bits[row] = this->cols >= 64 ? value : value & (((std::uint64_t)1 << this->cols) - 1);
+            }
+            /** Count the set cells
+             * @returns The amount of set cells
+             */
+            constexpr std::size_t count() const {
+                std::size_t output = 0;
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    output += __builtin_popcountll(this->bits[i]);
+                }
+                return output;
+            }
+
+            /** Get the matrix with its rows and columns swapped; only set bits are visited
+             * @returns The transposed matrix
+             */
+            constexpr btils::bitMatrix<Cols, Rows> transposed() const {
+                btils::bitMatrix<Cols, Rows> output(this->cols, this->rows);
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::uint64_t row = this->bits[i]; row != 0; row &= row - 1) {
+                        const std::size_t j = __builtin_ctzll(row);
+                        output.setRow(j, output.getRow(j) | ((std::uint64_t)1 << i));
+                    }
+                }
+                return output;
+            }
+            /** Get the matrix flipped (matches btils::flipMatrix())
+             * @param vertical Whether to flip vertically (true) or horizontally (false)
+             * @returns The flipped matrix
+             */
+            constexpr btils::bitMatrix<Rows, Cols> flipped(const bool &vertical = true) const {
+                btils::bitMatrix<Rows, Cols> output(this->rows, this->cols);
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    if (vertical) {
+                        output.setRow(i, this->bits[this->rows - 1 - i]);
+                    } else if (this->cols > 0) {
+                        output.setRow(i, bitMatrix::reverse(this->bits[i]) >> (64 - this->cols));
+                    }
+                }
+                return output;
+            }
+            /** Get the matrix rotated 90 degrees (matches btils::rotateMatrix())
+             * @param ccw Whether to rotate counter-clockwise or not
+             * @returns The rotated matrix
+             */
+            constexpr btils::bitMatrix<Cols, Rows> rotated(const bool &ccw = true) const {
+                return this->transposed().flipped(ccw);
+            }
+            /** Get the matrix with every empty outer row and column removed
+             * @returns The trimmed matrix; the remaining cells are moved to the top-left
+             */
+            constexpr btils::bitMatrix<Rows, Cols> trimmed() const {
+                std::size_t top = this->rows, bottom = 0;
+                std::uint64_t columns = 0;
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    if (this->bits[i] != 0) {
+                        top = i < top ? i : top;
+                        bottom = i + 1;
+                        columns |= this->bits[i];
+                    }
+                }
+                if (columns == 0) {
+                    return btils::bitMatrix<Rows, Cols>(0, 0);
+                }
+
+                const std::size_t left = __builtin_ctzll(columns);
+                btils::bitMatrix<Rows, Cols> output(bottom - top, 64 - __builtin_clzll(columns) - left);
+                for (std::size_t i = top; i < bottom; i++) {
+                    output.setRow(i - top, this->bits[i] >> left);
+                }
+                return output;
+            }
+
+            /** Copy the used area into a 2D std::vector
+             * @returns The matrix as a 2D std::vector
+             */
+            std::vector<std::vector<bool>> toVector() const {
+                std::vector<std::vector<bool>> output(this->rows, std::vector<bool>(this->cols));
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    for (std::size_t j = 0; j < this->cols; j++) {
+                        output[i][j] = this->get(i, j);
+                    }
+                }
+                return output;
+            }
+
+            constexpr bool operator==(const btils::bitMatrix<Rows, Cols> &other) const {
+                if (this->rows != other.rows || this->cols != other.cols) {
+                    return false;
+                }
+                for (std::size_t i = 0; i < this->rows; i++) {
+                    if (this->bits[i] != other.bits[i]) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            constexpr bool operator!=(const btils::bitMatrix<Rows, Cols> &other) const {
+                return !(*this == other);
+            }
+    };
+
+    /** btils::fixedMatrix for bool, stored as a packed btils::bitMatrix so that every transform works a row at a time
+     * @tparam Rows The most rows the matrix can hold
+     * @tparam Cols The most columns the matrix can hold (at most 64)
+     */
+    template <std::size_t Rows, std::size_t Cols> class fixedMatrix<bool, Rows, Cols> : public btils::bitMatrix<Rows, Cols> {
+        public:
+            /** btils::fixedMatrix constructor
+             * @param rows The amount of rows in use (at most Rows)
+             * @param cols The amount of columns in use (at most Cols)
+             */
+            constexpr fixedMatrix(const std::size_t &rows = Rows, const std::size_t &cols = Cols) : btils::bitMatrix<Rows, Cols>(rows, cols) {}
+            /** btils::fixedMatrix constructor
+             * @param matrix A rectangular 2D std::vector to copy (clipped to the matrix's capacity)
+             */
+            fixedMatrix(const std::vector<std::vector<bool>> &matrix) : btils::bitMatrix<Rows, Cols>(matrix) {}
+            /** btils::fixedMatrix constructor
+             * @param matrix The packed matrix to copy
+             */
+            constexpr fixedMatrix(const btils::bitMatrix<Rows, Cols> &matrix) : btils::bitMatrix<Rows, Cols>(matrix) {}
+
+            /** Get the matrix with its rows and columns swapped
+             * @returns The transposed matrix
+             */
+            constexpr btils::fixedMatrix<bool, Cols, Rows> transposed() const {
+                return btils::bitMatrix<Rows, Cols>::transposed();
+            }
+            /** Get the matrix flipped (matches btils::flipMatrix())
+             * @param vertical Whether to flip vertically (true) or horizontally (false)
+             * @returns The flipped matrix
+             */
+            constexpr btils::fixedMatrix<bool, Rows, Cols> flipped(const bool &vertical = true) const {
+                return btils::bitMatrix<Rows, Cols>::flipped(vertical);
+            }
+            /** Get the matrix rotated 90 degrees (matches btils::rotateMatrix())
+             * @param ccw Whether to rotate counter-clockwise or not
+             * @returns The rotated matrix
+             */
+            constexpr btils::fixedMatrix<bool, Cols, Rows> rotated(const bool &ccw = true) const {
+                return btils::bitMatrix<Rows, Cols>::rotated(ccw);
+            }
+            /** Get the matrix with every empty outer row and column removed
+             * @returns The trimmed matrix; the remaining cells are moved to the top-left
+             */
+            constexpr btils::fixedMatrix<bool, Rows, Cols> trimmed() const {
+                return btils::bitMatrix<Rows, Cols>::trimmed();
+            }
+    };
 }
 
 #endif // BTILS_MATRIX_hpp
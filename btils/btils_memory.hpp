@@ -0,0 +1,540 @@
+#ifndef BTILS_MEMORY_hpp
+#define BTILS_MEMORY_hpp
+
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
+namespace btils {
+    /// @brief Counters kept by btils::arena and btils::blockPool; a steady-state search should leave systemAllocations and fallbackAllocations unchanged
+    struct allocationStats {
+        /// @brief The amount of blocks requested from the system (new or mmap)
+        std::size_t systemAllocations = 0;
+        /// @brief The amount of bytes currently held from the system
+        std::size_t systemBytes = 0;
+        /// @brief The amount of system blocks that are backed by huge pages
+        std::size_t hugePageBlocks = 0;
+        /// @brief The amount of allocations served
+        std::size_t allocations = 0;
+        /// @brief The amount of allocations that could not be served from pooled memory and went straight to the system
+        std::size_t fallbackAllocations = 0;
+        /// @brief The amount of bytes currently handed out
+        std::size_t bytesInUse = 0;
+        /// @brief The most bytes handed out at once since construction
+        std::size_t peakBytes = 0;
+        /// @brief The amount of times the allocator has been reset
+        std::size_t resets = 0;
+    };
+
+    /// @brief A chunk of memory requested from the system
+    struct systemBlock {
+        /// @brief The start of the chunk
+        char *data = nullptr;
+        /// @brief The size of the chunk in bytes
+        std::size_t size = 0;
+        /// @brief Whether the chunk was mapped (and must be unmapped) rather than allocated with new
+        bool mapped = false;
+    };
+
+    /// @brief The size of a huge page on the platforms that have them
+    const std::size_t hugePageSize = 2 << 20;
+
+    /** Request a chunk of memory from the system
+     * @param bytes The minimum size of the chunk
+     * @param hugePages Whether to try backing the chunk with huge pages (only for chunks of at least btils::hugePageSize; falls back to normal pages)
+     * @param stats The counters to update
+     * @returns The chunk
+     */
+    btils::systemBlock allocateSystemBlock(std::size_t bytes, const bool &hugePages, btils::allocationStats &stats) {
+        btils::systemBlock output;
+        #if !defined(_WIN32)
+        if (hugePages && bytes >= btils::hugePageSize) {
+            bytes = (bytes + btils::hugePageSize - 1) / btils::hugePageSize * btils::hugePageSize;
+            void *mapping = MAP_FAILED;
+            #if defined(MAP_HUGETLB)
+            mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (mapping != MAP_FAILED) {
+                stats.hugePageBlocks++;
+            }
+            #endif
+            // Reserved huge pages are rarely set up, so ask for transparent ones instead
+            if (mapping == MAP_FAILED) {
+                mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                #if defined(MADV_HUGEPAGE)
+                if (mapping != MAP_FAILED && madvise(mapping, bytes, MADV_HUGEPAGE) == 0) {
+                    stats.hugePageBlocks++;
+                }
+                #endif
+            }
+            if (mapping != MAP_FAILED) {
+                output.data = (char *)mapping;
+                output.size = bytes;
+                output.mapped = true;
+            }
+        }
+        #endif
+        if (output.data == nullptr) {
+            output.data = (char *)::operator new(bytes);
+            output.size = bytes;
+        }
+        stats.systemAllocations++;
+        stats.systemBytes += output.size;
+        return output;
+    }
+    /** Give a chunk of memory back to the system
+     * @param block The chunk (from btils::allocateSystemBlock())
+     * @param stats The counters to update
+     */
+    void freeSystemBlock(const btils::systemBlock &block, btils::allocationStats &stats) {
+        #if !defined(_WIN32)
+        if (block.mapped) {
+            munmap(block.data, block.size);
+            stats.systemBytes -= block.size;
+            return;
+        }
+        #endif
+        ::operator delete(block.data);
+        stats.systemBytes -= block.size;
+    }
+
+    /** A bump allocator for short-lived data such as move lists
+     *
+     * Allocating is a pointer bump within the current block; nothing is freed individually. Scoped users take a marker and rewind to it (see btils::arenaScope), and a search resets the whole arena when it starts.
+     * Blocks are kept across rewinds and resets, and a reset merges them into one block large enough for everything the last search used, so a steady-state search never calls the system allocator
+     */
+    class arena {
+        public:
+            /// @brief A position within an arena to rewind to
+            struct marker {
+                std::size_t block = 0;
+                std::size_t offset = 0;
+                std::size_t inUse = 0;
+            };
+
+        private:
+            /// @brief The blocks held from the system, in the order they are used
+            std::vector<btils::systemBlock> blocks = {};
+            /// @brief The index of the block currently being bumped
+            std::size_t current = 0;
+            /// @brief The amount of bytes used within the current block
+            std::size_t offset = 0;
+            /// @brief The size of newly requested blocks
+            std::size_t blockSize = 1 << 20;
+            /// @brief Whether to back blocks with huge pages
+            bool hugePages = false;
+            btils::allocationStats stats;
+
+            /// @brief Give every block back to the system
+            void release() {
+                for (std::size_t i = 0; i < this->blocks.size(); i++) {
+                    btils::freeSystemBlock(this->blocks[i], this->stats);
+                }
+                this->blocks.clear();
+                this->current = 0;
+                this->offset = 0;
+            }
+
+        public:
+            /** btils::arena constructor
+             * @param blockSize The size of each block requested from the system (grown for allocations that would not fit)
+             * @param hugePages Whether to back blocks with huge pages where the platform allows it
+             */
+            arena(const std::size_t &blockSize = 1 << 20, const bool &hugePages = false) : blockSize(blockSize == 0 ? 1 : blockSize), hugePages(hugePages) {}
+            ~arena() {
+                this->release();
+            }
+            arena(const btils::arena &) = delete;
+            btils::arena &operator=(const btils::arena &) = delete;
+
+            /** Allocate uninitialised memory
+             * @param bytes The amount of bytes to allocate
+             * @param alignment The alignment of the memory (a power of two, at most alignof(std::max_align_t))
+             * @returns The start of the memory
+             */
+            void *allocate(const std::size_t &bytes, const std::size_t &alignment = alignof(std::max_align_t)) {
+                std::size_t start = (this->offset + alignment - 1) & ~(alignment - 1);
+                if (this->blocks.size() == 0 || start + bytes > this->blocks[this->current].size) {
+                    // Move on to the first later block that fits, requesting a new one if none do
+                    std::size_t next = this->blocks.size() == 0 ? 0 : this->current + 1;
+                    while (next < this->blocks.size() && this->blocks[next].size < bytes) {
+                        next++;
+                    }
+                    if (next == this->blocks.size()) {
+                        this->blocks.push_back(btils::allocateSystemBlock(bytes > this->blockSize ? bytes : this->blockSize, this->hugePages, this->stats));
+                    }
+                    this->current = next;
+                    start = 0;
+                }
+                this->offset = start + bytes;
+                this->stats.allocations++;
+                this->stats.bytesInUse += bytes;
+                this->stats.peakBytes = this->stats.bytesInUse > this->stats.peakBytes ? this->stats.bytesInUse : this->stats.peakBytes;
+                return this->blocks[this->current].data + start;
+            }
+            /** Allocate uninitialised storage for an array
+             * @param count The amount of elements
+             * @returns The first element
+             */
+            template <typename T> T *make(const std::size_t &count) {
+                static_assert(std::is_trivially_destructible<T>::value, "btils::arena never runs destructors");
+                return (T *)this->allocate(count * sizeof(T), alignof(T));
+            }
+            /** Grow the most recent allocation in place
+             * @param memory The start of the allocation
+             * @param bytes The current size of the allocation
+             * @param newBytes The wanted size of the allocation
+             * @returns Whether the allocation was grown (false if it is not the most recent one or the block is too small)
+             */
+            bool extend(const void *memory, const std::size_t &bytes, const std::size_t &newBytes) {
+                if (this->blocks.size() == 0 || (const char *)memory + bytes != this->blocks[this->current].data + this->offset || (const char *)memory - this->blocks[this->current].data + newBytes > this->blocks[this->current].size) {
+                    return false;
+                }
+                this->offset += newBytes - bytes;
+                this->stats.bytesInUse += newBytes - bytes;
+                this->stats.peakBytes = this->stats.bytesInUse > this->stats.peakBytes ? this->stats.bytesInUse : this->stats.peakBytes;
+                return true;
+            }
+
+            /** Get the current position of the arena
+             * @returns A marker that rewind() can return to
+             */
+            btils::arena::marker mark() const {
+                return {this->current, this->offset, this->stats.bytesInUse};
+            }
+            /** Free everything allocated since a marker was taken
+             * @param position The marker (from mark())
+             */
+            void rewind(const btils::arena::marker &position) {
+                this->current = position.block;
+                this->offset = position.offset;
+                this->stats.bytesInUse = position.inUse;
+            }
+            /// @brief Free everything, merging the blocks into one if more than one was needed
+            void reset() {
+                if (this->blocks.size() > 1) {
+                    std::size_t total = 0;
+                    for (std::size_t i = 0; i < this->blocks.size(); i++) {
+                        total += this->blocks[i].size;
+                    }
+                    this->release();
+                    this->blocks.push_back(btils::allocateSystemBlock(total, this->hugePages, this->stats));
+                }
+                this->current = 0;
+                this->offset = 0;
+                this->stats.bytesInUse = 0;
+                this->stats.resets++;
+            }
+
+            /** Get the arena's counters
+             * @returns The arena's counters
+             */
+            const btils::allocationStats &getStats() const {
+                return this->stats;
+            }
+    };
+
+    /** Get the calling thread's own arena
+     * @returns The calling thread's arena (created on first use)
+     */
+    btils::arena &threadArena() {
+        static thread_local btils::arena instance;
+        return instance;
+    }
+
+    /// @brief Rewinds an arena to where it was when the scope was created
+    class arenaScope {
+        private:
+            btils::arena &source;
+            const btils::arena::marker position;
+
+        public:
+            /** btils::arenaScope constructor
+             * @param source The arena to rewind once the scope ends
+             */
+            arenaScope(btils::arena &source) : source(source), position(source.mark()) {}
+            ~arenaScope() {
+                this->source.rewind(this->position);
+            }
+            arenaScope(const btils::arenaScope &) = delete;
+            btils::arenaScope &operator=(const btils::arenaScope &) = delete;
+    };
+
+    /** A growable list stored in an arena (only for trivially copyable elements)
+     *
+     * While it is the arena's most recent allocation the list grows in place; otherwise growing copies it to the top of the arena and the old storage is reclaimed with the rest of the scope
+     */
+    template <typename T> class arenaList {
+        static_assert(std::is_trivially_copyable<T>::value, "btils::arenaList moves its elements with memcpy");
+
+        private:
+            btils::arena *source = nullptr;
+            T *elements = nullptr;
+            std::size_t count = 0;
+            std::size_t capacity = 0;
+
+        public:
+            /** btils::arenaList constructor
+             * @param source The arena to allocate from (must outlive the list's use)
+             * @param capacity The amount of elements to make room for up front
+             */
+            arenaList(btils::arena &source, const std::size_t &capacity = 0) : source(&source) {
+                this->reserve(capacity);
+            }
+
+            /** Make room for a total amount of elements
+             * @param capacity The amount of elements to make room for
+             */
+            void reserve(const std::size_t &capacity) {
+                if (capacity <= this->capacity) {
+                    return;
+                }
+                if (this->elements == nullptr || !this->source->extend(this->elements, this->capacity * sizeof(T), capacity * sizeof(T))) {
+                    T *moved = this->source->make<T>(capacity);
+                    if (this->count > 0) {
+                        std::memcpy(moved, this->elements, this->count * sizeof(T));
+                    }
+                    this->elements = moved;
+                }
+                this->capacity = capacity;
+            }
+            /** Add an element to the end of the list
+             * @param value The element to add
+             */
+            void push_back(const T &value) {
+                if (this->count == this->capacity) {
+                    this->reserve(this->capacity < 16 ? 16 : this->capacity * 2);
+                }
+                this->elements[this->count++] = value;
+            }
+            /// @brief Remove every element (the memory stays with the list)
+            void clear() {
+                this->count = 0;
+            }
+
+            std::size_t size() const {
+                return this->count;
+            }
+            T *data() {
+                return this->elements;
+            }
+            const T *data() const {
+                return this->elements;
+            }
+            T *begin() {
+                return this->elements;
+            }
+            T *end() {
+                return this->elements + this->count;
+            }
+            const T *begin() const {
+                return this->elements;
+            }
+            const T *end() const {
+                return this->elements + this->count;
+            }
+            T &back() {
+                return this->elements[this->count - 1];
+            }
+            T &operator[](const std::size_t &index) {
+                return this->elements[index];
+            }
+            const T &operator[](const std::size_t &index) const {
+                return this->elements[index];
+            }
+    };
+
+    /** A pool of equally-sized blocks, such as the nodes of a search tree or a hash table
+     *
+     * Freed blocks go onto a free list and are handed out again first; reset() forgets every block at once without giving any memory back, so a new search reuses the chunks of the last one
+     */
+    class blockPool {
+        private:
+            /// @brief The chunks held from the system
+            std::vector<btils::systemBlock> chunks = {};
+            /// @brief The index of the chunk currently being carved up
+            std::size_t current = 0;
+            /// @brief The amount of blocks carved from the current chunk
+            std::size_t carved = 0;
+            /// @brief The most recently freed block, whose first bytes point to the next freed block
+            void *freeList = nullptr;
+            /// @brief The size of each block (rounded up to alignof(std::max_align_t))
+            std::size_t blockSize = 0;
+            /// @brief The amount of blocks in each chunk
+            std::size_t blocksPerChunk = 0;
+            /// @brief Whether to back chunks with huge pages
+            bool hugePages = false;
+            btils::allocationStats stats;
+
+        public:
+            /** btils::blockPool constructor
+             * @param blockSize The size of each block
+             * @param blocksPerChunk The amount of blocks to request from the system at a time
+             * @param hugePages Whether to back chunks with huge pages where the platform allows it
+             */
+            blockPool(const std::size_t &blockSize, const std::size_t &blocksPerChunk = 4096, const bool &hugePages = false) : hugePages(hugePages) {
+                const std::size_t alignment = alignof(std::max_align_t);
+                this->blockSize = ((blockSize < sizeof(void *) ? sizeof(void *) : blockSize) + alignment - 1) & ~(alignment - 1);
+                this->blocksPerChunk = blocksPerChunk == 0 ? 1 : blocksPerChunk;
+            }
+            ~blockPool() {
+                for (std::size_t i = 0; i < this->chunks.size(); i++) {
+                    btils::freeSystemBlock(this->chunks[i], this->stats);
+                }
+            }
+            blockPool(const btils::blockPool &) = delete;
+            btils::blockPool &operator=(const btils::blockPool &) = delete;
+
+            /** Get the size of each block
+             * @returns The size of each block in bytes
+             */
+            std::size_t getBlockSize() const {
+                return this->blockSize;
+            }
+
+            /** Allocate a block
+             * @returns The start of the block (uninitialised)
+             */
+            void *allocate() {
+                void *output = this->freeList;
+                if (output != nullptr) {
+                    std::memcpy(&this->freeList, output, sizeof(void *));
+                } else {
+                    if (this->chunks.size() == 0 || this->carved == this->blocksPerChunk) {
+                        if (this->chunks.size() > 0) {
+                            this->current++;
+                        }
+                        if (this->current == this->chunks.size()) {
+                            this->chunks.push_back(btils::allocateSystemBlock(this->blockSize * this->blocksPerChunk, this->hugePages, this->stats));
+                        }
+                        this->carved = 0;
+                    }
+                    output = this->chunks[this->current].data + this->carved * this->blockSize;
+                    this->carved++;
+                }
+                this->stats.allocations++;
+                this->stats.bytesInUse += this->blockSize;
+                this->stats.peakBytes = this->stats.bytesInUse > this->stats.peakBytes ? this->stats.bytesInUse : this->stats.peakBytes;
+                return output;
+            }
+            /** Free a block
+             * @param block The block (from allocate())
+             */
+            void deallocate(void *block) {
+                std::memcpy(block, &this->freeList, sizeof(void *));
+                this->freeList = block;
+                this->stats.bytesInUse -= this->blockSize;
+            }
+            /** Allocate memory that does not fit in a block straight from the system
+             * @param bytes The amount of bytes to allocate
+             * @returns The start of the memory
+             */
+            void *allocateFallback(const std::size_t &bytes) {
+                this->stats.fallbackAllocations++;
+                return ::operator new(bytes);
+            }
+            /** Free memory from allocateFallback()
+             * @param memory The start of the memory
+             */
+            void deallocateFallback(void *memory) {
+                ::operator delete(memory);
+            }
+            /// @brief Forget every block at once (keeping the chunks for reuse); nothing allocated from the pool may be used afterwards
+            void reset() {
+                this->current = 0;
+                this->carved = 0;
+                this->freeList = nullptr;
+                this->stats.bytesInUse = 0;
+                this->stats.resets++;
+            }
+
+            /** Get the pool's counters
+             * @returns The pool's counters
+             */
+            const btils::allocationStats &getStats() const {
+                return this->stats;
+            }
+    };
+
+    /// @brief A btils::blockPool of objects of one type
+    template <typename T> class pool : public btils::blockPool {
+        public:
+            /** btils::pool constructor
+             * @param objectsPerChunk The amount of objects to request from the system at a time
+             * @param hugePages Whether to back chunks with huge pages where the platform allows it
+             */
+            pool(const std::size_t &objectsPerChunk = 4096, const bool &hugePages = false) : btils::blockPool(sizeof(T), objectsPerChunk, hugePages) {
+                static_assert(alignof(T) <= alignof(std::max_align_t), "btils::pool cannot over-align objects");
+            }
+
+            /** Construct an object in the pool
+             * @param args The arguments for T's constructor
+             * @returns The new object
+             */
+            template <typename... Args> T *create(Args &&...args) {
+                return new (this->allocate()) T(std::forward<Args>(args)...);
+            }
+            /** Destroy an object and give its block back to the pool
+             * @param object The object (from create())
+             */
+            void destroy(T *object) {
+                object->~T();
+                this->deallocate(object);
+            }
+            /// @brief Forget every object at once without running their destructors
+            void reset() {
+                static_assert(std::is_trivially_destructible<T>::value, "btils::pool::reset() skips destructors");
+                btils::blockPool::reset();
+            }
+    };
+
+    /** A standard-library allocator that takes single objects from a btils::blockPool (e.g. the nodes of a std::unordered_map)
+     *
+     * Anything that does not fit in one block, such as a hash table's bucket array, goes to the system and is counted in allocationStats::fallbackAllocations
+     */
+    template <typename T> class poolAllocator {
+        template <typename U> friend class btils::poolAllocator;
+
+        private:
+            btils::blockPool *source = nullptr;
+
+        public:
+            typedef T value_type;
+
+            /** btils::poolAllocator constructor
+             * @param source The pool to allocate from (must outlive every container using the allocator)
+             */
+            poolAllocator(btils::blockPool &source) noexcept : source(&source) {}
+            template <typename U> poolAllocator(const btils::poolAllocator<U> &other) noexcept : source(other.source) {}
+
+            T *allocate(const std::size_t &count) {
+                if (count == 1 && sizeof(T) <= this->source->getBlockSize() && alignof(T) <= alignof(std::max_align_t)) {
+                    return (T *)this->source->allocate();
+                }
+                return (T *)this->source->allocateFallback(count * sizeof(T));
+            }
+            void deallocate(T *memory, const std::size_t &count) {
+                if (count == 1 && sizeof(T) <= this->source->getBlockSize() && alignof(T) <= alignof(std::max_align_t)) {
+                    this->source->deallocate(memory);
+                    return;
+                }
+                this->source->deallocateFallback(memory);
+            }
+
+            template <typename U> bool operator==(const btils::poolAllocator<U> &rhs) const {
+                return this->source == rhs.source;
+            }
+            template <typename U> bool operator!=(const btils::poolAllocator<U> &rhs) const {
+                return this->source != rhs.source;
+            }
+    };
+}
+
+#endif // BTILS_MEMORY_hpp
@@ -0,0 +1,106 @@
+#ifndef BTILS_THREADS_hpp
+#define BTILS_THREADS_hpp
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace btils {
+    /// @brief A fixed set of worker threads that run queued jobs in the order they were submitted
+    class threadPool {
+        private:
+            /// @brief The worker threads
+            std::vector<std::thread> workers = {};
+            /// @brief The jobs waiting for a worker
+            std::deque<std::function<void()>> jobs = {};
+            std::mutex lock;
+            /// @brief Signalled when a job is queued or the pool is stopping
+            std::condition_variable queued;
+            /// @brief Signalled when a job finishes
+            std::condition_variable finished;
+            /// @brief The amount of jobs queued or running
+            std::size_t pending = 0;
+            /// @brief Whether the workers should exit once the queue is empty
+            bool stopping = false;
+
+            /// @brief The loop run by each worker
+            void run() {
+                std::unique_lock<std::mutex> guard(this->lock);
+                while (true) {
+                    this->queued.wait(guard, [this]() {
+                        return this->stopping || this->jobs.size() > 0;
+                    });
+                    if (this->jobs.size() == 0) {
+                        return;
+                    }
+                    std::function<void()> job = std::move(this->jobs.front());
+                    this->jobs.pop_front();
+
+                    guard.unlock();
+                    job();
+                    guard.lock();
+
+                    if (--this->pending == 0) {
+                        this->finished.notify_all();
+                    }
+                }
+            }
+
+        public:
+            /** btils::threadPool constructor
+             * @param threads The amount of worker threads; 0 uses one per hardware thread
+             */
+            threadPool(std::size_t threads = 0) {
+                if (threads == 0) {
+                    threads = std::thread::hardware_concurrency() == 0 ? 1 : std::thread::hardware_concurrency();
+                }
+                for (std::size_t i = 0; i < threads; i++) {
+                    this->workers.emplace_back(&btils::threadPool::run, this);
+                }
+            }
+            /// @brief Finishes every queued job, then stops the workers
+            ~threadPool() {
+                {
+                    std::lock_guard<std::mutex> guard(this->lock);
+                    this->stopping = true;
+                }
+                this->queued.notify_all();
+                for (std::size_t i = 0; i < this->workers.size(); i++) {
+                    this->workers[i].join();
+                }
+            }
+            threadPool(const btils::threadPool &) = delete;
+            btils::threadPool &operator=(const btils::threadPool &) = delete;
+
+            /** Get the amount of worker threads
+             * @returns The amount of worker threads
+             */
+            std::size_t size() const {
+                return this->workers.size();
+            }
+
+            /** Queue a job
+             * @param job The function to run on a worker thread
+             */
+            void submit(std::function<void()> job) {
+                {
+                    std::lock_guard<std::mutex> guard(this->lock);
+                    this->jobs.push_back(std::move(job));
+                    this->pending++;
+                }
+                this->queued.notify_one();
+            }
+            /// @brief Wait until every queued job has finished
+            void wait() {
+                std::unique_lock<std::mutex> guard(this->lock);
+                this->finished.wait(guard, [this]() {
+                    return this->pending == 0;
+                });
+            }
+    };
+}
+
+#endif // BTILS_THREADS_hpp
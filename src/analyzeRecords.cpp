@@ -0,0 +1,298 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <filesystem>
+
+#include "blokus_state.hpp"
+#include "blokus_file.hpp"
+#include "blokus_record.hpp"
+#include "btils_threads.hpp"
+
+/// @brief Statistics gathered over every game played with one board size and player count
+struct aggregate {
+    unsigned char size = 20;
+    unsigned char playerCount = 4;
+    std::uint64_t games = 0;
+    /// @brief How many times each polyomino id was placed
+    std::vector<std::uint64_t> pieceUses = std::vector<std::uint64_t>(blokus::polyominoIdCount, 0);
+    /// @brief The sum over games of the mover's anchor count before each ply
+    std::vector<std::uint64_t> anchorSums = {};
+    /// @brief The amount of games that reached each ply
+    std::vector<std::uint64_t> anchorSamples = {};
+    /// @brief The sum over games of the ply at which each player first passed
+    std::uint64_t blockedSums[4] = {0, 0, 0, 0};
+    /// @brief The amount of games in which each player passed
+    std::uint64_t blockedGames[4] = {0, 0, 0, 0};
+    /// @brief How many games ended with each cell covered by each player (player-major, then row-major)
+    std::vector<std::uint64_t> heat = {};
+
+    aggregate() {}
+    aggregate(const unsigned char &size, const unsigned char &playerCount) : size(size), playerCount(playerCount), heat((std::size_t)playerCount * size * size, 0) {}
+
+    /** Add the statistics of one game
+     * @param record The game
+     * @returns Whether every move in the record was legal (statistics stop at the first illegal move)
+     */
+    bool add(const blokus::gameRecord &record) {
+        blokus::state s(record.getSize(), record.getPlayerCount(), record.getSets(blokus::POLYTYPE_BASE), record.getSets(blokus::POLYTYPE_HEX), record.getSets(blokus::POLYTYPE_HEPT), record.getSets(blokus::POLYTYPE_OCT));
+        const std::vector<blokus::move> &moves = record.getMoves();
+        if (this->anchorSums.size() < moves.size()) {
+            this->anchorSums.resize(moves.size(), 0);
+            this->anchorSamples.resize(moves.size(), 0);
+        }
+
+        bool legal = true;
+        unsigned char blocked = 0;
+        for (std::size_t i = 0; i < moves.size() && !s.isOver(); i++) {
+            const unsigned char mover = s.getTurn();
+            this->anchorSums[i] += s.anchors(mover).count();
+            this->anchorSamples[i]++;
+
+            if (moves[i].isPass()) {
+                if (!((blocked >> mover) & 1)) {
+                    blocked |= 1 << mover;
+                    this->blockedSums[mover] += i;
+                    this->blockedGames[mover]++;
+                }
+            } else if (!s.isLegal(mover, moves[i])) {
+                legal = false;
+                break;
+            } else {
+                this->pieceUses[moves[i].polyomino]++;
+            }
+            s.play(moves[i]);
+        }
+
+        for (unsigned char p = 0; p < this->playerCount; p++) {
+            const blokus::bitboard &cells = s.getOccupied(p);
+            std::uint64_t *plane = this->heat.data() + (std::size_t)p * this->size * this->size;
+            for (unsigned char y = 0; y < this->size; y++) {
+                for (unsigned char x = 0; x < this->size; x++) {
+                    plane[y * this->size + x] += cells.test(x, y);
+                }
+            }
+        }
+        this->games++;
+        return legal;
+    }
+
+    /** Add the statistics of another aggregate with the same board size and player count
+     * @param other The aggregate to add
+     */
+    void merge(const aggregate &other) {
+        this->games += other.games;
+        for (std::size_t i = 0; i < this->pieceUses.size(); i++) {
+            this->pieceUses[i] += other.pieceUses[i];
+        }
+        if (this->anchorSums.size() < other.anchorSums.size()) {
+            this->anchorSums.resize(other.anchorSums.size(), 0);
+            this->anchorSamples.resize(other.anchorSamples.size(), 0);
+        }
+        for (std::size_t i = 0; i < other.anchorSums.size(); i++) {
+            this->anchorSums[i] += other.anchorSums[i];
+            this->anchorSamples[i] += other.anchorSamples[i];
+        }
+        for (unsigned char p = 0; p < 4; p++) {
+            this->blockedSums[p] += other.blockedSums[p];
+            this->blockedGames[p] += other.blockedGames[p];
+        }
+        for (std::size_t i = 0; i < this->heat.size(); i++) {
+            this->heat[i] += other.heat[i];
+        }
+    }
+};
+
+/// @brief Aggregates keyed by (board size, player count)
+typedef std::map<std::pair<unsigned char, unsigned char>, aggregate> aggregateMap;
+
+/** Analyze every record in a file
+ * @param path The path of the file (records stored back to back)
+ * @param output The aggregates to add to
+ * @param illegal The amount of records with illegal moves (added to)
+ * @returns Whether the whole file was read
+ */
+bool analyzeFile(const std::string &path, aggregateMap &output, std::uint64_t &illegal) {
+    blokus::mappedFile file(path);
+    if (!file.isOpen()) {
+        return false;
+    }
+    const std::uint8_t *input = (const std::uint8_t *)file.data();
+    const std::uint8_t *end = input + file.size();
+    blokus::gameRecord record;
+    while (input < end) {
+        if (!record.decode(input, end)) {
+            std::cout << "ERROR: \"" << path << "\" has a corrupt game record at byte " << (file.size() - (end - input)) << "\n";
+            return false;
+        }
+        const std::pair<unsigned char, unsigned char> key(record.getSize(), record.getPlayerCount());
+        std::map<std::pair<unsigned char, unsigned char>, aggregate>::iterator found = output.find(key);
+        if (found == output.end()) {
+            found = output.emplace(key, aggregate(key.first, key.second)).first;
+        }
+        if (!found->second.add(record)) {
+            illegal++;
+        }
+    }
+    return true;
+}
+
+/** Write the statistics as CSV files (<prefix>-pieces.csv, -anchors.csv, -blocked.csv and -heatmap.csv)
+ * @param prefix The start of each file's path
+ * @param results The statistics
+ * @returns Whether every file was written
+ */
+bool writeCSV(const std::string &prefix, const aggregateMap &results) {
+    std::ofstream pieces(prefix + "-pieces.csv"), anchors(prefix + "-anchors.csv"), blocked(prefix + "-blocked.csv"), heatmap(prefix + "-heatmap.csv");
+    if (!pieces.is_open() || !anchors.is_open() || !blocked.is_open() || !heatmap.is_open()) {
+        std::cout << "ERROR: Could not write \"" << prefix << "-*.csv\"\n";
+        return false;
+    }
+    pieces << "size,players,polyomino,uses,usesPerGame\n";
+    anchors << "size,players,ply,games,averageAnchors\n";
+    blocked << "size,players,player,games,averageFirstBlockedPly\n";
+    heatmap << "size,players,player,x,y,frequency\n";
+
+    for (const std::pair<const std::pair<unsigned char, unsigned char>, aggregate> &entry : results) {
+        const aggregate &a = entry.second;
+        const std::string head = std::to_string(a.size) + "," + std::to_string(a.playerCount) + ",";
+        for (std::size_t i = 0; i < a.pieceUses.size(); i++) {
+            if (a.pieceUses[i] > 0) {
+                pieces << head << i << "," << a.pieceUses[i] << "," << (double)a.pieceUses[i] / a.games << "\n";
+            }
+        }
+        for (std::size_t i = 0; i < a.anchorSums.size(); i++) {
+            if (a.anchorSamples[i] > 0) {
+                anchors << head << i << "," << a.anchorSamples[i] << "," << (double)a.anchorSums[i] / a.anchorSamples[i] << "\n";
+            }
+        }
+        for (unsigned char p = 0; p < a.playerCount; p++) {
+            blocked << head << (int)p << "," << a.blockedGames[p] << "," << (a.blockedGames[p] == 0 ? 0.0 : (double)a.blockedSums[p] / a.blockedGames[p]) << "\n";
+        }
+        for (unsigned char p = 0; p < a.playerCount; p++) {
+            for (unsigned char y = 0; y < a.size; y++) {
+                for (unsigned char x = 0; x < a.size; x++) {
+                    heatmap << head << (int)p << "," << (int)x << "," << (int)y << "," << (double)a.heat[((std::size_t)p * a.size + y) * a.size + x] / a.games << "\n";
+                }
+            }
+        }
+    }
+    return pieces.good() && anchors.good() && blocked.good() && heatmap.good();
+}
+
+/** Write the statistics as a single JSON file
+ * @param path The path of the file
+ * @param results The statistics
+ * @returns Whether the file was written
+ */
+bool writeJSON(const std::string &path, const aggregateMap &results) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cout << "ERROR: Could not write \"" << path << "\"\n";
+        return false;
+    }
+
+    file << "[";
+    bool firstEntry = true;
+    for (const std::pair<const std::pair<unsigned char, unsigned char>, aggregate> &entry : results) {
+        const aggregate &a = entry.second;
+        file << (firstEntry ? "\n" : ",\n") << "  {\"size\": " << (int)a.size << ", \"players\": " << (int)a.playerCount << ", \"games\": " << a.games << ",\n";
+        firstEntry = false;
+
+        file << "   \"pieceUsesPerGame\": {";
+        bool first = true;
+        for (std::size_t i = 0; i < a.pieceUses.size(); i++) {
+            if (a.pieceUses[i] > 0) {
+                file << (first ? "" : ", ") << "\"" << i << "\": " << (double)a.pieceUses[i] / a.games;
+                first = false;
+            }
+        }
+        file << "},\n   \"averageAnchors\": [";
+        for (std::size_t i = 0; i < a.anchorSums.size(); i++) {
+            file << (i == 0 ? "" : ", ") << (a.anchorSamples[i] == 0 ? 0.0 : (double)a.anchorSums[i] / a.anchorSamples[i]);
+        }
+        file << "],\n   \"averageFirstBlockedPly\": [";
+        for (unsigned char p = 0; p < a.playerCount; p++) {
+            file << (p == 0 ? "" : ", ") << (a.blockedGames[p] == 0 ? 0.0 : (double)a.blockedSums[p] / a.blockedGames[p]);
+        }
+        file << "],\n   \"heatmaps\": [";
+        for (unsigned char p = 0; p < a.playerCount; p++) {
+            file << (p == 0 ? "\n    [" : ",\n    [");
+            for (std::size_t i = 0; i < (std::size_t)a.size * a.size; i++) {
+                file << (i == 0 ? "" : ",") << (double)a.heat[(std::size_t)p * a.size * a.size + i] / a.games;
+            }
+            file << "]";
+        }
+        file << "\n   ]}";
+    }
+    file << "\n]\n";
+    return file.good();
+}
+
+int main(int argc, char* args[]) {
+    // Usage: analyzeRecords [directory] [output prefix] [threads]
+    const std::string directory = argc > 1 ? args[1] : "dev/records";
+    const std::string prefix = argc > 2 ? args[2] : "dev/records/analysis";
+    const unsigned int threads = argc > 3 ? std::stoul(args[3]) : 0;
+
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file() && it->path().extension() == ".rec") {
+            paths.push_back(it->path().string());
+        }
+    }
+    if (error) {
+        std::cout << "ERROR: Could not read directory \"" << directory << "\"\n";
+        return 1;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    aggregateMap results;
+    std::uint64_t illegal = 0;
+    std::size_t failed = 0;
+    std::mutex lock;
+    {
+        // Each file is analyzed into its own aggregates and merged afterwards so workers only share the lock once per file
+        btils::threadPool pool(threads);
+        for (std::size_t i = 0; i < paths.size(); i++) {
+            pool.submit([&, i]() {
+                aggregateMap local;
+                std::uint64_t localIllegal = 0;
+                const bool read = analyzeFile(paths[i], local, localIllegal);
+
+                std::lock_guard<std::mutex> guard(lock);
+                failed += !read;
+                illegal += localIllegal;
+                for (const std::pair<const std::pair<unsigned char, unsigned char>, aggregate> &entry : local) {
+                    std::map<std::pair<unsigned char, unsigned char>, aggregate>::iterator found = results.find(entry.first);
+                    if (found == results.end()) {
+                        results.emplace(entry.first, entry.second);
+                    } else {
+                        found->second.merge(entry.second);
+                    }
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    std::uint64_t games = 0;
+    for (const std::pair<const std::pair<unsigned char, unsigned char>, aggregate> &entry : results) {
+        games += entry.second.games;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << games << " games from " << paths.size() << " files in " << seconds << "s";
+    if (failed > 0 || illegal > 0) {
+        std::cout << " (" << failed << " unreadable files, " << illegal << " games with illegal moves)";
+    }
+    std::cout << "\n";
+
+    if (!writeCSV(prefix, results) || !writeJSON(prefix + ".json", results)) {
+        return 1;
+    }
+    return 0;
+}
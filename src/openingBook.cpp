@@ -0,0 +1,137 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+
+#include "blokus_state.hpp"
+#include "blokus_symmetry.hpp"
+#include "blokus_book.hpp"
+#include "blokus_computer.hpp"
+
+/// @brief A move seen from one position during self-play
+struct candidate {
+    blokus::move played;
+    unsigned int games;
+    long long margin;
+};
+
+/** Build an opening book for one preset through headless self-play
+ *
+ * The first few plies of each game pick randomly between the best few heuristic moves (so different lines get explored) and the rest is played out by blokus::computer.
+ * Every opening position is recorded under its canonical hash along with the final margin of the player to move; the move with the best average margin becomes the book move
+ * @param path Where to write the book
+ * @param size The side length of the board
+ * @param playerCount The amount of players
+ * @param baseSets The amount of base sets each player gets
+ * @param games The amount of games to play
+ * @param plies The amount of plies from the start to record
+ */
+void buildBook(const std::string &path, const unsigned char &size, const unsigned char &playerCount, const unsigned char &baseSets, const unsigned int &games, const unsigned char &plies) {
+    const std::size_t breadth = 6;
+    std::mt19937 rng(size * 31 + playerCount);
+    blokus::computer computer;
+    std::unordered_map<std::uint64_t, std::vector<candidate>> seen;
+
+    for (unsigned int g = 0; g < games; g++) {
+        blokus::state s(size, playerCount, baseSets);
+        std::vector<std::pair<std::uint64_t, blokus::move>> line;
+        std::vector<unsigned char> movers;
+
+        while (!s.isOver()) {
+            blokus::move m;
+            if (s.getPly() < plies) {
+                std::vector<blokus::move> moves;
+                s.legalMoves(moves);
+                if (moves.size() == 0) {
+                    m = blokus::move::pass();
+                } else {
+                    std::sort(moves.begin(), moves.end(), [&](const blokus::move &a, const blokus::move &b) {
+                        return blokus::computer::heuristic(s, a) > blokus::computer::heuristic(s, b);
+                    });
+                    m = moves[rng() % std::min(breadth, moves.size())];
+
+                    unsigned char transform;
+                    const std::uint64_t key = blokus::canonicalHash(s, transform);
+                    line.push_back({key, blokus::transformMove(m, transform, s.getSize())});
+                    movers.push_back(s.getTurn());
+                }
+            } else {
+                m = computer.chooseMove(s);
+            }
+            s.play(m);
+        }
+
+        for (std::size_t i = 0; i < line.size(); i++) {
+            int best = 0;
+            for (unsigned char j = 0; j < playerCount; j++) {
+                if (j != movers[i] && s.getPlacedTiles(j) > best) {
+                    best = s.getPlacedTiles(j);
+                }
+            }
+            const int margin = s.getPlacedTiles(movers[i]) - best;
+
+            std::vector<candidate> &options = seen[line[i].first];
+            std::size_t j = 0;
+            while (j < options.size() && !(options[j].played == line[i].second)) {
+                j++;
+            }
+            if (j == options.size()) {
+                options.push_back({line[i].second, 0, 0});
+            }
+            options[j].games++;
+            options[j].margin += margin;
+        }
+
+        if ((g + 1) % 16 == 0 || g + 1 == games) {
+            std::cout << path << ": " << g + 1 << "/" << games << " games, " << seen.size() << " positions\n";
+        }
+    }
+
+    // Only keep positions that were reached more than once; a single game says very little
+    std::vector<blokus::bookEntry> entries;
+    for (const std::pair<const std::uint64_t, std::vector<candidate>> &position : seen) {
+        unsigned int total = 0;
+        const candidate *best = nullptr;
+        for (const candidate &option : position.second) {
+            total += option.games;
+            if (best == nullptr || option.margin * (long long)best->games > best->margin * (long long)option.games) {
+                best = &option;
+            }
+        }
+        if (total < 2) {
+            continue;
+        }
+        blokus::bookEntry entry;
+        entry.key = position.first;
+        entry.polyomino = best->played.polyomino;
+        entry.orientation = best->played.orientation;
+        entry.x = best->played.x;
+        entry.y = best->played.y;
+        entry.games = best->games > 255 ? 255 : best->games;
+        entry.score = best->margin / (long long)best->games;
+        entries.push_back(entry);
+    }
+
+    blokus::bookHeader header;
+    header.size = size;
+    header.playerCount = playerCount;
+    header.sets[0] = baseSets;
+    header.plies = plies;
+    if (blokus::openingBook::write(path, header, entries)) {
+        std::cout << path << ": wrote " << entries.size() << " positions\n";
+    }
+}
+
+int main(int argc, char* args[]) {
+    // Usage: openingBook [games] [plies]
+    const unsigned int games = argc > 1 ? std::stoul(args[1]) : 256;
+    const unsigned char plies = argc > 2 ? std::stoul(args[2]) : 8;
+
+    // Classic: 20x20 board with one base set each; Doubled: 28x28 board (roughly twice the area) with two base sets each
+    buildBook("dev/books/classic.book", 20, 4, 1, games, plies);
+    buildBook("dev/books/doubled.book", 28, 4, 2, games, plies);
+
+    return 0;
+}
@@ -12,6 +12,8 @@ class polymaker : public bengine::loop {
         std::vector<std::vector<char>> grid;
         Uint32 gridPos = UINT32_MAX;
         Uint32 oldGridPos = UINT32_MAX;
+        /// @brief The cell of each position in the loop's motion path
+        std::vector<Uint32> pathCells;
 
         bengine::basicTexture piecesOutline = bengine::basicTexture(this->window.loadTexture("dev/png/tilesets/piece_edges_sheet.png"), {0, 0, 256, 256});
         bengine::moddedTexture piecesBase = bengine::moddedTexture(this->window.loadTexture("dev/png/tilesets/piece_bases_sheet.png"), {0, 0, 256, 256}, {255, 0, 0, 255});
@@ -114,12 +116,17 @@ class polymaker : public bengine::loop {
             switch (this->event.type) {
                 case SDL_MOUSEMOTION:
                     this->mstate.updateMotion(this->event);
-                    this->oldGridPos = this->gridPos;
-                    this->gridPos = this->gridButton.checkPos(this->mstate);
-                    if (this->gridPos != this->oldGridPos && this->mstate.pressed(bengine::MOUSE1)) {
-                        if (this->gridPos < this->grid.size() * this->grid.size()) {
-                            tiler.fourBit(this->grid, this->gridPos % this->grid.size(), this->gridPos / this->grid.size(), this->grid[this->gridPos / this->grid.size()][this->gridPos % this->grid.size()] < 0);
-                            this->visualsChanged = true;
+                    // Motion events are merged by the loop, so walk every position that went into this one to paint each cell the drag passed over
+                    this->pathCells.resize(this->motionPath.size());
+                    this->gridButton.checkPositions(this->motionPath.data(), this->motionPath.size(), this->pathCells.data());
+                    for (std::size_t i = 0; i < this->pathCells.size(); i++) {
+                        this->oldGridPos = this->gridPos;
+                        this->gridPos = this->pathCells[i];
+                        if (this->gridPos != this->oldGridPos && this->mstate.pressed(bengine::MOUSE1)) {
+                            if (this->gridPos < this->grid.size() * this->grid.size()) {
+                                tiler.fourBit(this->grid, this->gridPos % this->grid.size(), this->gridPos / this->grid.size(), this->grid[this->gridPos / this->grid.size()][this->gridPos % this->grid.size()] < 0);
+                                this->visualsChanged = true;
+                            }
                         }
                     }
                     break;
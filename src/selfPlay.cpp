@@ -0,0 +1,132 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <fstream>
+#include <cstdlib>
+#include <new>
+
+#include "blokus_state.hpp"
+#include "blokus_computer.hpp"
+#include "blokus_samples.hpp"
+#include "blokus_record.hpp"
+
+// Every call to the global operator new is counted so that the endgame solver can be checked for allocations once it is warmed up; the count is per thread, since the sample writer allocates on its own thread while the solver runs on this one
+static thread_local std::size_t newCalls = 0;
+// Kept out of line so that GCC does not inline them into the standard containers and mistake the malloc/free pairs for mismatched new/delete
+__attribute__((noinline)) void *operator new(std::size_t bytes) {
+    newCalls++;
+    void *output = std::malloc(bytes == 0 ? 1 : bytes);
+    if (output == nullptr) {
+        throw std::bad_alloc();
+    }
+    return output;
+}
+__attribute__((noinline)) void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+__attribute__((noinline)) void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+int main(int argc, char* args[]) {
+    // Usage: selfPlay [games] [prefix] [records]
+    const unsigned int games = argc > 1 ? std::stoul(args[1]) : 1000;
+    const std::string prefix = argc > 2 ? args[2] : "dev/samples/classic";
+    const std::string records = argc > 3 ? args[3] : "dev/records/classic.rec";
+
+    // Classic: 20x20 board, four players with one base set each
+    const unsigned char size = 20;
+    const unsigned char playerCount = 4;
+    // The first few plies pick randomly between the best few heuristic moves so that games differ
+    const std::size_t explorePlies = 12;
+    const std::size_t breadth = 4;
+
+    std::mt19937 rng(20);
+    blokus::computer computer;
+    blokus::sampleWriter writer(prefix, blokus::sampleLayout(size, playerCount, 21));
+    std::size_t samples = 0;
+    // Every game is also kept as a game record (stored back to back) for the analysis tool
+    std::ofstream recordFile(records, std::ios::binary | std::ios::trunc);
+    if (!recordFile.is_open()) {
+        std::cout << "ERROR: Could not write \"" << records << "\"\n";
+    }
+    std::vector<std::uint8_t> recordBytes;
+    // The first position of the latest game that the endgame solver took over
+    blokus::state endgame(size, playerCount, 1);
+    bool haveEndgame = false;
+
+    for (unsigned int g = 0; g < games; g++) {
+        blokus::state s(size, playerCount, 1);
+        std::vector<blokus::move> line;
+        haveEndgame = false;
+        while (!s.isOver()) {
+            blokus::move m;
+            if (s.getPly() < explorePlies) {
+                std::vector<blokus::move> moves;
+                s.legalMoves(moves);
+                std::sort(moves.begin(), moves.end(), [&](const blokus::move &a, const blokus::move &b) {
+                    return blokus::computer::heuristic(s, a) > blokus::computer::heuristic(s, b);
+                });
+                m = moves.size() == 0 ? blokus::move::pass() : moves[rng() % std::min(breadth, moves.size())];
+            } else {
+                if (!haveEndgame && computer.getSolver().applies(s)) {
+                    endgame = s;
+                    haveEndgame = true;
+                }
+                m = computer.chooseMove(s);
+            }
+            line.push_back(m);
+            s.play(m);
+        }
+        if (recordFile.is_open()) {
+            recordBytes.clear();
+            blokus::gameRecord(s, g).encode(recordBytes);
+            recordFile.write((const char *)recordBytes.data(), recordBytes.size());
+        }
+
+        // Replay the game now that the outcome is known and record every non-pass move
+        blokus::state replay(size, playerCount, 1);
+        for (std::size_t i = 0; i < line.size(); i++) {
+            if (!line[i].isPass()) {
+                const unsigned char mover = replay.getTurn();
+                int best = 0;
+                for (unsigned char j = 0; j < playerCount; j++) {
+                    if (j != mover && s.getPlacedTiles(j) > best) {
+                        best = s.getPlacedTiles(j);
+                    }
+                }
+                const int margin = s.getPlacedTiles(mover) - best;
+                writer.add(replay, line[i], margin > 0 ? 1 : (margin < 0 ? -1 : 0), margin);
+                samples++;
+            }
+            replay.play(line[i]);
+        }
+
+        if ((g + 1) % 100 == 0 || g + 1 == games) {
+            std::cout << g + 1 << "/" << games << " games, " << samples << " samples\n";
+            // A warmed-up search should not be asking the system for memory any more
+            const btils::allocationStats &moveStats = computer.getSolver().getMoveStats();
+            const btils::allocationStats &tableStats = computer.getSolver().getTableStats();
+            std::cout << "  endgame move arena: " << moveStats.systemAllocations << " system allocations, " << moveStats.peakBytes << " peak bytes; memo pool: " << tableStats.systemAllocations << " system allocations, " << tableStats.fallbackAllocations << " fallbacks, " << tableStats.peakBytes << " peak bytes\n";
+            // Solve the latest endgame again from an empty memo table (which keeps its buckets); the solver has seen the position, so nothing should be allocated
+            if (haveEndgame) {
+                blokus::endgameSolver &solver = computer.getSolver();
+                solver.clear();
+                solver.solve(endgame);
+                solver.clear();
+                const std::size_t before = newCalls;
+                solver.solve(endgame);
+                const std::size_t allocations = newCalls - before;
+                std::cout << "  warm endgame solve: " << solver.getNodes() << " nodes, " << allocations << " allocations\n";
+                if (allocations > 0) {
+                    std::cout << "ERROR: The endgame solver allocated during a warm solve\n";
+                }
+            }
+        }
+    }
+    writer.close();
+
+    return 0;
+}